@@ -0,0 +1,254 @@
+#ifndef _JSON5PP_CLONE_HPP_
+#define _JSON5PP_CLONE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Options of clone()
+ */
+struct clone_options {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency()); ///< Number of threads (including the caller)
+    std::size_t tasks_per_thread = 8;                                      ///< Tasks made per thread (for load balance)
+    std::pmr::memory_resource* resource = nullptr;                         ///< Arena of pmr storage types of the copy (nullptr for the default allocators)
+};
+
+namespace impl {
+
+/**
+ * @brief Copy a key into the string type of the target value
+ */
+template <class V, class K>
+typename V::string_type clone_key(const K& key, std::pmr::memory_resource* resource)
+{
+    auto name = make_storage<typename V::string_type>(resource);
+    name.assign(key.data(), key.size());
+    return name;
+}
+
+/**
+ * @brief Copy a value into another (possibly of another value type), single-threaded
+ *
+ * @tparam V A typename of target value
+ * @tparam S A typename of source value
+ * @param source A value to copy
+ * @param target A value to store the copy
+ * @param resource A memory resource for containers and strings of the copy (nullptr for the default allocators)
+ */
+template <class V, class S>
+void clone_value(const S& source, V& target, std::pmr::memory_resource* resource)
+{
+    if constexpr (std::is_same_v<V, S>) {
+        if (!resource) {
+            target = source;
+            return;
+        }
+    }
+    if (source.is_null()) {
+        target = nullptr;
+    } else if (source.is_boolean()) {
+        target = source.as_boolean();
+    } else if (source.is_integer()) {
+        const auto n = source.template get<long long>();
+        using I = typename V::integer_type;
+        if ((std::numeric_limits<I>::min() <= n) && (n <= std::numeric_limits<I>::max())) {
+            target = static_cast<I>(n);
+        } else {
+            target = n;
+        }
+    } else if (source.is_number()) {
+        target = static_cast<typename V::number_type>(source.as_number());
+    } else if (source.is_string()) {
+        const auto& s = source.as_string();
+        auto string = make_storage<typename V::string_type>(resource);
+        string.assign(s.data(), s.size());
+        target = std::move(string);
+    } else if (source.is_array()) {
+        const auto& from = source.as_array();
+        target = array<V>(resource);
+        auto& to = target.as_array();
+        to.resize(from.size());
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            clone_value(from[i], to[i], resource);
+        }
+    } else {
+        target = object<V>(resource);
+        auto& to = target.as_object();
+        for (const auto& pair : source.as_object()) {
+            auto iter = to.emplace(clone_key<V>(pair.first, resource), nullptr).first;
+            clone_value(pair.second, iter->second, resource);
+        }
+    }
+}
+
+/**
+ * @brief Parallel clone: splits the top of the tree into tasks for threads
+ *
+ * The top levels are copied as empty containers (arrays of nulls, objects
+ * with null members) by the caller; subtrees and ranges of big arrays below
+ * them are tasks copied by threads into their own slots.
+ */
+template <class V, class S>
+class clone_job
+{
+public:
+    clone_job(const S& source, V& target, const clone_options& options)
+        : threads(std::max(1u, options.threads)),
+          target_tasks(static_cast<std::size_t>(threads) * std::max<std::size_t>(1, options.tasks_per_thread)),
+          resource(options.resource)
+    {
+        tasks.push_back(task{&source, &target, 0, 0});
+    }
+
+    void run()
+    {
+        split();
+        const std::size_t workers = std::min<std::size_t>(threads, tasks.size());
+        std::vector<std::thread> pool;
+        for (std::size_t t = 1; t < workers; ++t) {
+            pool.emplace_back([this] { work(); });
+        }
+        work();
+        for (auto& t : pool) {
+            t.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    /**
+     * @brief A subtree (end == 0) or a range [begin, end) of array elements
+     */
+    struct task {
+        const S* source;
+        V* target;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /**
+     * @brief Expand containers level by level until there are enough tasks
+     */
+    void split()
+    {
+        for (bool expanded = true; expanded && (tasks.size() < target_tasks);) {
+            expanded = false;
+            std::vector<task> next;
+            for (const auto& t : tasks) {
+                if ((t.end != 0) || (next.size() >= target_tasks)) {
+                    next.push_back(t);
+                } else if (t.source->is_array() && !t.source->as_array().empty()) {
+                    const std::size_t n = t.source->as_array().size();
+                    *t.target = array<V>(resource);
+                    t.target->as_array().resize(n);
+                    if (n < target_tasks) {
+                        for (std::size_t i = 0; i < n; ++i) {
+                            next.push_back(task{&t.source->as_array()[i], &t.target->as_array()[i], 0, 0});
+                        }
+                    } else {
+                        const std::size_t step = (n + target_tasks - 1) / target_tasks;
+                        for (std::size_t i = 0; i < n; i += step) {
+                            next.push_back(task{t.source, t.target, i, std::min(n, i + step)});
+                        }
+                    }
+                    expanded = true;
+                } else if (t.source->is_object() && !t.source->as_object().empty()) {
+                    *t.target = object<V>(resource);
+                    auto& to = t.target->as_object();
+                    for (const auto& pair : t.source->as_object()) {
+                        auto iter = to.emplace(clone_key<V>(pair.first, resource), nullptr).first;
+                        next.push_back(task{&pair.second, &iter->second, 0, 0});
+                    }
+                    expanded = true;
+                } else {
+                    next.push_back(t);
+                }
+            }
+            tasks.swap(next);
+        }
+    }
+
+    /**
+     * @brief Take tasks until none is left
+     */
+    void work()
+    {
+        try {
+            for (std::size_t i; (i = next_task.fetch_add(1)) < tasks.size();) {
+                const auto& t = tasks[i];
+                if (t.end == 0) {
+                    clone_value(*t.source, *t.target, resource);
+                } else {
+                    const auto& from = t.source->as_array();
+                    auto& to = t.target->as_array();
+                    for (std::size_t k = t.begin; k < t.end; ++k) {
+                        clone_value(from[k], to[k], resource);
+                    }
+                }
+            }
+        } catch (...) {
+            next_task = tasks.size();
+            std::call_once(error_once, [this] { error = std::current_exception(); });
+        }
+    }
+
+    const unsigned threads;                 ///< Number of threads
+    const std::size_t target_tasks;         ///< Number of tasks to make
+    std::pmr::memory_resource* resource;    ///< Memory resource of the copy
+    std::vector<task> tasks;                ///< Tasks
+    std::atomic<std::size_t> next_task = 0; ///< Next task to take
+    std::once_flag error_once;              ///< Guard of error
+    std::exception_ptr error;               ///< First error
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Deep copy a value with multiple threads
+ *
+ * Big arrays and objects are split into subtrees and ranges which threads
+ * copy in parallel. The result equals the source (for another value type,
+ * as converted by its storage types).
+ *
+ * To copy into an arena, give a value type with pmr containers and strings
+ * (ex: pmr_value) and the arena as options.resource; every container and
+ * string of the copy allocates from it. The arena is used by several
+ * threads at once and must be thread-safe (ex:
+ * std::pmr::synchronized_pool_resource) unless options.threads is 1.
+ *
+ * @tparam V A value type of the copy (default: same as the source)
+ * @tparam Traits Storage types of the source
+ * @param source A value to copy
+ * @param options Options
+ * @return A copy
+ */
+template <class V = void, class Traits>
+auto clone(const basic_value<Traits>& source, const clone_options& options = {})
+{
+    using target_type = std::conditional_t<std::is_void_v<V>, basic_value<Traits>, V>;
+    target_type target;
+    if (options.threads <= 1) {
+        impl::clone_value(source, target, options.resource);
+    } else {
+        impl::clone_job<target_type, basic_value<Traits>>(source, target, options).run();
+    }
+    return target;
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_CLONE_HPP_ */
@@ -0,0 +1,95 @@
+#ifndef _JSON5PP_CODEGEN_SUPPORT_HPP_
+#define _JSON5PP_CODEGEN_SUPPORT_HPP_
+
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Generic read/write helpers used by headers of json5pp-codegen
+ *
+ * Shared by all generated headers, so that several of them (even in one
+ * namespace) can be included in a translation unit. Generated structs are
+ * read/written by their from_json()/to_json(), found by argument-dependent
+ * lookup.
+ */
+namespace codegen_support {
+
+template <class T>
+struct is_optional : std::false_type {};
+template <class T>
+struct is_optional<std::optional<T>> : std::true_type {};
+template <class T>
+struct is_vector : std::false_type {};
+template <class T>
+struct is_vector<std::vector<T>> : std::true_type {};
+
+/**
+ * @brief Read a field from JSON value
+ *
+ * @tparam T A type of field (scalar, std::string, std::optional, std::vector, json5pp::value or generated struct)
+ * @param v JSON value
+ * @param out A field to store
+ */
+template <class T>
+void read(const value& v, T& out)
+{
+    if constexpr (std::is_same_v<T, value>) {
+        out = v;
+    } else if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, std::string>) {
+        out = v.get<T>();
+    } else if constexpr (is_optional<T>::value) {
+        if (v.is_null()) {
+            out.reset();
+        } else {
+            read(v, out.emplace());
+        }
+    } else if constexpr (is_vector<T>::value) {
+        const auto& elements = v.as_array();
+        out.clear();
+        out.reserve(elements.size());
+        for (const auto& e : elements) {
+            read(e, out.emplace_back());
+        }
+    } else {
+        from_json(v, out);
+    }
+}
+
+/**
+ * @brief Write a field as JSON value
+ *
+ * @tparam T A type of field (see read())
+ * @param in A field to write
+ * @return JSON value
+ */
+template <class T>
+value write(const T& in)
+{
+    if constexpr (std::is_same_v<T, value>) {
+        return in;
+    } else if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, std::string>) {
+        return value(in);
+    } else if constexpr (is_optional<T>::value) {
+        return in ? write(*in) : value();
+    } else if constexpr (is_vector<T>::value) {
+        value v = array();
+        v.as_array().reserve(in.size());
+        for (const auto& e : in) {
+            v.append(write(e));
+        }
+        return v;
+    } else {
+        return to_json(in);
+    }
+}
+
+} /* namespace codegen_support */
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_CODEGEN_SUPPORT_HPP_ */
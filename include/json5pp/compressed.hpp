@@ -0,0 +1,476 @@
+#ifndef _JSON5PP_COMPRESSED_HPP_
+#define _JSON5PP_COMPRESSED_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+namespace impl {
+
+/**
+ * @brief LZ77 block compressor (LZ4-style sequences)
+ *
+ * Each sequence is a token (literal length << 4 | match length - 4), extra
+ * literal length bytes, literals, a 2-byte little endian match offset and
+ * extra match length bytes. Lengths of 15 or more continue with bytes of
+ * 255 and a final byte below 255. The last sequence has literals only.
+ */
+struct lz_codec {
+    static constexpr std::size_t min_match = 4;
+    static constexpr std::size_t max_offset = 65535;
+    static constexpr unsigned hash_bits = 12;
+
+    static std::uint32_t load32(const char* p)
+    {
+        std::uint32_t n;
+        std::memcpy(&n, p, sizeof(n));
+        return n;
+    }
+
+    static void put_length(std::string& out, std::size_t n)
+    {
+        for (; n >= 255; n -= 255) {
+            out.push_back(static_cast<char>(255));
+        }
+        out.push_back(static_cast<char>(n));
+    }
+
+    static void put_sequence(std::string& out, const char* literals, std::size_t literal_length, std::size_t offset, std::size_t match_length)
+    {
+        const std::size_t ml = (match_length == 0) ? 0 : match_length - min_match;
+        out.push_back(static_cast<char>(((literal_length < 15 ? literal_length : 15) << 4) | (ml < 15 ? ml : 15)));
+        if (literal_length >= 15) {
+            put_length(out, literal_length - 15);
+        }
+        out.append(literals, literal_length);
+        if (match_length == 0) {
+            return;
+        }
+        out.push_back(static_cast<char>(offset & 0xff));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (ml >= 15) {
+            put_length(out, ml - 15);
+        }
+    }
+
+    static std::string compress(const char* data, std::size_t size)
+    {
+        std::string out;
+        out.reserve(size / 2 + 16);
+        std::vector<std::uint32_t> table(std::size_t(1) << hash_bits, UINT32_MAX);
+        std::size_t anchor = 0;
+        std::size_t i = 0;
+        while (i + min_match <= size) {
+            const std::uint32_t word = load32(data + i);
+            const std::size_t h = (word * 2654435761u) >> (32 - hash_bits);
+            const std::size_t candidate = table[h];
+            table[h] = static_cast<std::uint32_t>(i);
+            if ((candidate == UINT32_MAX) || (i - candidate > max_offset) || (load32(data + candidate) != word)) {
+                ++i;
+                continue;
+            }
+            std::size_t length = min_match;
+            while ((i + length < size) && (data[candidate + length] == data[i + length])) {
+                ++length;
+            }
+            put_sequence(out, data + anchor, i - anchor, i - candidate, length);
+            i += length;
+            anchor = i;
+        }
+        put_sequence(out, data + anchor, size - anchor, 0, 0);
+        return out;
+    }
+
+    static std::size_t get_length(const std::string& in, std::size_t& pos, std::size_t n)
+    {
+        if (n < 15) {
+            return n;
+        }
+        for (;;) {
+            if (pos >= in.size()) {
+                throw std::runtime_error("lz_codec: corrupted block");
+            }
+            const auto b = static_cast<unsigned char>(in[pos++]);
+            n += b;
+            if (b != 255) {
+                return n;
+            }
+        }
+    }
+
+    static std::string decompress(const std::string& in, std::size_t size)
+    {
+        std::string out;
+        out.reserve(size);
+        std::size_t pos = 0;
+        while (pos < in.size()) {
+            const auto token = static_cast<unsigned char>(in[pos++]);
+            const std::size_t literal_length = get_length(in, pos, token >> 4);
+            if ((literal_length > in.size() - pos) || (out.size() + literal_length > size)) {
+                throw std::runtime_error("lz_codec: corrupted block");
+            }
+            out.append(in, pos, literal_length);
+            pos += literal_length;
+            if (pos == in.size()) {
+                break;
+            }
+            if (pos + 2 > in.size()) {
+                throw std::runtime_error("lz_codec: corrupted block");
+            }
+            const std::size_t offset = static_cast<unsigned char>(in[pos]) | (static_cast<std::size_t>(static_cast<unsigned char>(in[pos + 1])) << 8);
+            pos += 2;
+            const std::size_t match_length = get_length(in, pos, token & 15) + min_match;
+            if ((offset == 0) || (offset > out.size()) || (out.size() + match_length > size)) {
+                throw std::runtime_error("lz_codec: corrupted block");
+            }
+            // may overlap itself (repeats)
+            for (std::size_t k = 0, from = out.size() - offset; k < match_length; ++k) {
+                out.push_back(out[from + k]);
+            }
+        }
+        if (out.size() != size) {
+            throw std::runtime_error("lz_codec: corrupted block");
+        }
+        return out;
+    }
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Options for compressed documents
+ */
+struct compression_options {
+    std::size_t min_length = 128;        ///< Strings at least this long are compressed (see compressed_document)
+    std::size_t block_size = 64 * 1024;  ///< Strings are packed into blocks of about this size
+    std::size_t cache_blocks = 4;        ///< Decompressed blocks kept for access
+};
+
+/**
+ * @brief Read-only document whose long string values are stored compressed
+ *
+ * Long string values are packed together (in document order) into blocks
+ * compressed with an LZ77 codec, so that similar strings share matches. A
+ * string is decompressed on access; the last decompressed blocks are kept in
+ * a small LRU cache. Object keys and short strings are stored as is.
+ * Accesses are thread-safe.
+ *
+ * Each compressed string costs an entry of 32 bytes (on 64-bit targets) in
+ * an index sorted by address, besides its bytes in a block; the emptied
+ * string stays in the tree without heap memory. Compressing shorter strings
+ * than the default min_length rarely saves memory.
+ *
+ * The document can be neither copied nor moved, since refs point to it.
+ *
+ * ```cpp
+ * json5pp::compressed_document doc(json5pp::parse(text));
+ * std::string body = doc.root()["items"][0]["body"].as_string();
+ * ```
+ */
+class compressed_document
+{
+public:
+    /**
+     * @brief Compression statistics
+     */
+    struct statistics {
+        std::size_t strings = 0;          ///< Number of compressed strings
+        std::size_t original_bytes = 0;   ///< Total length of compressed strings
+        std::size_t compressed_bytes = 0; ///< Total size of compressed blocks
+        std::size_t blocks = 0;           ///< Number of blocks
+        std::size_t cache_hits = 0;       ///< Accesses served by decompressed blocks
+        std::size_t cache_misses = 0;     ///< Accesses which decompressed a block
+    };
+
+    /**
+     * @brief Proxy to a value in a compressed document
+     *
+     * Valid while the document lives.
+     */
+    class ref
+    {
+    public:
+        bool is_null() const noexcept { return v->is_null(); }
+        bool is_boolean() const noexcept { return v->is_boolean(); }
+        bool is_number() const noexcept { return v->is_number(); }
+        bool is_integer() const noexcept { return v->is_integer(); }
+        bool is_string() const noexcept { return v->is_string(); }
+        bool is_array() const noexcept { return v->is_array(); }
+        bool is_object() const noexcept { return v->is_object(); }
+
+        /// Number of elements or members
+        std::size_t size() const { return v->size(); }
+
+        /// Element (null if out of range)
+        ref operator[](int index) const { return ref(doc, &(*v)[index]); }
+
+        /// Member (null if not found)
+        ref operator[](const std::string& key) const { return ref(doc, &(*v)[key]); }
+
+        /// Member (null if not found)
+        ref operator[](const char* key) const { return ref(doc, &(*v)[key]); }
+
+        /// Keys of an object
+        std::vector<std::string> keys() const
+        {
+            std::vector<std::string> result;
+            for (const auto& pair : v->as_object()) {
+                result.push_back(pair.first);
+            }
+            return result;
+        }
+
+        bool as_boolean() const { return v->as_boolean(); }
+        double as_number() const { return v->as_number(); }
+        int as_integer() const { return v->as_integer(); }
+
+        /**
+         * @brief Get string (decompressed if needed)
+         *
+         * @throws std::bad_cast if the value is not a string
+         */
+        std::string as_string() const
+        {
+            return doc->string_of(v);
+        }
+
+        /**
+         * @brief Get value by explicit type (as value::get<T>())
+         */
+        template <typename T, bool auto_conversion = false>
+        T get() const
+        {
+            if (v->is_string() && doc->is_compressed(v)) {
+                return value(as_string()).get<T, auto_conversion>();
+            }
+            return v->get<T, auto_conversion>();
+        }
+
+        /**
+         * @brief Copy to a value (all strings decompressed)
+         */
+        value to_value() const
+        {
+            return doc->restore(*v);
+        }
+
+    private:
+        friend class compressed_document;
+        ref(const compressed_document* doc, const value* v) : doc(doc), v(v) {}
+
+        const compressed_document* doc; ///< Owner
+        const value* v;                 ///< Value in the stored tree
+    };
+
+    /**
+     * @brief Compress strings of a document
+     *
+     * @param v A document
+     * @param options Options
+     */
+    explicit compressed_document(value v, const compression_options& options = {})
+        : tree(std::move(v)), cache_blocks(options.cache_blocks)
+    {
+        std::string pending;
+        store(tree, pending, options);
+        flush(pending);
+        std::sort(locations.begin(), locations.end(), [](const location& a, const location& b) { return std::less<const value*>()(a.v, b.v); });
+        locations.shrink_to_fit();
+    }
+
+    compressed_document(const compressed_document&) = delete;
+    compressed_document& operator=(const compressed_document&) = delete;
+    compressed_document(compressed_document&&) = delete;
+    compressed_document& operator=(compressed_document&&) = delete;
+
+    /// Root of the document
+    ref root() const { return ref(this, &tree); }
+
+    /// Shortcut of root()[key]
+    ref operator[](const std::string& key) const { return root()[key]; }
+
+    /// Shortcut of root()[index]
+    ref operator[](int index) const { return root()[index]; }
+
+    /// Decompress the whole document
+    value to_value() const { return restore(tree); }
+
+    /**
+     * @brief Get compression statistics
+     */
+    statistics get_statistics() const
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        statistics s = stats;
+        s.cache_hits = cache.hits;
+        s.cache_misses = cache.misses;
+        return s;
+    }
+
+private:
+    struct location {
+        const value* v;     ///< Stored value (emptied string)
+        std::size_t block;  ///< Block number
+        std::size_t offset; ///< Offset in decompressed block
+        std::size_t length; ///< Length of string
+    };
+
+    struct block {
+        std::string data; ///< Compressed bytes
+        std::size_t size; ///< Decompressed size
+    };
+
+    struct block_cache {
+        std::mutex mutex;
+        std::list<std::pair<std::size_t, std::shared_ptr<const std::string>>> blocks; ///< Most recently used first
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+    };
+
+    /**
+     * @brief Move long strings of a tree into blocks
+     */
+    void store(value& v, std::string& pending, const compression_options& options)
+    {
+        if (v.is_string()) {
+            auto& s = v.as_string();
+            if (s.size() >= options.min_length) {
+                locations.push_back(location{&v, blocks.size(), pending.size(), s.size()});
+                pending += s;
+                ++stats.strings;
+                stats.original_bytes += s.size();
+                std::string().swap(s);
+                if (pending.size() >= options.block_size) {
+                    flush(pending);
+                }
+            }
+        } else if (v.is_array()) {
+            for (auto& e : v.as_array()) {
+                store(e, pending, options);
+            }
+        } else if (v.is_object()) {
+            for (auto& pair : v.as_object()) {
+                store(pair.second, pending, options);
+            }
+        }
+    }
+
+    /**
+     * @brief Compress pending strings into a block
+     */
+    void flush(std::string& pending)
+    {
+        if (pending.empty()) {
+            return;
+        }
+        blocks.push_back(block{impl::lz_codec::compress(pending.data(), pending.size()), pending.size()});
+        blocks.back().data.shrink_to_fit();
+        stats.compressed_bytes += blocks.back().data.size();
+        ++stats.blocks;
+        pending.clear();
+    }
+
+    /**
+     * @brief Find location of a compressed string (nullptr if not compressed)
+     */
+    const location* find_location(const value* v) const
+    {
+        auto iter = std::lower_bound(locations.begin(), locations.end(), v, [](const location& loc, const value* p) { return std::less<const value*>()(loc.v, p); });
+        return ((iter != locations.end()) && (iter->v == v)) ? &*iter : nullptr;
+    }
+
+    bool is_compressed(const value* v) const
+    {
+        return find_location(v) != nullptr;
+    }
+
+    /**
+     * @brief Get a decompressed block (from cache)
+     */
+    std::shared_ptr<const std::string> get_block(std::size_t n) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            for (auto i = cache.blocks.begin(); i != cache.blocks.end(); ++i) {
+                if (i->first == n) {
+                    cache.blocks.splice(cache.blocks.begin(), cache.blocks, i);
+                    ++cache.hits;
+                    return i->second;
+                }
+            }
+            ++cache.misses;
+        }
+        // Decompress without holding the lock
+        auto data = std::make_shared<const std::string>(impl::lz_codec::decompress(blocks[n].data, blocks[n].size));
+        if (cache_blocks > 0) {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            cache.blocks.emplace_front(n, data);
+            if (cache.blocks.size() > cache_blocks) {
+                cache.blocks.pop_back();
+            }
+        }
+        return data;
+    }
+
+    /**
+     * @brief Get string of a stored value
+     */
+    std::string string_of(const value* v) const
+    {
+        const location* loc = find_location(v);
+        if (!loc) {
+            return v->as_string();
+        }
+        return get_block(loc->block)->substr(loc->offset, loc->length);
+    }
+
+    /**
+     * @brief Copy a stored tree with strings decompressed
+     */
+    value restore(const value& v) const
+    {
+        if (v.is_string()) {
+            return string_of(&v);
+        } else if (v.is_array()) {
+            value result = array();
+            auto& elements = result.as_array();
+            elements.reserve(v.size());
+            for (const auto& e : v.as_array()) {
+                elements.push_back(restore(e));
+            }
+            return result;
+        } else if (v.is_object()) {
+            value result = object();
+            auto& members = result.as_object();
+            for (const auto& pair : v.as_object()) {
+                members.emplace(pair.first, restore(pair.second));
+            }
+            return result;
+        }
+        return v;
+    }
+
+    value tree;                       ///< Tree with compressed strings emptied
+    std::vector<location> locations;  ///< Compressed strings (sorted by address)
+    std::vector<block> blocks;        ///< Compressed blocks
+    mutable block_cache cache;        ///< Decompressed blocks
+    std::size_t cache_blocks;         ///< Maximum number of cached blocks
+    statistics stats;                 ///< Compression statistics
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_COMPRESSED_HPP_ */
@@ -0,0 +1,290 @@
+#ifndef _JSON5PP_DIFF_HPP_
+#define _JSON5PP_DIFF_HPP_
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <istream>
+#include <string>
+
+#include "journal.hpp"
+#include "json5pp.hpp"
+#include "pointer.hpp"
+#include "pull_parser.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Options for diff of streams
+ */
+struct diff_options {
+    bool json5 = false;   ///< Parse inputs as JSON5
+    bool records = false; ///< Inputs are sequences of documents (ex: NDJSON), compared like arrays
+};
+
+namespace impl {
+
+/**
+ * @brief Compare two trees and report changes from a to b
+ *
+ * @param a Old value
+ * @param b New value
+ * @param path Path of the values (restored on return)
+ * @param sink A function called as sink(op, path, new_value)
+ */
+template <class S>
+void diff_values(const value& a, const value& b, pointer& path, S& sink)
+{
+    if (a.is_array() && b.is_array()) {
+        const auto& x = a.as_array();
+        const auto& y = b.as_array();
+        const std::size_t common = std::min(x.size(), y.size());
+        for (std::size_t i = 0; i < common; ++i) {
+            path.append(i);
+            diff_values(x[i], y[i], path, sink);
+            path.pop();
+        }
+        for (std::size_t i = common; i < y.size(); ++i) {
+            path.append(i);
+            sink(change_op::add, path, y[i]);
+            path.pop();
+        }
+        // remove from the last, so that indexes stay valid when applied in order
+        for (std::size_t i = x.size(); i > common; --i) {
+            path.append(i - 1);
+            sink(change_op::remove, path, value());
+            path.pop();
+        }
+    } else if (a.is_object() && b.is_object()) {
+        const auto& x = a.as_object();
+        const auto& y = b.as_object();
+        for (const auto& pair : x) {
+            path.append(pair.first);
+            auto iter = y.find(pair.first);
+            if (iter == y.end()) {
+                sink(change_op::remove, path, value());
+            } else {
+                diff_values(pair.second, iter->second, path, sink);
+            }
+            path.pop();
+        }
+        for (const auto& pair : y) {
+            if (x.find(pair.first) == x.end()) {
+                path.append(pair.first);
+                sink(change_op::add, path, pair.second);
+                path.pop();
+            }
+        }
+    } else if (!(a == b)) {
+        sink(change_op::replace, path, b);
+    }
+}
+
+/**
+ * @brief Lockstep differ of two pull parsers
+ *
+ * Objects are compared member by member while both inputs have the same
+ * keys in the same order; from the first mismatch, the rest of both
+ * objects is read into trees and compared by key. Other values are only
+ * read into trees when they are reported as added or replaced.
+ */
+template <class S>
+class stream_differ
+{
+public:
+    stream_differ(pull_parser& a, pull_parser& b, S& sink) : a(a), b(b), sink(sink) {}
+
+    /**
+     * @brief Compare inputs
+     *
+     * @param records Compare sequences of documents
+     */
+    void run(bool records)
+    {
+        if (records) {
+            compare_elements(parse_event::end_of_input);
+            return;
+        }
+        a.next();
+        b.next();
+        compare();
+    }
+
+private:
+    /**
+     * @brief Compare values whose first events were just read
+     */
+    void compare()
+    {
+        const auto ea = a.event();
+        const auto eb = b.event();
+        if ((ea == parse_event::begin_array) && (eb == parse_event::begin_array)) {
+            compare_elements(parse_event::end_array);
+        } else if ((ea == parse_event::begin_object) && (eb == parse_event::begin_object)) {
+            compare_members();
+        } else if ((ea == parse_event::scalar) && (eb == parse_event::scalar)) {
+            if (!(a.scalar() == b.scalar())) {
+                sink(change_op::replace, path, b.scalar());
+            }
+        } else {
+            a.skip();
+            sink(change_op::replace, path, b.read_value());
+        }
+    }
+
+    /**
+     * @brief Compare elements of arrays (or documents of sequences)
+     */
+    void compare_elements(parse_event end)
+    {
+        for (std::size_t i = 0;; ++i) {
+            const bool a_end = (a.next() == end);
+            const bool b_end = (b.next() == end);
+            if (a_end && b_end) {
+                return;
+            }
+            if (a_end) {
+                for (; b.event() != end; b.next(), ++i) {
+                    path.append(i);
+                    sink(change_op::add, path, b.read_value());
+                    path.pop();
+                }
+                return;
+            }
+            if (b_end) {
+                std::size_t extra = 0;
+                for (; a.event() != end; a.next(), ++extra) {
+                    a.skip();
+                }
+                for (std::size_t k = extra; k > 0; --k) {
+                    path.append(i + k - 1);
+                    sink(change_op::remove, path, value());
+                    path.pop();
+                }
+                return;
+            }
+            path.append(i);
+            compare();
+            path.pop();
+        }
+    }
+
+    /**
+     * @brief Compare members of objects
+     */
+    void compare_members()
+    {
+        for (;;) {
+            const auto ea = a.next();
+            const auto eb = b.next();
+            if ((ea == parse_event::end_object) && (eb == parse_event::end_object)) {
+                return;
+            }
+            if ((ea == parse_event::key) && (eb == parse_event::key) && (a.key() == b.key())) {
+                path.append(a.key());
+                a.next();
+                b.next();
+                compare();
+                path.pop();
+                continue;
+            }
+            // out of order (or different keys): sort the rest by key
+            const value x = rest_of_object(a);
+            const value y = rest_of_object(b);
+            diff_values(x, y, path, sink);
+            return;
+        }
+    }
+
+    /**
+     * @brief Read the rest of an object (from the current event) into a tree
+     */
+    static value rest_of_object(pull_parser& p)
+    {
+        value rest = object();
+        while (p.event() == parse_event::key) {
+            std::string key = p.key();
+            p.next();
+            rest[key] = p.read_value();
+            p.next();
+        }
+        return rest;
+    }
+
+    pull_parser& a; ///< Old input
+    pull_parser& b; ///< New input
+    S& sink;        ///< Receiver of changes
+    pointer path;   ///< Path of the values being compared
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Compare two trees
+ *
+ * @param a Old value
+ * @param b New value
+ * @param on_change A function called as on_change(op, path, new_value) for each change
+ */
+template <class F>
+requires std::invocable<F&, change_op, const pointer&, const value&>
+void diff(const value& a, const value& b, F&& on_change)
+{
+    pointer path;
+    impl::diff_values(a, b, path, on_change);
+}
+
+/**
+ * @brief Compare two trees
+ *
+ * @param a Old value
+ * @param b New value
+ * @return Changes from a to b (to_patch() makes a JSON Patch)
+ */
+inline journal diff(const value& a, const value& b)
+{
+    journal changes;
+    diff(a, b, [&](change_op op, const pointer& path, const value& v) { changes.record(op, path, v); });
+    return changes;
+}
+
+/**
+ * @brief Compare two inputs without parsing them into trees
+ *
+ * Inputs are read in lockstep with pull parsers. Memory use is bounded by
+ * the nesting depth, the largest object whose members differ in order or
+ * keys, and the values reported as added or replaced.
+ *
+ * @param a Old input
+ * @param b New input
+ * @param on_change A function called as on_change(op, path, new_value) for each change
+ * @param options Options
+ * @throws json5pp::syntax_error on a syntax error in either input
+ */
+template <class F>
+requires std::invocable<F&, change_op, const pointer&, const value&>
+void diff(std::istream& a, std::istream& b, F&& on_change, const diff_options& options = {})
+{
+    pull_parser x(a, options.json5);
+    pull_parser y(b, options.json5);
+    impl::stream_differ<std::remove_reference_t<F>>(x, y, on_change).run(options.records);
+}
+
+/**
+ * @brief Compare two inputs without parsing them into trees
+ *
+ * @param a Old input
+ * @param b New input
+ * @param options Options
+ * @return Changes from a to b (to_patch() makes a JSON Patch)
+ */
+inline journal diff(std::istream& a, std::istream& b, const diff_options& options = {})
+{
+    journal changes;
+    diff(a, b, [&](change_op op, const pointer& path, const value& v) { changes.record(op, path, v); }, options);
+    return changes;
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_DIFF_HPP_ */
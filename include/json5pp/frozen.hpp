@@ -0,0 +1,525 @@
+#ifndef _JSON5PP_FROZEN_HPP_
+#define _JSON5PP_FROZEN_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define _JSON5PP_FROZEN_MMAP_ 1
+#endif
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Relocatable read-only document layout
+ *
+ * A frozen document is a single buffer which can be written to a file or
+ * shared memory and used in place by any process, without parsing and
+ * without pointer fix-ups: all references are offsets from the start of
+ * the buffer.
+ *
+ * Layout (native byte order; the buffer must be 8-byte aligned):
+ *  - header: magic "J5PF", version, total size, root slot
+ *  - slot (16 bytes): type, count, payload (bool / integer / double bits / offset)
+ *  - string: bytes + NUL; array: count slots; object: count (key slot, value slot)
+ *    pairs sorted by key
+ */
+namespace frozen {
+
+/**
+ * @brief Type of a frozen node
+ */
+enum class node_type : std::uint8_t {
+    null,
+    boolean,
+    integer,
+    number,
+    string,
+    array,
+    object,
+};
+
+namespace impl {
+
+inline constexpr char magic[4] = {'J', '5', 'P', 'F'};
+inline constexpr std::uint32_t version = 1;
+
+struct slot {
+    node_type type;
+    std::uint8_t reserved[3];
+    std::uint32_t count;   ///< Length of string, number of elements / members
+    std::uint64_t payload; ///< Boolean, integer, double bits or offset
+};
+static_assert(sizeof(slot) == 16);
+
+struct header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t size; ///< Total size in bytes
+    slot root;
+};
+static_assert(sizeof(header) == 32);
+
+/**
+ * @brief Builder of a frozen buffer
+ */
+class builder
+{
+public:
+    std::string build(const value& root)
+    {
+        buffer.assign(sizeof(header), '\0');
+        const slot r = make_slot(root);
+        header h{};
+        std::memcpy(h.magic, magic, sizeof(magic));
+        h.version = version;
+        h.size = buffer.size();
+        h.root = r;
+        std::memcpy(buffer.data(), &h, sizeof(h));
+        return std::move(buffer);
+    }
+
+private:
+    /**
+     * @brief Reserve 8-byte aligned space at the end of buffer
+     *
+     * @return Offset of the space
+     */
+    std::uint64_t reserve(std::size_t size)
+    {
+        const std::uint64_t offset = buffer.size();
+        buffer.resize(offset + ((size + 7) & ~static_cast<std::size_t>(7)), '\0');
+        return offset;
+    }
+
+    static std::uint32_t count_of(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("too large to freeze");
+        }
+        return static_cast<std::uint32_t>(n);
+    }
+
+    slot make_string(const std::string& s)
+    {
+        slot r{node_type::string, {}, count_of(s.size()), reserve(s.size() + 1)};
+        std::memcpy(buffer.data() + r.payload, s.data(), s.size());
+        return r;
+    }
+
+    void put(std::uint64_t offset, const slot& s) { std::memcpy(buffer.data() + offset, &s, sizeof(s)); }
+
+    slot make_slot(const value& v)
+    {
+        slot r{node_type::null, {}, 0, 0};
+        if (v.is_boolean()) {
+            r.type = node_type::boolean;
+            r.payload = v.as_boolean() ? 1 : 0;
+        } else if (v.is_integer()) {
+            r.type = node_type::integer;
+            r.payload = static_cast<std::uint64_t>(v.get<long long>());
+        } else if (v.is_number()) {
+            const double d = v.as_number();
+            r.type = node_type::number;
+            std::memcpy(&r.payload, &d, sizeof(d));
+        } else if (v.is_string()) {
+            r = make_string(v.as_string());
+        } else if (v.is_array()) {
+            const auto& elements = v.as_array();
+            r = slot{node_type::array, {}, count_of(elements.size()), reserve(elements.size() * sizeof(slot))};
+            std::uint64_t offset = r.payload;
+            for (const auto& e : elements) {
+                // buffer may grow while freezing children, so write by offset
+                const slot s = make_slot(e);
+                put(offset, s);
+                offset += sizeof(slot);
+            }
+        } else if (v.is_object()) {
+            // std::map keeps members sorted by key
+            const auto& members = v.as_object();
+            r = slot{node_type::object, {}, count_of(members.size()), reserve(members.size() * 2 * sizeof(slot))};
+            std::uint64_t offset = r.payload;
+            for (const auto& pair : members) {
+                const slot k = make_string(pair.first);
+                put(offset, k);
+                const slot s = make_slot(pair.second);
+                put(offset + sizeof(slot), s);
+                offset += 2 * sizeof(slot);
+            }
+        }
+        return r;
+    }
+
+    std::string buffer; ///< Frozen buffer
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Freeze a value into a relocatable buffer
+ *
+ * @param v A value
+ * @return Frozen buffer
+ * @throws std::length_error if a string, array or object has 2^32 or more elements
+ */
+inline std::string freeze(const value& v)
+{
+    return impl::builder().build(v);
+}
+
+/**
+ * @brief Freeze a value and write to a stream (ex: a file to be mapped)
+ */
+inline void freeze(std::ostream& ostream, const value& v)
+{
+    const auto buffer = freeze(v);
+    ostream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+/**
+ * @brief A node of a frozen document (read-only, value-like API)
+ *
+ * Accessors throw std::bad_cast on type mismatch, like value. Missing
+ * members and out-of-range elements yield a null node.
+ */
+class node
+{
+public:
+    node() = default;
+
+    node_type type() const noexcept { return s->type; }
+
+    bool is_null() const noexcept { return s->type == node_type::null; }
+    bool is_boolean() const noexcept { return s->type == node_type::boolean; }
+    bool is_integer() const noexcept { return s->type == node_type::integer; }
+    bool is_number() const noexcept { return (s->type == node_type::integer) || (s->type == node_type::number); }
+    bool is_string() const noexcept { return s->type == node_type::string; }
+    bool is_array() const noexcept { return s->type == node_type::array; }
+    bool is_object() const noexcept { return s->type == node_type::object; }
+
+    bool as_boolean() const
+    {
+        if (!is_boolean()) throw std::bad_cast();
+        return s->payload != 0;
+    }
+
+    long long as_integer() const
+    {
+        if (is_integer()) return static_cast<long long>(s->payload);
+        return static_cast<long long>(as_number());
+    }
+
+    double as_number() const
+    {
+        if (is_integer()) return static_cast<double>(static_cast<long long>(s->payload));
+        if (!is_number()) throw std::bad_cast();
+        double d;
+        std::memcpy(&d, &s->payload, sizeof(d));
+        return d;
+    }
+
+    std::string_view as_string() const
+    {
+        if (!is_string()) throw std::bad_cast();
+        return std::string_view(base + s->payload, s->count);
+    }
+
+    /**
+     * @brief Number of elements or members
+     *
+     * @throws std::runtime_error if not an array nor object
+     */
+    std::size_t size() const
+    {
+        if (!is_array() && !is_object()) {
+            throw std::runtime_error("size() is only supported by array or object value");
+        }
+        return s->count;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /// Element of an array (null if out of range)
+    node at(std::size_t index) const
+    {
+        if (!is_array() || (index >= s->count)) return node();
+        return node(base, slots() + index);
+    }
+
+    node operator[](std::size_t index) const { return at(index); }
+    node operator[](int index) const { return (index < 0) ? node() : at(static_cast<std::size_t>(index)); }
+
+    /// Member of an object (null if not found); binary search on sorted keys
+    node at(std::string_view key) const
+    {
+        const std::size_t i = find(key);
+        return (i < s->count) ? member(i) : node();
+    }
+
+    node operator[](std::string_view key) const { return at(key); }
+    node operator[](const char* key) const { return at(std::string_view(key)); }
+
+    /// Test if an object has a member
+    bool contains(std::string_view key) const
+    {
+        if (!is_object()) throw std::bad_cast();
+        return find(key) < s->count;
+    }
+
+    /// Key of i-th member of an object (ordered by key)
+    std::string_view key(std::size_t i) const { return node(base, slots() + 2 * i).as_string(); }
+
+    /// Value of i-th member of an object (ordered by key)
+    node member(std::size_t i) const { return node(base, slots() + 2 * i + 1); }
+
+    /**
+     * @brief Copy into a mutable value
+     */
+    value to_value() const
+    {
+        switch (s->type) {
+        case node_type::boolean:
+            return value(as_boolean());
+        case node_type::integer: {
+            const auto n = as_integer();
+            if ((n >= std::numeric_limits<value::integer_type>::min()) && (n <= std::numeric_limits<value::integer_type>::max())) {
+                return value(static_cast<value::integer_type>(n));
+            }
+            return value(n);
+        }
+        case node_type::number:
+            return value(as_number());
+        case node_type::string:
+            return value(std::string(as_string()));
+        case node_type::array: {
+            value v = array();
+            auto& elements = v.as_array();
+            elements.reserve(s->count);
+            for (std::size_t i = 0; i < s->count; ++i) {
+                elements.push_back(at(i).to_value());
+            }
+            return v;
+        }
+        case node_type::object: {
+            value v = object();
+            auto& members = v.as_object();
+            for (std::size_t i = 0; i < s->count; ++i) {
+                members.emplace_hint(members.end(), std::string(key(i)), member(i).to_value());
+            }
+            return v;
+        }
+        default:
+            return value();
+        }
+    }
+
+private:
+    friend class document;
+
+    node(const char* base, const impl::slot* s) : base(base), s(s) {}
+
+    const impl::slot* slots() const { return reinterpret_cast<const impl::slot*>(base + s->payload); }
+
+    /// Index of member (count if not found)
+    std::size_t find(std::string_view key) const
+    {
+        if (!is_object()) return s->count;
+        std::size_t lo = 0, hi = s->count;
+        while (lo < hi) {
+            const std::size_t mid = (lo + hi) / 2;
+            const auto k = this->key(mid);
+            if (k < key) {
+                lo = mid + 1;
+            } else if (key < k) {
+                hi = mid;
+            } else {
+                return mid;
+            }
+        }
+        return s->count;
+    }
+
+    static constexpr impl::slot null_slot{node_type::null, {}, 0, 0};
+
+    const char* base = nullptr;          ///< Start of frozen buffer
+    const impl::slot* s = &null_slot;    ///< Slot of the node
+};
+
+/**
+ * @brief A frozen document on a buffer (the buffer is not copied)
+ */
+class document
+{
+public:
+    /**
+     * @brief Construct a document on a frozen buffer
+     *
+     * With verify, all offsets are checked once (a walk over all nodes, no
+     * allocation per node), so accessors need no bounds checks. Skip it for
+     * trusted buffers (ex: a segment frozen by the same host) to open in O(1).
+     *
+     * @param data Frozen buffer (8-byte aligned; must outlive the document)
+     * @param size Size of the buffer
+     * @param verify Check all offsets
+     * @throws std::runtime_error if the buffer is not a valid frozen document
+     */
+    document(const void* data, std::size_t size, bool verify = true) : base(static_cast<const char*>(data))
+    {
+        impl::header h;
+        if ((size < sizeof(h)) || (reinterpret_cast<std::uintptr_t>(data) % alignof(impl::slot))) {
+            throw std::runtime_error("invalid frozen document");
+        }
+        std::memcpy(&h, data, sizeof(h));
+        if (std::memcmp(h.magic, impl::magic, sizeof(h.magic)) || (h.version != impl::version) || (h.size > size)) {
+            throw std::runtime_error("invalid frozen document");
+        }
+        if (verify) {
+            validate(reinterpret_cast<const impl::header*>(data)->root, h.size);
+        }
+    }
+
+    explicit document(std::string_view buffer, bool verify = true) : document(buffer.data(), buffer.size(), verify) {}
+
+    /// Root node
+    node root() const { return node(base, &reinterpret_cast<const impl::header*>(base)->root); }
+
+    node operator[](std::string_view key) const { return root()[key]; }
+    node operator[](const char* key) const { return root()[key]; }
+    node operator[](int index) const { return root()[index]; }
+
+private:
+    /**
+     * @brief Check offsets of a tree (iteratively)
+     *
+     * Children of a node are stored after the node, and each slot is used
+     * once, so a valid tree has increasing offsets and at most size / 16 slots.
+     */
+    void validate(const impl::slot& root, std::uint64_t size) const
+    {
+        std::vector<const impl::slot*> stack{&root};
+        auto fail = []() { throw std::runtime_error("invalid frozen document"); };
+        std::uint64_t budget = size / sizeof(impl::slot);
+        while (!stack.empty()) {
+            const impl::slot* s = stack.back();
+            stack.pop_back();
+            const std::uint64_t n = s->count;
+            const auto position = static_cast<std::uint64_t>(reinterpret_cast<const char*>(s) - base);
+            if ((budget-- == 0) || ((s->type >= node_type::string) && (s->payload <= position))) fail();
+            switch (s->type) {
+            case node_type::null:
+            case node_type::boolean:
+            case node_type::integer:
+            case node_type::number:
+                break;
+            case node_type::string:
+                if ((s->payload > size) || (n >= size - s->payload)) fail();
+                break;
+            case node_type::array:
+            case node_type::object: {
+                const std::uint64_t slots = (s->type == node_type::array) ? n : 2 * n;
+                if ((s->payload % alignof(impl::slot)) || (s->payload > size) || (slots > (size - s->payload) / sizeof(impl::slot))) fail();
+                const auto* first = reinterpret_cast<const impl::slot*>(base + s->payload);
+                for (std::uint64_t i = 0; i < slots; ++i) {
+                    if ((s->type == node_type::object) && (i % 2 == 0) && (first[i].type != node_type::string)) fail();
+                    stack.push_back(first + i);
+                }
+                break;
+            }
+            default:
+                fail();
+            }
+        }
+    }
+
+    const char* base; ///< Start of frozen buffer
+};
+
+#ifdef _JSON5PP_FROZEN_MMAP_
+/**
+ * @brief A frozen document mapped read-only from a file (POSIX)
+ *
+ * Pages are shared by all processes mapping the same file.
+ */
+class mapped_document
+{
+public:
+    /**
+     * @brief Map a frozen file
+     *
+     * @param path Path of the file (or of a POSIX shared memory object under /dev/shm)
+     * @param verify Check all offsets (see document)
+     * @throws std::runtime_error on failure
+     */
+    explicit mapped_document(const std::string& path, bool verify = true)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0) {
+            length = static_cast<std::size_t>(st.st_size);
+            if (length > 0) {
+                addr = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            }
+        }
+        ::close(fd);
+        if (!addr || (addr == MAP_FAILED)) {
+            addr = nullptr;
+            throw std::runtime_error("cannot map " + path);
+        }
+        try {
+            doc.emplace(addr, length, verify);
+        } catch (...) {
+            ::munmap(addr, length);
+            throw;
+        }
+    }
+
+    mapped_document(const mapped_document&) = delete;
+    mapped_document& operator=(const mapped_document&) = delete;
+
+    ~mapped_document()
+    {
+        if (addr) {
+            ::munmap(addr, length);
+        }
+    }
+
+    /// The document
+    const document& get() const noexcept { return *doc; }
+
+    /// Root node
+    node root() const { return doc->root(); }
+
+    node operator[](std::string_view key) const { return root()[key]; }
+    node operator[](const char* key) const { return root()[key]; }
+    node operator[](int index) const { return root()[index]; }
+
+private:
+    void* addr = nullptr;         ///< Mapped address
+    std::size_t length = 0;       ///< Mapped length
+    std::optional<document> doc;  ///< Document on the mapping
+};
+#endif
+
+} /* namespace frozen */
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_FROZEN_HPP_ */
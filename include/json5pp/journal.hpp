@@ -0,0 +1,382 @@
+#ifndef _JSON5PP_JOURNAL_HPP_
+#define _JSON5PP_JOURNAL_HPP_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json5pp.hpp"
+#include "pointer.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Operation of a change (subset of JSON Patch operations)
+ */
+enum class change_op {
+    add,
+    remove,
+    replace,
+};
+
+namespace impl {
+
+inline const char* change_op_name(change_op op)
+{
+    switch (op) {
+    case change_op::add:
+        return "add";
+    case change_op::remove:
+        return "remove";
+    default:
+        return "replace";
+    }
+}
+
+/**
+ * @brief Apply one change to a document
+ *
+ * @throws std::out_of_range if the target (or its parent) does not exist
+ */
+inline void apply_change(value& doc, change_op op, const pointer& path, value data)
+{
+    if (path.empty()) {
+        if (op == change_op::remove) {
+            doc.reset();
+        } else {
+            doc = std::move(data);
+        }
+        return;
+    }
+    value* parent = path.parent().find(doc);
+    const auto& token = path.tokens().back();
+    if (parent && parent->is_object()) {
+        auto& members = parent->as_object();
+        if (op == change_op::add) {
+            members[token] = std::move(data);
+            return;
+        }
+        auto iter = members.find(token);
+        if (iter != members.end()) {
+            if (op == change_op::remove) {
+                members.erase(iter);
+            } else {
+                iter->second = std::move(data);
+            }
+            return;
+        }
+    } else if (parent && parent->is_array()) {
+        auto& elements = parent->as_array();
+        std::size_t index = elements.size();
+        if (((op == change_op::add) && (token == "-")) || pointer::to_index(token, index)) {
+            if ((op == change_op::add) && (index <= elements.size())) {
+                elements.insert(elements.begin() + index, std::move(data));
+                return;
+            }
+            if (index < elements.size()) {
+                if (op == change_op::remove) {
+                    elements.erase(elements.begin() + index);
+                } else {
+                    elements[index] = std::move(data);
+                }
+                return;
+            }
+        }
+    }
+    throw std::out_of_range("change target not found: " + path.to_string());
+}
+
+} /* namespace impl */
+
+/**
+ * @brief Journal of changes made to a document
+ */
+class journal
+{
+public:
+    /**
+     * @brief A recorded change
+     */
+    struct entry {
+        change_op op; ///< Operation
+        pointer path; ///< Target of the change
+        value data;   ///< New value (null for remove)
+    };
+
+    /**
+     * @brief Record a change
+     *
+     * A replace of the same path as the last change updates the last change
+     * instead of adding a new one.
+     */
+    void record(change_op op, pointer path, value data = value())
+    {
+        if ((op == change_op::replace) && !list.empty() && (list.back().op != change_op::remove) && (list.back().path == path)) {
+            list.back().data = std::move(data);
+            return;
+        }
+        list.push_back(entry{op, std::move(path), std::move(data)});
+    }
+
+    /// Recorded changes (oldest first)
+    const std::vector<entry>& entries() const noexcept { return list; }
+
+    /// Number of recorded changes
+    std::size_t size() const noexcept { return list.size(); }
+
+    /// Test if no change is recorded
+    bool empty() const noexcept { return list.empty(); }
+
+    /// Remove all recorded changes
+    void clear() noexcept { list.clear(); }
+
+    /**
+     * @brief Export the changes as JSON Patch (RFC 6902)
+     * @see https://www.rfc-editor.org/rfc/rfc6902
+     *
+     * @return An array of operations
+     */
+    value to_patch() const
+    {
+        value patch = array();
+        auto& ops = patch.as_array();
+        ops.reserve(list.size());
+        for (const auto& e : list) {
+            value op = object({{"op", impl::change_op_name(e.op)}, {"path", e.path.to_string()}});
+            if (e.op != change_op::remove) {
+                op["value"] = e.data;
+            }
+            ops.push_back(std::move(op));
+        }
+        return patch;
+    }
+
+    /**
+     * @brief Apply the changes to a replica
+     *
+     * @param doc A document which was equal to the journaled one when recording started
+     * @throws std::out_of_range if a target does not exist in the replica
+     */
+    void apply(value& doc) const
+    {
+        for (const auto& e : list) {
+            impl::apply_change(doc, e.op, e.path, e.data);
+        }
+    }
+
+private:
+    std::vector<entry> list; ///< Recorded changes
+};
+
+/**
+ * @brief Apply JSON Patch (add, remove and replace operations)
+ *
+ * @param doc A document to modify
+ * @param patch An array of operations
+ * @throws std::invalid_argument if patch is malformed or has unsupported operations
+ * @throws std::out_of_range if a target does not exist
+ */
+inline void apply_patch(value& doc, const value& patch)
+{
+    if (!patch.is_array()) {
+        throw std::invalid_argument("JSON patch must be an array");
+    }
+    for (const auto& op : patch.as_array()) {
+        const auto& name = op["op"];
+        const auto& path = op["path"];
+        if (!name.is_string() || !path.is_string()) {
+            throw std::invalid_argument("JSON patch operation requires op and path");
+        }
+        const auto& s = name.as_string();
+        if (s == "remove") {
+            impl::apply_change(doc, change_op::remove, pointer(path.as_string()), value());
+        } else if ((s == "add") || (s == "replace")) {
+            if (!op.contains("value")) {
+                throw std::invalid_argument("JSON patch operation requires value");
+            }
+            impl::apply_change(doc, (s == "add") ? change_op::add : change_op::replace, pointer(path.as_string()), op["value"]);
+        } else {
+            throw std::invalid_argument("unsupported JSON patch operation: " + s);
+        }
+    }
+}
+
+class journaled;
+
+/**
+ * @brief Reference to a node of a journaled document
+ *
+ * Mutations through the reference modify the document and record changes.
+ * The node is looked up by path on each access, so references stay valid
+ * while the document changes.
+ */
+class tracked
+{
+public:
+    /// Path of the node
+    const pointer& path() const noexcept { return where; }
+
+    /**
+     * @brief Get the referenced value
+     *
+     * @throws std::out_of_range if the node does not exist
+     */
+    const value& get() const;
+
+    operator const value&() const { return get(); }
+
+    /// Test if the node exists
+    bool exists() const;
+
+    /// Reference to a member
+    tracked operator[](const std::string& key) const { return tracked(doc, pointer(where).append(key)); }
+    tracked operator[](const char* key) const { return (*this)[std::string(key)]; }
+
+    /// Reference to an element
+    tracked operator[](const int index) const { return tracked(doc, pointer(where).append(static_cast<std::size_t>(index))); }
+
+    tracked at(const std::string& key) const { return (*this)[key]; }
+    tracked at(const int index) const { return (*this)[index]; }
+
+    /**
+     * @brief Assign a value (records add or replace)
+     *
+     * A member is added if missing. Missing ancestors which are members of
+     * objects are added as empty objects first (like value::operator[]), each
+     * recorded as its own add. An element may be assigned only at an existing
+     * index or at the end of the array.
+     *
+     * @throws std::out_of_range if an ancestor is missing and cannot be added
+     */
+    tracked& operator=(value v);
+
+    tracked& operator=(const tracked& other) { return *this = value(other.get()); }
+
+    /**
+     * @brief Append an element to the array (records add)
+     */
+    tracked& append(value v);
+
+    /**
+     * @brief Remove a member (records remove if it existed)
+     */
+    void erase(const std::string& key);
+
+    /**
+     * @brief Remove an element (records remove)
+     *
+     * @throws std::out_of_range if index is out of range
+     */
+    void erase(const int index);
+
+private:
+    friend class journaled;
+
+    tracked(journaled& doc, pointer where) : doc(doc), where(std::move(where)) {}
+
+    journaled& doc; ///< Document
+    pointer where;  ///< Path of the node
+};
+
+/**
+ * @brief A document which records its changes
+ *
+ * ```cpp
+ * json5pp::journaled doc(json5pp::parse(text));
+ * doc["server"]["port"] = 8080;
+ * doc["users"].append("guest");
+ * send(doc.changes().to_patch().stringify());
+ * ```
+ */
+class journaled
+{
+public:
+    explicit journaled(value doc = value()) : root(std::move(doc)) {}
+
+    /// The document (read-only; modify through tracked references)
+    const value& document() const noexcept { return root; }
+
+    /// Recorded changes
+    const journal& changes() const noexcept { return log; }
+    journal& changes() noexcept { return log; }
+
+    /// Reference to the root
+    tracked ref() { return tracked(*this, pointer()); }
+
+    /// Reference to a member of the root
+    tracked operator[](const std::string& key) { return ref()[key]; }
+    tracked operator[](const char* key) { return ref()[key]; }
+
+    /// Reference to an element of the root
+    tracked operator[](const int index) { return ref()[index]; }
+
+private:
+    friend class tracked;
+
+    /**
+     * @brief Apply a change and record it
+     */
+    void change(change_op op, const pointer& path, value data)
+    {
+        impl::apply_change(root, op, path, data);
+        log.record(op, path, std::move(data));
+    }
+
+    value root;  ///< The document
+    journal log; ///< Recorded changes
+};
+
+inline const value& tracked::get() const
+{
+    const value* v = where.find(doc.root);
+    if (!v) {
+        throw std::out_of_range("value not found: " + where.to_string());
+    }
+    return *v;
+}
+
+inline bool tracked::exists() const
+{
+    return where.find(doc.root) != nullptr;
+}
+
+inline tracked& tracked::operator=(value v)
+{
+    pointer ancestor;
+    for (std::size_t i = 0; i + 1 < where.tokens().size(); ++i) {
+        const value* container = ancestor.find(doc.root);
+        ancestor.append(where.tokens()[i]);
+        if (container && container->is_object() && !container->contains(where.tokens()[i])) {
+            doc.change(change_op::add, ancestor, object());
+        }
+    }
+    const value* parent = where.empty() ? nullptr : where.parent().find(doc.root);
+    const bool exists = !parent || (where.find(doc.root) != nullptr);
+    doc.change(exists ? change_op::replace : change_op::add, where, std::move(v));
+    return *this;
+}
+
+inline tracked& tracked::append(value v)
+{
+    const std::size_t size = get().as_array().size();
+    doc.change(change_op::add, pointer(where).append(size), std::move(v));
+    return *this;
+}
+
+inline void tracked::erase(const std::string& key)
+{
+    if (get().contains(key)) {
+        doc.change(change_op::remove, pointer(where).append(key), value());
+    }
+}
+
+inline void tracked::erase(const int index)
+{
+    doc.change(change_op::remove, pointer(where).append(static_cast<std::size_t>(index)), value());
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_JOURNAL_HPP_ */
@@ -1,10 +1,12 @@
 #ifndef _JSON5PP_HPP_
 #define _JSON5PP_HPP_
 
+#include <cassert>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <map>
+#include <memory_resource>
 #include <sstream>
 #include <initializer_list>
 #include <cmath>
@@ -13,6 +15,15 @@
 #include <concepts>
 #include <variant>
 #include <optional>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <compare>
+#include <string_view>
+#include <utility>
 
 namespace json5pp {
 
@@ -86,6 +97,76 @@ constexpr bool any_of_types()
 template <typename T, typename... Args>
 inline constexpr bool any_of_types_v = any_of_types<T, Args...>();
 
+// Compare an integer with a floating point number exactly (NaN is unordered)
+template <typename I, typename F>
+constexpr std::partial_ordering compare_integer_float(I i, F f)
+{
+    using W = std::conditional_t<std::is_signed_v<I>, long long, unsigned long long>;
+    const double d = static_cast<double>(f);
+    if (d != d) {
+        return std::partial_ordering::unordered;
+    }
+    // [lower, upper) is the range of W
+    constexpr double upper = std::is_signed_v<I> ? 9223372036854775808.0 : 18446744073709551616.0;
+    constexpr double lower = std::is_signed_v<I> ? -9223372036854775808.0 : 0.0;
+    if (d >= upper) {
+        return std::partial_ordering::less;
+    } else if (d < lower) {
+        return std::partial_ordering::greater;
+    }
+    const W t = static_cast<W>(d);
+    if (static_cast<W>(i) != t) {
+        return (static_cast<W>(i) < t) ? std::partial_ordering::less : std::partial_ordering::greater;
+    }
+    const double frac = d - static_cast<double>(t);
+    return (frac > 0) ? std::partial_ordering::less : (frac < 0) ? std::partial_ordering::greater : std::partial_ordering::equivalent;
+}
+
+// Compare two numbers of any arithmetic types by value
+// (integers exactly, also against floating point numbers: NaN is unordered)
+template <typename A, typename B>
+constexpr std::partial_ordering compare_numbers(A a, B b)
+{
+    if constexpr (std::is_integral_v<A> && std::is_integral_v<B>) {
+        return std::cmp_less(+a, +b) ? std::partial_ordering::less : std::cmp_equal(+a, +b) ? std::partial_ordering::equivalent : std::partial_ordering::greater;
+    } else if constexpr (std::is_integral_v<A>) {
+        return compare_integer_float(+a, b);
+    } else if constexpr (std::is_integral_v<B>) {
+        return 0 <=> compare_integer_float(+b, a);
+    } else {
+        return static_cast<double>(a) <=> static_cast<double>(b);
+    }
+}
+
+// Convert a string to another string type (passed through if the type is the same)
+// ex: convert_string<std::string>(pmr_string) -> a copy as std::string
+template <typename S, typename T>
+constexpr decltype(auto) convert_string(T&& s)
+{
+    if constexpr (std::is_same_v<S, std::remove_cvref_t<T>>) {
+        return std::forward<T>(s);
+    } else {
+        return S(s.data(), s.size());
+    }
+}
+
+// Test if a storage type allocates from a std::pmr::memory_resource (ex: std::pmr::string)
+template <typename T>
+concept resource_aware = requires { typename T::allocator_type; } && std::is_constructible_v<typename T::allocator_type, std::pmr::memory_resource*>;
+
+// Make an empty string/container which allocates from a resource
+// (the default allocator if resource is nullptr or T is not resource_aware)
+template <typename T>
+T make_storage(std::pmr::memory_resource* resource)
+{
+    if constexpr (resource_aware<T>) {
+        if (resource) {
+            return T(typename T::allocator_type(resource));
+        }
+    }
+    return T();
+}
+
 /**
  * @brief Parser/stringifier flags
  */
@@ -126,6 +207,14 @@ template <flags_type F>
 class parser;
 template <flags_type F, indent_type I>
 class stringifier;
+template <flags_type F, indent_type I>
+class pull_stringifier;
+
+// Test if T is a stringifier
+template <typename T>
+inline constexpr bool is_stringifier_v = false;
+template <flags_type F, indent_type I>
+inline constexpr bool is_stringifier_v<stringifier<F, I>> = true;
 
 template <flags_type S, flags_type C>
 class manipulator_flags
@@ -158,40 +247,102 @@ public:
 
 } /* namespace impl */
 
+class record_reader;
+class pull_parser;
+
+/**
+ * @brief Default storage types of basic_value
+ *
+ * Derive from this class and override some of the members to customize:
+ * - integer_type: Integer type made by the parser (int, long or long long)
+ * - number_type: Number type made by the parser (float or double)
+ * - string_type: String type (std::string like, ex: std::pmr::string)
+ * - array_type<V>: Sequence of values (std::vector like)
+ * - object_type<K, V>: Map from keys to values (std::map like)
+ *
+ * Allocators are chosen with the containers (ex: std::pmr::vector, see pmr_traits).
+ */
+struct default_traits {
+    using integer_type = int;
+    using number_type = double;
+    using string_type = std::string;
+    template <class V>
+    using array_type = std::vector<V>;
+    template <class K, class V>
+    using object_type = std::map<K, V>;
+};
+
+/**
+ * @brief Storage types allocating from a std::pmr::memory_resource
+ *
+ * 64-bit integers, std::pmr strings and containers. parse() / parse5() /
+ * array() / object() take the resource of a document (ex: a node_pool or
+ * an arena); the default resource is used otherwise.
+ */
+struct pmr_traits : default_traits {
+    using integer_type = long long;
+    using string_type = std::pmr::string;
+    template <class V>
+    using array_type = std::pmr::vector<V>;
+    template <class K, class V>
+    using object_type = std::map<K, V, std::less<>, std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+};
+
+template <class Traits>
+class basic_value;
+
+/**
+ * @brief A class to hold JSON value (with default storage types)
+ */
+using value = basic_value<default_traits>;
+
+/**
+ * @brief A class to hold JSON value (with pmr storage types)
+ */
+using pmr_value = basic_value<pmr_traits>;
+
 /**
  * @brief A class to hold JSON value
+ *
+ * @tparam Traits Storage types (see default_traits)
  */
-class value
+template <class Traits>
+class basic_value
 {
+public:
+    using traits_type = Traits;
     using null_type = std::nullptr_t;
     using boolean_type = bool;
-    using number_type = double;
-    using integer_type = int;
+    using number_type = typename Traits::number_type;
+    using integer_type = typename Traits::integer_type;
     using number_i_type = integer_type;
-    using string_type = std::string;
+    using string_type = typename Traits::string_type;
     using string_p_type = const char*;
-    using array_type = std::vector<value>;
-    using object_type = std::map<string_type, value>;
-    using pair_type = object_type::value_type;
+    using array_type = typename Traits::template array_type<basic_value>;
+    using object_type = typename Traits::template object_type<string_type, basic_value>;
+    using pair_type = typename object_type::value_type;
     using json_type = std::string;
 
+    static_assert(impl::any_of_types_v<integer_type, int, long, long long>, "integer_type must be int, long or long long");
+    static_assert(impl::any_of_types_v<number_type, float, double>, "number_type must be float or double");
+
     /*================================================================================
      * Construction
      */
 public:
     // Explicitly declare that we are happy with the default behavior
-    value() = default;
-    value(const value&) = default;
-    value(value&&) = default;
-    value& operator=(const value&) = default;
-    value& operator=(value&&) = default;
-    ~value() = default;
+    basic_value() = default;
+    basic_value(const basic_value&) = default;
+    basic_value(basic_value&&) = default;
+    basic_value& operator=(const basic_value&) = default;
+    basic_value& operator=(basic_value&&) = default;
+    ~basic_value() = default;
 
     /**
      * @brief JSON value constructor for "null" type.
      * @param null A dummy argument for nullptr
      */
-    value(std::nullptr_t) noexcept {}
+    basic_value(std::nullptr_t) noexcept {}
 
     /**
      * @brief JSON value constructor for all single value built-in data types (bool, int, long, float, double, std::string)
@@ -205,34 +356,51 @@ public:
      *   value x = {1}; //not compile due to explicit constructor of initializer_list
      */
     template <typename T>
-    requires std::integral<std::remove_cvref_t<T>> || std::floating_point<std::remove_cvref_t<T>> || std::is_same_v<std::remove_cvref_t<T>, std::string>
-    value(T&& v)
+    requires std::integral<std::remove_cvref_t<T>> || std::floating_point<std::remove_cvref_t<T>> || std::is_same_v<std::remove_cvref_t<T>, string_type>
+    basic_value(T&& v)
     noexcept : content(std::forward<T>(v)) {}
 
+    /**
+     * @brief JSON value constructor for "string" type from std::string (when string_type is another type)
+     * @param v A string value to be set.
+     */
+    template <typename T>
+    requires std::is_same_v<std::remove_cvref_t<T>, std::string> && (!std::is_same_v<string_type, std::string>)
+    basic_value(T&& v) : content(string_type(v.data(), v.size())) {}
+
     /**
      * @brief JSON value constructor for "string" type.
      * @param string A string value to be set.
      */
-    value(const char* pchar) : content(std::string(pchar)) {}
+    basic_value(const char* pchar) : content(string_type(pchar)) {}
     // accept utf8 literal (u8"fooあ123") without type casting on the caller site.
-    value(const char8_t* pchar) : content(std::string((const char*)pchar)) {}
+    basic_value(const char8_t* pchar) : content(string_type((const char*)pchar)) {}
 
-    value(std::string_view sv) : content(std::string(sv)) {}
+    basic_value(std::string_view sv) : content(string_type(sv.data(), sv.size())) {}
 
     /**
      * @brief JSON value constructor for "array" type.
      * @param array An initializer list of elements.
      */
-    explicit value(std::initializer_list<value> array) : content(std::move(array)) {}
+    explicit basic_value(std::initializer_list<basic_value> array) : content(std::move(array)) {}
 
     /**
      * @brief JSON value constructor with key,value pair for "object" type.
      * @param elements An initializer list of key,value pair.
      */
-    explicit value(std::initializer_list<pair_type> elements) : content(std::move(elements)) {}
+    explicit basic_value(std::initializer_list<pair_type> elements) : content(std::move(elements)) {}
+
+    /**
+     * @brief JSON value constructor for "array" type from a container (ex: one with an allocator).
+     * @param elements A container of elements to be moved.
+     */
+    explicit basic_value(array_type&& elements) : content(std::move(elements)) {}
 
-    friend value array(std::initializer_list<value> elements);
-    friend value object(std::initializer_list<pair_type> elements);
+    /**
+     * @brief JSON value constructor for "object" type from a container (ex: one with an allocator).
+     * @param elements A container of key,value pairs to be moved.
+     */
+    explicit basic_value(object_type&& elements) : content(std::move(elements)) {}
 
     // reset value to null
     void reset()
@@ -296,7 +464,7 @@ public:
     /**
      * @brief Check if type of stored value is string.
      */
-    constexpr bool is_string() const noexcept { return std::holds_alternative<std::string>(content); }
+    constexpr bool is_string() const noexcept { return std::holds_alternative<string_type>(content); }
 
     /**
      * @brief Check if type of stored value is array.
@@ -385,10 +553,10 @@ public:
      *
      * @throws std::bad_cast if the value is not a string
      */
-    const std::string& as_string() const
+    const string_type& as_string() const
     {
         if (!is_string()) throw std::bad_cast();
-        return std::get<std::string>(content);
+        return std::get<string_type>(content);
     }
 
     /**
@@ -399,7 +567,7 @@ public:
     string_type& as_string()
     {
         if (!is_string()) throw std::bad_cast();
-        return std::get<std::string>(content);
+        return std::get<string_type>(content);
     }
 
     /**
@@ -450,7 +618,7 @@ public:
     /*================================================================================
      * Array indexer
      */
-    const value& at(const int index, const value& default_value) const
+    const basic_value& at(const int index, const basic_value& default_value) const
     {
         if (is_array()) {
             const auto& ar = std::get<array_type>(content);
@@ -461,33 +629,33 @@ public:
         return default_value;
     }
 
-    const value& at(const int index) const
+    const basic_value& at(const int index) const
     {
-        static const value null;
+        static const basic_value null;
         return at(index, null);
     }
 
-    const value& operator[](const int index) const
+    const basic_value& operator[](const int index) const
     {
         return at(index);
     }
 
     //***** Array modifiers *****
-    value& at(const int index)
+    basic_value& at(const int index)
     {
         assert(is_array());
         auto& ar = std::get<array_type>(content);
         return ar.at(index);
     }
 
-    inline value& operator[](const int index)
+    inline basic_value& operator[](const int index)
     {
         return at(index);
     }
 
     // adds a value to the array
     template <typename T>
-    value& append(T&& v)
+    basic_value& append(T&& v)
     {
         assert(is_array());
         auto& ar = std::get<array_type>(content);
@@ -498,7 +666,7 @@ public:
     /*================================================================================
      * Object indexer
      */
-    const value& at(const string_type& key, const value& default_value) const
+    const basic_value& at(const string_type& key, const basic_value& default_value) const
     {
         if (is_object()) {
             const auto& obj = std::get<object_type>(content);
@@ -510,46 +678,46 @@ public:
         return default_value;
     }
 
-    const value& at(const string_type& key) const
+    const basic_value& at(const string_type& key) const
     {
-        static const value null;
+        static const basic_value null;
         return at(key, null);
     }
 
-    const value& operator[](const string_type& key) const
+    const basic_value& operator[](const string_type& key) const
     {
         return at(key);
     }
 
-    const value& at(const string_p_type key, const value& default_value) const
+    const basic_value& at(const string_p_type key, const basic_value& default_value) const
     {
         return at(string_type(key), default_value);
     }
 
-    const value& at(const string_p_type key) const
+    const basic_value& at(const string_p_type key) const
     {
         return at(string_type(key));
     }
 
-    const value& operator[](const string_p_type key) const
+    const basic_value& operator[](const string_p_type key) const
     {
         return at(string_type(key));
     }
 
     //***** Object modifiers *****
-    value& at(const string_type& key)
+    basic_value& at(const string_type& key)
     {
         assert(is_object());
         auto& obj = std::get<object_type>(content);
         return obj[key];
     }
 
-    inline value& operator[](const string_p_type key)
+    inline basic_value& operator[](const string_p_type key)
     {
         return at(string_type(key));
     }
 
-    inline value& operator[](const string_type& key)
+    inline basic_value& operator[](const string_type& key)
     {
         return at(key);
     }
@@ -632,7 +800,7 @@ public:
                     else if constexpr (!auto_conversion)
                         throw std::bad_cast();
                     else {                                              // auto-conversion: ON
-                        if constexpr (std::is_same_v<R, std::string>) { // null => string
+                        if constexpr (impl::any_of_types_v<R, std::string, string_type>) { // null => string
                             result = "null";
                         } else if constexpr (std::is_same_v<R, bool>) { // null => boolean
                             result = false;
@@ -641,7 +809,7 @@ public:
                         }
                     }
                 } else if constexpr (std::is_same_v<R, bool>) { // to boolean
-                    if constexpr (std::is_same_v<value_t, std::string>) {
+                    if constexpr (std::is_same_v<value_t, string_type>) {
                         if constexpr (auto_conversion)
                             result = (v == "true");
                         else
@@ -650,43 +818,44 @@ public:
                         result = (v != 0);
                     }
                 } else if constexpr (std::is_integral_v<R> || std::is_floating_point_v<R>) { // to number
-                    if constexpr (std::is_same_v<value_t, std::string>) {                    // string => number
+                    if constexpr (std::is_same_v<value_t, string_type>) {                    // string => number
                         if constexpr (!auto_conversion)
                             throw std::bad_cast();
                         else {
+                            decltype(auto) s = impl::convert_string<std::string>(v);
                             if constexpr (std::is_floating_point_v<R>) {
                                 if constexpr (std::is_same_v<R, float>)
-                                    result = std::stof(v); // string => float
+                                    result = std::stof(s); // string => float
                                 else
-                                    result = static_cast<R>(std::stod(v)); // string => double
+                                    result = static_cast<R>(std::stod(s)); // string => double
                             } else {
                                 if constexpr (std::is_same_v<R, long>) // string => long
-                                    result = std::stol(v);
+                                    result = std::stol(s);
                                 else if constexpr (std::is_same_v<R, long long>) // string => long long
-                                    result = std::stoll(v);
+                                    result = std::stoll(s);
                                 else if constexpr (std::is_same_v<R, int>) // string => int
-                                    result = std::stoi(v);
+                                    result = std::stoi(s);
                                 else if constexpr (std::is_same_v<R, char>) // string => char
-                                    result = (char)std::stoi(v);            // be aware of the data loss!
+                                    result = (char)std::stoi(s);            // be aware of the data loss!
                                 else {
-                                    result = static_cast<R>(std::stol(v)); // possible data loss!
+                                    result = static_cast<R>(std::stol(s)); // possible data loss!
                                 }
                             }
                         }
                     } else { // number => number
                         result = static_cast<R>(v);
                     }
-                } else if constexpr (std::is_same_v<R, std::string>) { // to string
+                } else if constexpr (impl::any_of_types_v<R, std::string, string_type>) { // to string
                     if constexpr (std::is_same_v<value_t, bool>) {     // bool => string
                         if constexpr (auto_conversion)
                             result = v ? "true" : "false";
                         else
                             throw std::bad_cast();
-                    } else if constexpr (std::is_same_v<value_t, std::string>) { // string => string
-                        result = std::move(v);
+                    } else if constexpr (std::is_same_v<value_t, string_type>) { // string => string
+                        result = impl::convert_string<R>(v);
                     } else { // number => string
                         if constexpr (auto_conversion)
-                            result = std::to_string(v); // thanks to standard api for numberic conversion
+                            result = impl::convert_string<R>(std::to_string(v)); // thanks to standard api for numberic conversion
                         else
                             throw std::bad_cast();
                     }
@@ -724,7 +893,7 @@ public:
 
     // Explicit type convert:  (T)v == v.to<T>() == v.get<T, true>()
     template <typename T>
-    requires((!std::is_reference_v<T>)&&(std::integral<T> || std::floating_point<T> || std::is_same_v<T, std::string>)) constexpr operator T() const
+    requires((!std::is_reference_v<T>)&&(std::integral<T> || std::floating_point<T> || impl::any_of_types_v<T, std::string, string_type>)) constexpr operator T() const
     {
         return this->get<T, true>();
     }
@@ -820,7 +989,7 @@ public:
     }
 
     template <typename T>
-    constexpr friend void operator<<(T& t, const value& v)
+    requires(!impl::is_stringifier_v<T>) constexpr friend void operator<<(T& t, const basic_value& v)
     {
         v >> t;
     }
@@ -832,77 +1001,169 @@ public:
      * @return reference of current value object
      */
     template <typename T>
-    constexpr value& operator<<(T&& v)
+    constexpr basic_value& operator<<(T&& v)
     {
         (*this) = std::forward<T>(v);
         return *this;
     }
 
     //----------------------- Comparators ------------------------------------------
+    /**
+     * @brief Test equality
+     *
+     * Numbers are equal by value (1 == 1.0), strings by characters (literals
+     * and std::string_view are compared without copies). Values of different
+     * types are not equal.
+     */
     template <typename T>
-    constexpr friend bool operator==(const value& v, const T& w)
-    {
-        if constexpr (std::is_same_v<T, value>)
-            return v.content == w.content;
-        else if constexpr ((!std::is_same_v<T, std::string>)&&std::is_constructible_v<std::string, T>) {
-            return v == std::string(w);
-        } else
+    constexpr friend bool operator==(const basic_value& v, const T& w)
+    {
+        if constexpr (std::is_same_v<T, basic_value>) {
+            return v.equals(w);
+        } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            return v.is_null();
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return v.is_boolean() && (std::get<bool>(v.content) == w);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return v.is_number() && (v.compare_number(w) == 0);
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return v.is_string() && (v.string_view() == std::string_view(w));
+        } else {
             return v.get<T, false>() == w;
+        }
     }
 
+    /**
+     * @brief Three-way comparison (also provides <, <=, > and >=)
+     *
+     * Types are ordered as null < boolean < number < string < array < object.
+     * Numbers are ordered by value across integer and floating point types
+     * (NaN is unordered), strings by characters, arrays and objects
+     * lexicographically.
+     */
     template <typename T>
-    constexpr friend bool operator>(const value& v, const T& w)
-    {
-        if constexpr (std::is_same_v<T, value>)
-            return v.content > w.content;
-        else
-            return v.get<T, false>() > w;
-    }
-    template <typename T>
-    constexpr friend bool operator>=(const value& v, const T& w)
-    {
-        if constexpr (std::is_same_v<T, value>)
-            return v.content >= w.content;
-        else
-            return v.get<T, false>() >= w;
-    }
-    template <typename T>
-    constexpr friend bool operator<(const value& v, const T& w)
-    {
-        if constexpr (std::is_same_v<T, value>)
-            return v.content < w.content;
-        else
-            return v.get<T, false>() < w;
+    constexpr friend std::partial_ordering operator<=>(const basic_value& v, const T& w)
+    {
+        if constexpr (std::is_same_v<T, basic_value>) {
+            return v.compare(w);
+        } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            return v.type_rank() <=> 0;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return v.is_boolean() ? (std::get<bool>(v.content) <=> w) : (v.type_rank() <=> 1);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return v.is_number() ? v.compare_number(w) : (v.type_rank() <=> 2);
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return v.is_string() ? (v.string_view() <=> std::string_view(w)) : (v.type_rank() <=> 3);
+        } else {
+            return std::compare_partial_order_fallback(v.get<T, false>(), w);
+        }
     }
-    template <typename T>
-    constexpr friend bool operator<=(const value& v, const T& w)
+
+private:
+    /**
+     * @brief Get rank of type for ordering
+     *
+     * @return 0:null, 1:boolean, 2:number, 3:string, 4:array, 5:object
+     */
+    constexpr int type_rank() const noexcept
     {
-        if constexpr (std::is_same_v<T, value>)
-            return v.content <= w.content;
-        else
-            return v.get<T, false>() <= w;
+        constexpr int ranks[] = {0, 1, 2, 2, 2, 2, 2, 3, 4, 5};
+        return ranks[content.index()];
     }
 
-    template <typename T>
-    requires(!std::is_same_v<T, value>) constexpr friend bool operator>(const T& w, const value& v)
+    /**
+     * @brief View the stored string (must be a string)
+     */
+    std::string_view string_view() const noexcept
     {
-        return v < w;
+        const auto& s = std::get<string_type>(content);
+        return std::string_view(s.data(), s.size());
     }
-    template <typename T>
-    requires(!std::is_same_v<T, value>) constexpr friend bool operator>=(const T& w, const value& v)
+
+    /**
+     * @brief Compare the stored number (must be a number) with a number
+     */
+    template <typename N>
+    constexpr std::partial_ordering compare_number(N n) const
     {
-        return v <= w;
+        return std::visit(
+            [&](const auto& a) {
+                using A = std::decay_t<decltype(a)>;
+                if constexpr (impl::any_of_types_v<A, int, long, long long, float, double>) {
+                    return impl::compare_numbers(a, n);
+                } else {
+                    return std::partial_ordering::unordered;
+                }
+            },
+            content);
     }
-    template <typename T>
-    requires(!std::is_same_v<T, value>) constexpr friend bool operator<(const T& w, const value& v)
+
+    /**
+     * @brief Test equality with another value
+     */
+    bool equals(const basic_value& w) const
     {
-        return v > w;
+        if (type_rank() != w.type_rank()) {
+            return false;
+        }
+        switch (type_rank()) {
+        case 0:
+            return true;
+        case 1:
+            return std::get<bool>(content) == std::get<bool>(w.content);
+        case 2:
+            return compare(w) == 0;
+        case 3:
+            return string_view() == w.string_view();
+        case 4:
+            return std::get<array_type>(content) == std::get<array_type>(w.content);
+        default:
+            return std::get<object_type>(content) == std::get<object_type>(w.content);
+        }
     }
-    template <typename T>
-    requires(!std::is_same_v<T, value>) constexpr friend bool operator<=(const T& w, const value& v)
+
+    /**
+     * @brief Three-way comparison with another value
+     */
+    std::partial_ordering compare(const basic_value& w) const
     {
-        return v >= w;
+        if (type_rank() != w.type_rank()) {
+            return type_rank() <=> w.type_rank();
+        }
+        switch (type_rank()) {
+        case 0:
+            return std::partial_ordering::equivalent;
+        case 1:
+            return std::get<bool>(content) <=> std::get<bool>(w.content);
+        case 2:
+            return std::visit(
+                [&](const auto& n) {
+                    using N = std::decay_t<decltype(n)>;
+                    if constexpr (impl::any_of_types_v<N, int, long, long long, float, double>) {
+                        return compare_number(n);
+                    } else {
+                        return std::partial_ordering::unordered;
+                    }
+                },
+                w.content);
+        case 3:
+            return string_view() <=> w.string_view();
+        case 4: {
+            const auto& a = std::get<array_type>(content);
+            const auto& b = std::get<array_type>(w.content);
+            return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end(), [](const basic_value& x, const basic_value& y) { return x.compare(y); });
+        }
+        default: {
+            const auto& a = std::get<object_type>(content);
+            const auto& b = std::get<object_type>(w.content);
+            return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end(), [](const pair_type& x, const pair_type& y) {
+                const auto keys = std::string_view(x.first.data(), x.first.size()) <=> std::string_view(y.first.data(), y.first.size());
+                return (keys != 0) ? std::partial_ordering(keys) : x.second.compare(y.second);
+            });
+        }
+        }
     }
+
     /*================================================================================
      * Parse
      */
@@ -910,7 +1171,17 @@ private:
     template <impl::flags_type F>
     friend class impl::parser;
 
-    friend impl::parser<0> operator>>(std::istream& istream, value& v);
+    /**
+     * @brief Parse JSON from an input stream (with ECMA-404 standard rule)
+     *
+     * @param istream An input stream
+     * @param v A value to store parsed value
+     * @return A new parser (impl::parser<0>)
+     */
+    friend auto operator>>(std::istream& istream, basic_value& v)
+    {
+        return impl::parser<0>(istream) >> v;
+    }
 
     /*================================================================================
      * Stringify
@@ -918,7 +1189,20 @@ private:
     template <impl::flags_type F, impl::indent_type I>
     friend class impl::stringifier;
 
-    friend impl::stringifier<0, 0> operator<<(std::ostream& ostream, const value& v);
+    /**
+     * @brief Stringify JSON to an output stream (with ECMA-404 standard rule)
+     *
+     * @param ostream An output stream
+     * @param v A value to stringify
+     * @return A new stringifier (impl::stringifier<0, 0>)
+     */
+    friend auto operator<<(std::ostream& ostream, const basic_value& v)
+    {
+        return impl::stringifier<0, 0>(ostream) << v;
+    }
+
+    template <impl::flags_type F, impl::indent_type I>
+    friend class impl::pull_stringifier;
 
     std::variant<
         std::monostate,
@@ -928,7 +1212,7 @@ private:
         long long,
         float,
         double,
-        std::string,
+        string_type,
         array_type,
         object_type>
         content;
@@ -937,27 +1221,172 @@ private:
 /**
  * @brief Make JSON array
  *
+ * @tparam V A value type (ex: array<basic_value<my_traits>>({...}))
  * @param elements An initializer list of elements
  * @return JSON value object
  */
-inline value array(std::initializer_list<value> elements = {})
+template <class V = value>
+V array(std::initializer_list<std::type_identity_t<V>> elements = {})
 {
-    return value(std::move(elements));
+    return V(std::move(elements));
 }
 
 /**
  * @brief Make JSON object
  *
+ * @tparam V A value type (ex: object<basic_value<my_traits>>({...}))
+ * @param elements An initializer list of key:value pairs
+ * @return JSON value object
+ */
+template <class V = value>
+V object(std::initializer_list<typename V::pair_type> elements = {})
+{
+    return V(std::move(elements));
+}
+
+/**
+ * @brief Make JSON array which allocates from a memory resource
+ *
+ * Elements are copied as they are (their strings and containers keep
+ * their allocators).
+ *
+ * @tparam V A value type with pmr storage types (other types ignore the resource)
+ * @param elements An initializer list of elements
+ * @param resource A memory resource for the array
+ * @return JSON value object
+ */
+template <class V = value>
+V array(std::initializer_list<std::type_identity_t<V>> elements, std::pmr::memory_resource* resource)
+{
+    auto a = impl::make_storage<typename V::array_type>(resource);
+    a.insert(a.end(), elements.begin(), elements.end());
+    return V(std::move(a));
+}
+
+/**
+ * @brief Make empty JSON array which allocates from a memory resource
+ */
+template <class V = value>
+V array(std::pmr::memory_resource* resource)
+{
+    return V(impl::make_storage<typename V::array_type>(resource));
+}
+
+/**
+ * @brief Make JSON object which allocates from a memory resource
+ *
+ * Keys are copied into the resource (if the object type passes its
+ * allocator to keys, as std::pmr containers do); values are copied as they are.
+ *
+ * @tparam V A value type with pmr storage types (other types ignore the resource)
  * @param elements An initializer list of key:value pairs
+ * @param resource A memory resource for the object
  * @return JSON value object
  */
-inline value object(std::initializer_list<value::pair_type> elements = {})
+template <class V = value>
+V object(std::initializer_list<typename V::pair_type> elements, std::pmr::memory_resource* resource)
+{
+    auto o = impl::make_storage<typename V::object_type>(resource);
+    o.insert(elements.begin(), elements.end());
+    return V(std::move(o));
+}
+
+/**
+ * @brief Make empty JSON object which allocates from a memory resource
+ */
+template <class V = value>
+V object(std::pmr::memory_resource* resource)
 {
-    return value(std::move(elements));
+    return V(impl::make_storage<typename V::object_type>(resource));
 }
 
 namespace impl {
 
+/**
+ * @brief Character classes of the lexer
+ *
+ * Low 3 bits hold the token which starts with the character (at the
+ * beginning of a value); other bits are character classes.
+ */
+namespace char_class {
+enum : std::uint8_t {
+    token_mask = 0x07,
+    token_invalid = 0, ///< Not a value
+    token_object = 1,  ///< '{'
+    token_array = 2,   ///< '['
+    token_string = 3,  ///< '"', '\''
+    token_null = 4,    ///< 'n'
+    token_boolean = 5, ///< 't', 'f'
+    token_number = 6,  ///< [0-9], '-', '+', '.', 'i', 'N'
+
+    space = 0x08,       ///< Whitespace
+    comment = 0x10,     ///< '/' (only if comments are enabled)
+    digit = 0x20,       ///< [0-9]
+    ident_start = 0x40, ///< [A-Za-z_$] (only if unquoted keys are enabled)
+};
+} /* namespace char_class */
+
+/**
+ * @brief Make a character class table for a parser
+ *
+ * @param f A combination of flags
+ * @return A table indexed by (character code + 1), so that EOF (-1) is index 0
+ */
+constexpr std::array<std::uint8_t, 257> make_char_classes(flags_type f)
+{
+    std::array<std::uint8_t, 257> table{};
+    auto set = [&](int ch, std::uint8_t bits) { table[static_cast<std::size_t>(ch + 1)] |= bits; };
+    for (const int ch : {'\t', '\n', '\r', ' '}) {
+        set(ch, char_class::space);
+    }
+    if (f & (flags::single_line_comment | flags::multi_line_comment)) {
+        set('/', char_class::comment);
+    }
+    for (int ch = '0'; ch <= '9'; ++ch) {
+        set(ch, char_class::digit | char_class::token_number);
+    }
+    for (const int ch : {'-', '+', '.', 'i', 'N'}) {
+        set(ch, char_class::token_number);
+    }
+    set('{', char_class::token_object);
+    set('[', char_class::token_array);
+    set('"', char_class::token_string);
+    set('\'', char_class::token_string);
+    set('n', char_class::token_null);
+    set('t', char_class::token_boolean);
+    set('f', char_class::token_boolean);
+    if (f & flags::unquoted_key) {
+        for (int ch = 'A'; ch <= 'Z'; ++ch) {
+            set(ch, char_class::ident_start);
+            set(ch + ('a' - 'A'), char_class::ident_start);
+        }
+        set('_', char_class::ident_start);
+        set('$', char_class::ident_start);
+    }
+    return table;
+}
+
+/**
+ * @brief Make a table of hexadecimal digit values
+ *
+ * @return A table indexed by (character code + 1), -1 for non-hexadecimal characters
+ */
+constexpr std::array<std::int8_t, 257> make_hex_values()
+{
+    std::array<std::int8_t, 257> table{};
+    for (auto& n : table) {
+        n = -1;
+    }
+    for (int i = 0; i < 10; ++i) {
+        table['0' + i + 1] = static_cast<std::int8_t>(i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        table['A' + i + 1] = static_cast<std::int8_t>(10 + i);
+        table['a' + i + 1] = static_cast<std::int8_t>(10 + i);
+    }
+    return table;
+}
+
 /**
  * @brief Parser implementation
  *
@@ -969,14 +1398,17 @@ class parser
 private:
     using self_type = parser<F>;
     static constexpr auto M = flags::parse_mask;
+    static constexpr auto char_classes = make_char_classes(F); ///< Character classes for this flag set
+    static constexpr auto hex_values = make_hex_values();       ///< Hexadecimal digit values
 
 public:
     /**
      * @brief Construct a new parser object
      *
      * @param istream An input stream
+     * @param resource A memory resource for strings and containers of pmr storage types (nullptr for the default allocators)
      */
-    parser(std::istream& istream) : istream(istream) {}
+    parser(std::istream& istream, std::pmr::memory_resource* resource = nullptr) : istream(istream), resource(resource) {}
 
     /**
      * @brief Apply flag manipulator
@@ -989,7 +1421,7 @@ public:
     template <flags_type S, flags_type C>
     parser<((F & ~C) | S) & M> operator>>(const manipulator_flags<S, C>& manip)
     {
-        return parser<((F & ~C) | S) & M>(istream);
+        return parser<((F & ~C) | S) & M>(istream, resource);
     }
 
     /**
@@ -1032,10 +1464,12 @@ public:
     /**
      * @brief Parse JSON
      *
+     * @tparam Traits Storage types of value
      * @param v A value object to store parsed value
      * @return A reference to self
      */
-    self_type& operator>>(value& v)
+    template <class Traits>
+    self_type& operator>>(basic_value<Traits>& v)
     {
         do_parse(v);
         return *this;
@@ -1064,52 +1498,57 @@ private:
         for (;;) {
             int ch = istream.get();
         reeval_space:
-            switch (ch) {
-            case '\t':
-            case '\n':
-            case '\r':
-            case ' ':
+            const auto cc = classify(ch);
+            if (cc & char_class::space) {
                 continue;
-            case '/':
-                if (has_flag(flags::single_line_comment | flags::multi_line_comment)) {
-                    ch = istream.get();
-                    if (has_flag(flags::single_line_comment) && (ch == '/')) {
-                        // [single_line_comment] (JSON5)
-                        for (;;) {
-                            ch = istream.get();
-                            if ((ch == std::char_traits<char>::eof()) || (ch == '\r') || (ch == '\n')) {
-                                break;
-                            }
+            }
+            if (cc & char_class::comment) {
+                ch = istream.get();
+                if (has_flag(flags::single_line_comment) && (ch == '/')) {
+                    // [single_line_comment] (JSON5)
+                    for (;;) {
+                        ch = istream.get();
+                        if ((ch == std::char_traits<char>::eof()) || (ch == '\r') || (ch == '\n')) {
+                            break;
                         }
-                        goto reeval_space;
-                    } else if (has_flag(flags::multi_line_comment) && (ch == '*')) {
-                        // [multi_line_comment] (JSON5)
-                        for (;;) {
-                            ch = istream.get();
-                        reeval_asterisk:
-                            if (ch == std::char_traits<char>::eof()) {
-                                throw syntax_error(ch, "comment");
-                            }
-                            if (ch != '*') {
-                                continue;
-                            }
-                            ch = istream.get();
-                            if (ch == '*') {
-                                goto reeval_asterisk;
-                            }
-                            if (ch == '/') {
-                                break;
-                            }
+                    }
+                    goto reeval_space;
+                } else if (has_flag(flags::multi_line_comment) && (ch == '*')) {
+                    // [multi_line_comment] (JSON5)
+                    for (;;) {
+                        ch = istream.get();
+                    reeval_asterisk:
+                        if (ch == std::char_traits<char>::eof()) {
+                            throw syntax_error(ch, "comment");
+                        }
+                        if (ch != '*') {
+                            continue;
+                        }
+                        ch = istream.get();
+                        if (ch == '*') {
+                            goto reeval_asterisk;
+                        }
+                        if (ch == '/') {
+                            break;
                         }
-                        continue;
                     }
-                    // no valid comments
+                    continue;
                 }
-                /* no-break */
-            default:
-                return ch;
-            } /* switch(ch) */
-        }     /* for(;;) */
+                // no valid comments
+            }
+            return ch;
+        } /* for(;;) */
+    }
+
+    /**
+     * @brief Get character classes of a character
+     *
+     * @param ch Character code (or EOF)
+     * @return A combination of char_class values
+     */
+    static std::uint8_t classify(int ch)
+    {
+        return char_classes[static_cast<std::size_t>(ch + 1)];
     }
 
     /**
@@ -1121,7 +1560,7 @@ private:
      */
     static bool is_digit(int ch)
     {
-        return (('0' <= ch) && (ch <= '9'));
+        return (classify(ch) & char_class::digit) != 0;
     }
 
     /**
@@ -1143,26 +1582,7 @@ private:
      */
     static int to_number_hex(int ch)
     {
-        if (is_digit(ch)) {
-            return to_number(ch);
-        } else if (('A' <= ch) && (ch <= 'F')) {
-            return ch - 'A' + 10;
-        } else if (('a' <= ch) && (ch <= 'f')) {
-            return ch - 'a' + 10;
-        }
-        return -1;
-    }
-
-    /**
-     * @brief Check if a character is an alphabet
-     *
-     * @param ch
-     * @return true
-     * @return false
-     */
-    static bool is_alpha(int ch)
-    {
-        return (('A' <= ch) && (ch <= 'Z')) || (('a' <= ch) && (ch <= 'z'));
+        return hex_values[static_cast<std::size_t>(ch + 1)];
     }
 
     /**
@@ -1188,9 +1608,11 @@ private:
     /**
      * @brief Parser entry
      *
+     * @tparam V A typename of value
      * @param v A value object to store parsed value
      */
-    void do_parse(value& v)
+    template <class V>
+    void do_parse(V& v)
     {
         static const char context[] = "value";
         parse_value(v, context);
@@ -1208,35 +1630,32 @@ private:
      * @param v A value object to store parsed value
      * @param context A description of context
      */
-    void parse_value(value& v, const char* context)
+    template <class V>
+    void parse_value(V& v, const char* context)
     {
         int ch = skip_spaces();
 
         // [value]
-        switch (ch) {
-        case '{':
+        switch (classify(ch) & char_class::token_mask) {
+        case char_class::token_object:
             // [object]
             return parse_object(v);
-        case '[':
+        case char_class::token_array:
             // [array]
             return parse_array(v);
-        case '"':
-        case '\'':
+        case char_class::token_string:
             // [string]
             return parse_string(v, ch);
-        case 'n':
+        case char_class::token_null:
             // ["null"]?
             return parse_null(v);
-        case 't':
-        case 'f':
+        case char_class::token_boolean:
             // ["true"] or ["false"]?
             return parse_boolean(v, ch);
+        case char_class::token_number:
+            // [number]?
+            return parse_number(v, ch);
         default:
-            if (is_digit(ch) || (ch == '-') || (ch == '+') ||
-                (ch == '.') || (ch == 'i') || (ch == 'N')) {
-                // [number]?
-                return parse_number(v, ch);
-            }
             throw syntax_error(ch, context);
         }
     }
@@ -1246,7 +1665,8 @@ private:
      *
      * @param v A value object to store parsed value
      */
-    void parse_null(value& v)
+    template <class V>
+    void parse_null(V& v)
     {
         static const char context[] = "null";
         int ch;
@@ -1263,7 +1683,8 @@ private:
      * @param v A value object to store parsed value
      * @param ch The first character
      */
-    void parse_boolean(value& v, int ch)
+    template <class V>
+    void parse_boolean(V& v, int ch)
     {
         static const char context[] = "boolean";
         if (ch == 't') {
@@ -1286,7 +1707,8 @@ private:
      * @param v A value object to store parsed value
      * @param ch The first character
      */
-    void parse_number(value& v, int ch)
+    template <class V>
+    void parse_number(V& v, int ch)
     {
         static const char context[] = "number";
         long long int_part = 0;
@@ -1324,7 +1746,7 @@ private:
                     if (no_digit) {
                         throw syntax_error(ch, context);
                     }
-                    v = negative ? (double)(-(long long)int_part) : (double)int_part;
+                    v = negative ? (typename V::number_type)(-(long long)int_part) : (typename V::number_type)int_part;
                     return;
                 }
                 break;
@@ -1342,13 +1764,13 @@ private:
             } else if (has_flag(flags::infinity_number) && (ch == 'i')) {
                 // ["infinity"] (JSON5)
                 if (equals(ch, 'n', 'f', 'i', 'n', 'i', 't', 'y')) {
-                    v = negative ? -std::numeric_limits<value::number_type>::infinity() : +std::numeric_limits<value::number_type>::infinity();
+                    v = negative ? -std::numeric_limits<typename V::number_type>::infinity() : +std::numeric_limits<typename V::number_type>::infinity();
                     return;
                 }
             } else if (has_flag(flags::not_a_number) && (ch == 'N')) {
                 // ["NaN"] (JSON5)
                 if (equals(ch, 'a', 'N')) {
-                    v = std::numeric_limits<value::number_type>::quiet_NaN();
+                    v = std::numeric_limits<typename V::number_type>::quiet_NaN();
                     return;
                 }
             }
@@ -1387,13 +1809,13 @@ private:
         istream.unget();
         if ((frac_part == 0) && (exp_part == 0)) {
             if (negative) {
-                const auto integer_value = static_cast<value::integer_type>(-int_part);
+                const auto integer_value = static_cast<typename V::integer_type>(-int_part);
                 if (static_cast<decltype(int_part)>(integer_value) == -int_part) {
                     v = integer_value;
                     return;
                 }
             } else {
-                const auto integer_value = static_cast<value::integer_type>(int_part);
+                const auto integer_value = static_cast<typename V::integer_type>(int_part);
                 if (static_cast<decltype(int_part)>(integer_value) == int_part) {
                     v = integer_value;
                     return;
@@ -1407,17 +1829,19 @@ private:
         if (exp_part > 0) {
             number_value *= std::pow(10, exp_negative ? -exp_part : +exp_part);
         }
-        v = negative ? -number_value : +number_value;
+        v = static_cast<typename V::number_type>(negative ? -number_value : +number_value);
     }
 
     /**
      * @brief Parse string
      *
+     * @tparam S A typename of string
      * @param buffer A buffer to store string
      * @param quote The first quote character
      * @param context A description of context
      */
-    void parse_string(std::string& buffer, int quote, const char* context)
+    template <class S>
+    void parse_string(S& buffer, int quote, const char* context)
     {
         if (!((quote == '"') || (has_flag(flags::single_quote) && quote == '\''))) {
             throw syntax_error(quote, context);
@@ -1509,10 +1933,11 @@ private:
      * @param v A value object to store parsed value
      * @param quote The first quote character
      */
-    void parse_string(value& v, int quote)
+    template <class V>
+    void parse_string(V& v, int quote)
     {
         static const char context[] = "string";
-        v = "";
+        v = make_storage<typename V::string_type>(resource);
         parse_string(v.as_string(), quote, context);
     }
 
@@ -1521,10 +1946,11 @@ private:
      *
      * @param v A value object to store parsed value
      */
-    void parse_array(value& v)
+    template <class V>
+    void parse_array(V& v)
     {
         static const char context[] = "array";
-        v = array({});
+        v = V(make_storage<typename V::array_type>(resource));
         auto& elements = v.as_array();
         for (;;) {
             int ch = skip_spaces();
@@ -1561,9 +1987,10 @@ private:
         if (has_flag(flags::unquoted_key)) {
             if ((ch != '"') && (ch != '\'')) {
                 for (;; ch = istream.get()) {
-                    if ((ch == '_') || (ch == '$') || (is_alpha(ch))) {
+                    const auto cc = classify(ch);
+                    if (cc & char_class::ident_start) {
                         // [IdentifierStart]
-                    } else if (is_digit(ch) && (!buffer.empty())) {
+                    } else if ((cc & char_class::digit) && (!buffer.empty())) {
                         // [UnicodeDigit]
                     } else if (ch == ':') {
                         break;
@@ -1585,10 +2012,11 @@ private:
      *
      * @param v A value object to store parsed value
      */
-    void parse_object(value& v)
+    template <class V>
+    void parse_object(V& v)
     {
         static const char context[] = "object";
-        v = object({});
+        v = V(make_storage<typename V::object_type>(resource));
         auto& elements = v.as_object();
         for (;;) {
             int ch = skip_spaces();
@@ -1614,61 +2042,210 @@ private:
                 throw syntax_error(ch, context);
             }
             // [value]
-            auto result = elements.emplace(key, nullptr);
+            auto name = make_storage<typename V::string_type>(resource);
+            name.assign(key.data(), key.size());
+            auto result = elements.emplace(std::move(name), nullptr);
             parse_value(result.first->second, context);
         }
     }
 
-    std::istream& istream; ///< An input stream
+    friend class json5pp::record_reader;
+    friend class json5pp::pull_parser;
+
+    std::istream& istream;                 ///< An input stream
+    std::pmr::memory_resource* resource;   ///< A memory resource for strings and containers (nullptr for the default allocators)
 };
 
 /**
- * @brief Stringifier implementation
+ * @brief Member filter applied by the stringifier (see json5pp/redact.hpp)
  *
- * @tparam F A combination of flags
- * @tparam I An indent specification
+ * For each member of objects (and each element of arrays), the stringifier
+ * calls enter() with its key (or decimal index), writes the member as
+ * the returned action says, then calls leave().
  */
-template <flags_type F, indent_type I>
-class stringifier
+class member_filter
 {
-private:
-    using self_type = stringifier<F, I>;
-    static constexpr auto M = flags::stringify_mask;
-
 public:
     /**
-     * @brief Construct a new stringifier object
-     *
-     * @param ostream An output stream
+     * @brief What to do with a member
      */
-    stringifier(std::ostream& ostream) : ostream(ostream) {}
+    enum class action : std::uint8_t {
+        keep,     ///< Write the member as is (its members are filtered)
+        omit,     ///< Leave out the member
+        mask,     ///< Write mask_text() as a string instead of the value
+        truncate, ///< Write strings cut to truncate_length() bytes
+    };
 
     /**
-     * @brief Apply flag manipulator
+     * @brief Enter a member
      *
-     * @tparam S Flags to be set
-     * @tparam C Flags to be cleared
-     * @param manip A manipulator
-     * @return An updated stringifier object
+     * @param key A key of the member (decimal index for array elements)
+     * @return An action for the member
      */
-    template <flags_type S, flags_type C>
-    stringifier<((F & ~C) | S) & M, I> operator<<(const manipulator_flags<S, C>& manip)
-    {
-        return stringifier<((F & ~C) | S) & M, I>(ostream);
-    }
+    virtual action enter(std::string_view key) = 0;
 
     /**
-     * @brief Apply indent manipulator
-     *
-     * @tparam NI A new indent specification
-     * @param manip A manipulator
-     * @return stringifier<F,NI>
-     * @return An updated stringifier object
+     * @brief Leave the member entered last
+     */
+    virtual void leave() = 0;
+
+    /**
+     * @brief Get the text written for masked members
+     */
+    virtual std::string_view mask_text() const = 0;
+
+    /**
+     * @brief Get the length limit of the member entered last (for action::truncate)
+     */
+    virtual std::size_t truncate_length() const = 0;
+
+protected:
+    ~member_filter() = default;
+};
+
+/**
+ * @brief Output adapter to collect escaped text into a string
+ */
+struct string_sink {
+    std::string& buffer;
+    void write(const char* p, std::streamsize n) { buffer.append(p, static_cast<std::size_t>(n)); }
+};
+
+/**
+ * @brief Test if any character needs escape in a JSON string
+ *
+ * @param data A pointer to characters
+ * @param size A number of characters
+ */
+inline bool needs_escape(const char* data, std::size_t size) noexcept
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto ch = (unsigned char)data[i];
+        if ((ch < ' ') || (ch == '"') || (ch == '\\')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Escape characters (without quotes) and write them to a sink
+ *
+ * Characters which need no escape are written in runs, not one by one.
+ *
+ * @tparam S A typename of sink (std::ostream or string_sink)
+ * @param data A pointer to characters to be escaped
+ * @param size A number of characters
+ * @param sink A sink to write to
+ */
+template <class S>
+void escape_chars(const char* data, std::size_t size, S& sink)
+{
+    static const char hex[] = "0123456789abcdef";
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto ch = (unsigned char)data[i];
+        const char* escaped;
+        char unicode[6];
+        switch (ch) {
+        case '"':
+            escaped = "\\\"";
+            break;
+        case '\\':
+            escaped = "\\\\";
+            break;
+        case '\b':
+            escaped = "\\b";
+            break;
+        case '\f':
+            escaped = "\\f";
+            break;
+        case '\n':
+            escaped = "\\n";
+            break;
+        case '\r':
+            escaped = "\\r";
+            break;
+        case '\t':
+            escaped = "\\t";
+            break;
+        default:
+            if (ch >= ' ') {
+                continue;
+            }
+            unicode[0] = '\\';
+            unicode[1] = 'u';
+            unicode[2] = '0';
+            unicode[3] = '0';
+            unicode[4] = hex[(ch >> 4) & 0xf];
+            unicode[5] = hex[ch & 0xf];
+            sink.write(data + run, static_cast<std::streamsize>(i - run));
+            sink.write(unicode, 6);
+            run = i + 1;
+            continue;
+        }
+        sink.write(data + run, static_cast<std::streamsize>(i - run));
+        sink.write(escaped, 2);
+        run = i + 1;
+    }
+    sink.write(data + run, static_cast<std::streamsize>(size - run));
+}
+
+/**
+ * @brief Stringifier implementation
+ *
+ * @tparam F A combination of flags
+ * @tparam I An indent specification
+ */
+template <flags_type F, indent_type I>
+class stringifier
+{
+private:
+    using self_type = stringifier<F, I>;
+    static constexpr auto M = flags::stringify_mask;
+
+public:
+    /**
+     * @brief Construct a new stringifier object
+     *
+     * @param ostream An output stream
+     */
+    stringifier(std::ostream& ostream) : ostream(ostream) {}
+
+    /**
+     * @brief Construct a new stringifier object with a member filter
+     *
+     * @param ostream An output stream
+     * @param filter A member filter (nullptr to write all members)
+     */
+    stringifier(std::ostream& ostream, member_filter* filter) : ostream(ostream), filter(filter) {}
+
+    /**
+     * @brief Apply flag manipulator
+     *
+     * @tparam S Flags to be set
+     * @tparam C Flags to be cleared
+     * @param manip A manipulator
+     * @return An updated stringifier object
+     */
+    template <flags_type S, flags_type C>
+    stringifier<((F & ~C) | S) & M, I> operator<<(const manipulator_flags<S, C>& manip)
+    {
+        return stringifier<((F & ~C) | S) & M, I>(ostream, filter);
+    }
+
+    /**
+     * @brief Apply indent manipulator
+     *
+     * @tparam NI A new indent specification
+     * @param manip A manipulator
+     * @return stringifier<F,NI>
+     * @return An updated stringifier object
      */
     template <indent_type NI>
     stringifier<F, NI> operator<<(const manipulator_indent<NI>& manip)
     {
-        return stringifier<F, NI>(ostream);
+        return stringifier<F, NI>(ostream, filter);
     }
 
     /**
@@ -1698,10 +2275,12 @@ public:
     /**
      * @brief Stringify JSON
      *
+     * @tparam Traits Storage types of value
      * @param v A value object to stringify
      * @return A reference to self
      */
-    self_type& operator<<(const value& v)
+    template <class Traits>
+    self_type& operator<<(const basic_value<Traits>& v)
     {
         do_stringify(v);
         return *this;
@@ -1735,23 +2314,24 @@ private:
      *
      * @return An indent text for one level
      */
-    static value::json_type get_indent()
+    static std::string get_indent()
     {
         if (I > 0) {
-            return value::json_type(I, ' ');
+            return std::string(I, ' ');
         } else if (I < 0) {
-            return value::json_type(-I, '\t');
+            return std::string(-I, '\t');
         }
-        return value::json_type();
+        return std::string();
     }
 
     /**
      * @brief Stringifier entry
      *
+     * @tparam V A typename of value
      * @param v A value object to stringify
-     * @param indent An indent string
      */
-    void do_stringify(const value& v)
+    template <class V>
+    void do_stringify(const V& v)
     {
         class fmtsaver
         {
@@ -1778,10 +2358,12 @@ private:
     /**
      * @brief Stringify value
      *
+     * @tparam V A typename of value
      * @param v A value object to stringify
      * @param indent An indent string
      */
-    void stringify_value(const value& v, const value::json_type& indent)
+    template <class V>
+    void stringify_value(const V& v, const std::string& indent)
     {
         std::visit(([&](auto&& arg) {
                        using T = std::decay_t<decltype(arg)>;
@@ -1812,17 +2394,18 @@ private:
                                }
                            }
                            ostream << arg;
-                       } else if constexpr (std::is_same_v<T, std::string>) {
-                           stringify_string(std::get<std::string>(v.content));
-                       } else if constexpr (std::is_same_v<T, value::object_type>) {
+                       } else if constexpr (std::is_same_v<T, typename V::string_type>) {
+                           stringify_string(arg);
+                       } else if constexpr (std::is_same_v<T, typename V::object_type>) {
                            if (arg.empty()) {
                                ostream << "{}";
+                           } else if (filter) {
+                               stringify_filtered(arg, indent);
                            } else if (I == 0) {
                                const char* delim = "{";
                                for (const auto& pair : arg) {
                                    ostream << delim;
-                                   stringify_string(pair.first);
-                                   ostream << ":";
+                                   stringify_key(pair.first);
                                    stringify_value(pair.second, indent);
                                    delim = ",";
                                }
@@ -1830,19 +2413,20 @@ private:
                            } else {
                                const char* const newline = get_newline();
                                const char* delim = "{";
-                               const value::json_type inner_indent = indent + get_indent();
+                               const std::string inner_indent = indent + get_indent();
                                for (const auto& pair : arg) {
                                    ostream << delim << newline << inner_indent;
-                                   stringify_string(pair.first);
-                                   ostream << ": ";
+                                   stringify_key(pair.first);
                                    stringify_value(pair.second, inner_indent);
                                    delim = ",";
                                }
                                ostream << newline << indent << "}";
                            }
-                       } else if constexpr (std::is_same_v<T, value::array_type>) {
+                       } else if constexpr (std::is_same_v<T, typename V::array_type>) {
                            if (arg.empty()) {
                                ostream << "[]";
+                           } else if (filter) {
+                               stringify_filtered(arg, indent);
                            } else if (I == 0) {
                                const char* delim = "[";
                                for (const auto& item : arg) {
@@ -1854,7 +2438,7 @@ private:
                            } else {
                                const char* const newline = get_newline();
                                const char* delim = "[";
-                               const value::json_type inner_indent = indent + get_indent();
+                               const std::string inner_indent = indent + get_indent();
                                for (const auto& item : arg) {
                                    ostream << delim << newline << inner_indent;
                                    stringify_value(item, inner_indent);
@@ -1870,54 +2454,422 @@ private:
                    v.content);
     }
 
+    /**
+     * @brief Stringify an object or an array through the member filter
+     *
+     * @tparam C A typename of object or array
+     * @param members An object or an array (not empty)
+     * @param indent An indent string
+     */
+    template <class C>
+    void stringify_filtered(const C& members, const std::string& indent)
+    {
+        constexpr bool is_object = requires { typename C::mapped_type; };
+        const char open = is_object ? '{' : '[';
+        const char close = is_object ? '}' : ']';
+        const std::string inner_indent = (I == 0) ? std::string() : indent + get_indent();
+        bool first = true;
+        std::size_t index = 0;
+        for (const auto& item : members) {
+            std::string_view key;
+            char digits[24];
+            if constexpr (is_object) {
+                key = std::string_view(item.first.data(), item.first.size());
+            } else {
+                key = std::string_view(digits, static_cast<std::size_t>(std::to_chars(digits, digits + sizeof(digits), index++).ptr - digits));
+            }
+            const auto act = filter->enter(key);
+            if (act != member_filter::action::omit) {
+                ostream << (first ? open : ',');
+                if (I != 0) {
+                    ostream << get_newline() << inner_indent;
+                }
+                if constexpr (is_object) {
+                    stringify_key(item.first);
+                    stringify_member(item.second, inner_indent, act);
+                } else {
+                    stringify_member(item, inner_indent, act);
+                }
+                first = false;
+            }
+            filter->leave();
+        }
+        if (first) {
+            ostream << open << close;
+            return;
+        }
+        if (I != 0) {
+            ostream << get_newline() << indent;
+        }
+        ostream << close;
+    }
+
+    /**
+     * @brief Stringify a member as the member filter says
+     *
+     * @tparam V A typename of value
+     * @param v A value object to stringify
+     * @param indent An indent string
+     * @param act An action for the member
+     */
+    template <class V>
+    void stringify_member(const V& v, const std::string& indent, member_filter::action act)
+    {
+        if (act == member_filter::action::mask) {
+            escape_string(filter->mask_text(), ostream);
+            return;
+        }
+        if ((act == member_filter::action::truncate) && v.is_string()) {
+            const auto& string = v.as_string();
+            std::size_t length = filter->truncate_length();
+            if (string.size() > length) {
+                // do not split a UTF-8 sequence
+                while ((length > 0) && ((static_cast<unsigned char>(string[length]) & 0xc0) == 0x80)) {
+                    --length;
+                }
+                ostream.write("\"", 1);
+                escape_chars(string.data(), length, ostream);
+                ostream.write("...\"", 4);
+                return;
+            }
+        }
+        stringify_value(v, indent);
+    }
+
+    /**
+     * @brief Escape string and write it (with quotes) to a sink
+     *
+     * @tparam T A typename of string
+     * @tparam S A typename of sink (std::ostream or string_sink)
+     * @param string A string to be escaped
+     * @param sink A sink to write to
+     */
+    template <class T, class S>
+    static void escape_string(const T& string, S& sink)
+    {
+        sink.write("\"", 1);
+        escape_chars(string.data(), string.size(), sink);
+        sink.write("\"", 1);
+    }
+
     /**
      * @brief Stringify string
      *
+     * @tparam T A typename of string
      * @param string A string to be stringified
      */
-    void stringify_string(const value::string_type& string)
+    template <class T>
+    void stringify_string(const T& string)
     {
-        ostream << "\"";
-        for (const auto& i : string) {
-            const auto ch = (unsigned char)i;
-            static const char hex[] = "0123456789abcdef";
-            switch (ch) {
-            case '"':
-                ostream << "\\\"";
-                break;
-            case '\\':
-                ostream << "\\\\";
-                break;
-            case '\b':
-                ostream << "\\b";
-                break;
-            case '\f':
-                ostream << "\\f";
-                break;
-            case '\n':
-                ostream << "\\n";
-                break;
-            case '\r':
-                ostream << "\\r";
-                break;
-            case '\t':
-                ostream << "\\t";
-                break;
-            default:
-                if (ch < ' ') {
-                    ostream << "\\u00";
-                    ostream.put(hex[(ch >> 4) & 0xf]);
-                    ostream.put(hex[ch & 0xf]);
-                } else {
-                    ostream.put(ch);
+        escape_string(string, ostream);
+    }
+
+    /**
+     * @brief Stringify object key with the following separator
+     *
+     * Short keys without characters to escape (the usual case) are written
+     * as `"key":` (or `"key": ` when indent enabled) with a single write.
+     *
+     * @tparam T A typename of string
+     * @param key A key to be stringified
+     */
+    template <class T>
+    void stringify_key(const T& key)
+    {
+        constexpr std::size_t separator_size = (I == 0) ? 1 : 2;
+        const std::size_t size = key.size();
+        if ((size <= short_key_size) && !needs_escape(key.data(), size)) {
+            char buffer[short_key_size + 2 + separator_size];
+            buffer[0] = '"';
+            std::memcpy(buffer + 1, key.data(), size);
+            std::memcpy(buffer + 1 + size, "\": ", 1 + separator_size);
+            ostream.write(buffer, static_cast<std::streamsize>(size + 2 + separator_size));
+            return;
+        }
+        escape_string(key, ostream);
+        ostream.write(": ", static_cast<std::streamsize>(separator_size));
+    }
+
+    static constexpr std::size_t short_key_size = 64; ///< Longest key written through the stack buffer
+
+    std::ostream& ostream;           ///< An output stream
+    member_filter* filter = nullptr; ///< Member filter (if any)
+};
+
+/**
+ * @brief Resumable stringifier which fills caller-provided buffers
+ *
+ * Produces the same text as stringifier<F, I>, but in chunks: each call of
+ * read() writes at most the given number of bytes and remembers where the
+ * traversal stopped (also in the middle of a string). The value must stay
+ * alive and unchanged until the output is done.
+ *
+ * @tparam F A combination of flags
+ * @tparam I An indent specification
+ */
+template <flags_type F, indent_type I>
+class pull_stringifier
+{
+private:
+    using self_type = pull_stringifier<F, I>;
+    static constexpr auto M = flags::stringify_mask;
+
+public:
+    /**
+     * @brief Result of read()
+     */
+    struct result {
+        std::size_t size; ///< Number of bytes written to buffer
+        bool done;        ///< True if the whole JSON has been written
+    };
+
+    /**
+     * @brief Construct a new pull stringifier object
+     *
+     * @param v A value object to stringify
+     */
+    explicit pull_stringifier(const value& v) : root(&v) {}
+
+    /**
+     * @brief Apply flag manipulator (must be applied before the first read)
+     *
+     * @tparam S Flags to be set
+     * @tparam C Flags to be cleared
+     * @param manip A manipulator
+     * @return An updated pull stringifier object
+     */
+    template <flags_type S, flags_type C>
+    pull_stringifier<((F & ~C) | S) & M, I> operator<<([[maybe_unused]] const manipulator_flags<S, C>& manip) const
+    {
+        return pull_stringifier<((F & ~C) | S) & M, I>(*root);
+    }
+
+    /**
+     * @brief Apply indent manipulator (must be applied before the first read)
+     *
+     * @tparam NI A new indent specification
+     * @param manip A manipulator
+     * @return An updated pull stringifier object
+     */
+    template <indent_type NI>
+    pull_stringifier<F, NI> operator<<([[maybe_unused]] const manipulator_indent<NI>& manip) const
+    {
+        return pull_stringifier<F, NI>(*root);
+    }
+
+    /**
+     * @brief Write next chunk of JSON text
+     *
+     * @param buffer A buffer to write to
+     * @param size Size of buffer (in bytes)
+     * @return Number of bytes written and completion flag
+     */
+    result read(char* buffer, std::size_t size)
+    {
+        std::size_t written = 0;
+        while (written < size) {
+            if (pending_pos == pending.size()) {
+                pending.clear();
+                pending_pos = 0;
+                if (!step()) {
+                    break;
                 }
-                break;
+                continue;
+            }
+            const std::size_t n = std::min(size - written, pending.size() - pending_pos);
+            pending.copy(buffer + written, n, pending_pos);
+            pending_pos += n;
+            written += n;
+        }
+        return result{written, done()};
+    }
+
+    /**
+     * @brief Check if the whole JSON has been written
+     */
+    bool done() const noexcept
+    {
+        return started && stack.empty() && (string_source == nullptr) && (pending_pos == pending.size());
+    }
+
+private:
+    /// Maximum number of source characters escaped at once
+    static constexpr std::size_t string_slice = 4096;
+
+    /**
+     * @brief A container being written
+     */
+    struct frame {
+        const value* v;                            ///< An array or object value
+        std::size_t index;                         ///< Next element (array)
+        value::object_type::const_iterator iter;   ///< Next member (object)
+        bool value_next;                           ///< Key written, member value is next (object)
+    };
+
+    /**
+     * @brief Check if flag(s) enabled
+     *
+     * @param flags Combination of flags to be tested
+     * @retval true Any flag is enabled
+     * @retval False No flag is enabled
+     */
+    static constexpr bool has_flag(flags_type flags)
+    {
+        return (F & flags) != 0;
+    }
+
+    /**
+     * @brief Append newline and indent for the given depth to pending text
+     *
+     * @param depth A nesting depth
+     */
+    void append_newline(std::size_t depth)
+    {
+        pending.append((F & flags::crlf_newline) ? "\r\n" : "\n");
+        pending.append(depth * static_cast<std::size_t>(I > 0 ? I : -I), (I > 0) ? ' ' : '\t');
+    }
+
+    /**
+     * @brief Produce the next piece of text into pending text
+     *
+     * @retval true Some text produced
+     * @retval false Nothing left
+     */
+    bool step()
+    {
+        if (string_source) {
+            const auto& str = *string_source;
+            const std::size_t n = std::min(string_slice, str.size() - string_pos);
+            string_sink sink{pending};
+            escape_chars(str.data() + string_pos, n, sink);
+            string_pos += n;
+            if (string_pos == str.size()) {
+                pending.append(string_suffix);
+                string_source = nullptr;
             }
+            return true;
+        }
+        if (!started) {
+            started = true;
+            begin_value(*root);
+            return true;
         }
-        ostream << "\"";
+        if (stack.empty()) {
+            return false;
+        }
+        auto& top = stack.back();
+        if (top.v->is_array()) {
+            const auto& elements = std::get<value::array_type>(top.v->content);
+            if (top.index < elements.size()) {
+                if (top.index > 0) {
+                    pending.append(1, ',');
+                }
+                if (I != 0) {
+                    append_newline(stack.size());
+                }
+                begin_value(elements[top.index++]);
+            } else {
+                if (I != 0) {
+                    append_newline(stack.size() - 1);
+                }
+                pending.append(1, ']');
+                stack.pop_back();
+            }
+        } else {
+            const auto& members = std::get<value::object_type>(top.v->content);
+            if (top.value_next) {
+                top.value_next = false;
+                begin_value((top.iter++)->second);
+            } else if (top.iter != members.end()) {
+                if (top.iter != members.begin()) {
+                    pending.append(1, ',');
+                }
+                if (I != 0) {
+                    append_newline(stack.size());
+                }
+                top.value_next = true;
+                begin_string(top.iter->first, (I == 0) ? ":" : ": ");
+            } else {
+                if (I != 0) {
+                    append_newline(stack.size() - 1);
+                }
+                pending.append(1, '}');
+                stack.pop_back();
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Start writing a string
+     *
+     * @param str A string to be stringified
+     * @param suffix A text appended after the closing quote
+     */
+    void begin_string(const value::string_type& str, const char* suffix)
+    {
+        pending.append(1, '"');
+        string_source = &str;
+        string_pos = 0;
+        string_suffix = suffix;
+        string_suffix.insert(string_suffix.begin(), '"');
     }
 
-    std::ostream& ostream; ///< An output stream
+    /**
+     * @brief Start writing a value (scalars are written at once)
+     *
+     * @param v A value object to stringify
+     */
+    void begin_value(const value& v)
+    {
+        std::visit(([&](auto&& arg) {
+                       using T = std::decay_t<decltype(arg)>;
+
+                       if constexpr (std::is_same_v<T, std::monostate>) {
+                           pending.append("null");
+                       } else if constexpr (std::is_same_v<T, bool>) {
+                           pending.append(arg ? "true" : "false");
+                       } else if constexpr (impl::any_of_types_v<T, int, long, long long>) {
+                           pending.append(std::to_string(arg));
+                       } else if constexpr (impl::any_of_types_v<T, float, double>) {
+                           if (std::isnan(arg)) {
+                               pending.append(has_flag(flags::not_a_number) ? "NaN" : "null");
+                           } else if (!std::isfinite(arg)) {
+                               pending.append(!has_flag(flags::infinity_number) ? "null" : (arg > 0) ? "infinity" : "-infinity");
+                           } else {
+                               // Same as default formatting of std::ostream
+                               char buffer[32];
+                               const int n = std::snprintf(buffer, sizeof(buffer), "%g", static_cast<double>(arg));
+                               pending.append(buffer, static_cast<std::size_t>(n));
+                           }
+                       } else if constexpr (std::is_same_v<T, std::string>) {
+                           begin_string(arg, "");
+                       } else if constexpr (impl::any_of_types_v<T, value::array_type, value::object_type>) {
+                           constexpr bool is_array = std::is_same_v<T, value::array_type>;
+                           if (arg.empty()) {
+                               pending.append(is_array ? "[]" : "{}");
+                           } else {
+                               pending.append(1, is_array ? '[' : '{');
+                               stack.push_back(frame{&v, 0, {}, false});
+                               if constexpr (!is_array) {
+                                   stack.back().iter = arg.begin();
+                               }
+                           }
+                       } else {
+                           static_assert(always_false_v<T>, "unknown type");
+                       }
+                   }),
+                   v.content);
+    }
+
+    const value* root;                               ///< A value to stringify
+    bool started = false;                            ///< Root value has been started
+    std::vector<frame> stack;                        ///< Containers being written
+    std::string pending;                             ///< Text produced but not written yet
+    std::size_t pending_pos = 0;                     ///< Written position in pending text
+    const value::string_type* string_source = nullptr; ///< String being written
+    std::size_t string_pos = 0;                      ///< Escaped position in string_source
+    std::string string_suffix;                       ///< Text after the string being written
 };
 
 /**
@@ -1985,9 +2937,10 @@ stringifier<0, I> operator<<(std::ostream& ostream, const manipulator_indent<I>&
 template <class S, class T, class... Args>
 static void flow_stringifier(S&& stringifier, const T& value, const Args&... args)
 {
-    auto r = stringifier << value;
     if constexpr (sizeof...(Args) > 0) {
-        flow_stringifier(std::move(r), args...);
+        flow_stringifier(stringifier << value, args...);
+    } else {
+        stringifier << value;
     }
 }
 
@@ -2013,30 +2966,6 @@ private:
 
 } /* namespace impl */
 
-/**
- * @brief Parse JSON from an input stream (with ECMA-404 standard rule)
- *
- * @param istream An input stream
- * @param v A value to store parsed value
- * @return A new parser
- */
-inline impl::parser<0> operator>>(std::istream& istream, value& v)
-{
-    return impl::parser<0>(istream) >> v;
-}
-
-/**
- * @brief Stringify JSON to an output stream (with ECMA-404 standard rule)
- *
- * @param ostream An output stream
- * @param v A value to stringify
- * @return A new stringifier
- */
-inline impl::stringifier<0, 0> operator<<(std::ostream& ostream, const value& v)
-{
-    return impl::stringifier<0, 0>(ostream) << v;
-}
-
 namespace rule {
 
 /**
@@ -2233,18 +3162,21 @@ using space_indent = impl::manipulator_indent<I>;
 /**
  * @brief Parse string as JSON (ECMA-404 standard)
  *
+ * @tparam V A value type (ex: parse<basic_value<my_traits>>(...))
  * @param istream An input stream
+ * @param resource A memory resource for strings and containers of pmr storage types (nullptr for the default allocators)
  * @param finished If true, parse as finished(closed) JSON
  * @return JSON value
  */
-inline value parse(std::istream& istream, bool finished = true)
+template <class V = value>
+V parse(std::istream& istream, std::pmr::memory_resource* resource, bool finished = true)
 {
     using namespace impl;
-    value v;
+    V v;
     if (finished) {
-        parser<flags::finished>(istream) >> v;
+        parser<flags::finished>(istream, resource) >> v;
     } else {
-        parser<0>(istream) >> v;
+        parser<0>(istream, resource) >> v;
     }
     return v;
 }
@@ -2252,43 +3184,66 @@ inline value parse(std::istream& istream, bool finished = true)
 /**
  * @brief Parse string as JSON (ECMA-404 standard)
  *
+ * @tparam V A value type
+ * @param istream An input stream
+ * @param finished If true, parse as finished(closed) JSON
+ * @return JSON value
+ */
+template <class V = value>
+V parse(std::istream& istream, bool finished = true)
+{
+    return parse<V>(istream, nullptr, finished);
+}
+
+/**
+ * @brief Parse string as JSON (ECMA-404 standard)
+ *
+ * @tparam V A value type
  * @param string A string to be parsed
+ * @param resource A memory resource for strings and containers of pmr storage types (nullptr for the default allocators)
  * @return JSON value
  */
-inline value parse(const std::string& string)
+template <class V = value>
+V parse(const std::string& string, std::pmr::memory_resource* resource = nullptr)
 {
     std::istringstream istream(string);
-    return parse(istream, true);
+    return parse<V>(istream, resource, true);
 }
 
 /**
  * @brief Parse string as JSON (ECMA-404 standard)
  *
+ * @tparam V A value type
  * @param pointer A pointer to string to be parsed
  * @param length Length of string (in bytes)
+ * @param resource A memory resource for strings and containers of pmr storage types (nullptr for the default allocators)
  * @return JSON value
  */
-inline value parse(const void* pointer, std::size_t length)
+template <class V = value>
+V parse(const void* pointer, std::size_t length, std::pmr::memory_resource* resource = nullptr)
 {
     impl::imemstream istream(pointer, length);
-    return parse(istream, true);
+    return parse<V>(istream, resource, true);
 }
 
 /**
  * @brief Parse string as JSON (JSON5)
  *
+ * @tparam V A value type (ex: parse5<basic_value<my_traits>>(...))
  * @param istream An input stream
+ * @param resource A memory resource for strings and containers of pmr storage types (nullptr for the default allocators)
  * @param finished If true, parse as finished(closed) JSON
  * @return JSON value
  */
-inline value parse5(std::istream& istream, bool finished = true)
+template <class V = value>
+V parse5(std::istream& istream, std::pmr::memory_resource* resource, bool finished = true)
 {
     using namespace impl;
-    value v;
+    V v;
     if (finished) {
-        parser<flags::json5_rules | flags::finished>(istream) >> v;
+        parser<flags::json5_rules | flags::finished>(istream, resource) >> v;
     } else {
-        parser<flags::json5_rules>(istream) >> v;
+        parser<flags::json5_rules>(istream, resource) >> v;
     }
     return v;
 }
@@ -2296,38 +3251,59 @@ inline value parse5(std::istream& istream, bool finished = true)
 /**
  * @brief Parse string as JSON (JSON5)
  *
+ * @tparam V A value type
+ * @param istream An input stream
+ * @param finished If true, parse as finished(closed) JSON
+ * @return JSON value
+ */
+template <class V = value>
+V parse5(std::istream& istream, bool finished = true)
+{
+    return parse5<V>(istream, nullptr, finished);
+}
+
+/**
+ * @brief Parse string as JSON (JSON5)
+ *
+ * @tparam V A value type
  * @param string A string to be parsed
+ * @param resource A memory resource for strings and containers of pmr storage types (nullptr for the default allocators)
  * @return JSON value
  */
-inline value parse5(const std::string& string)
+template <class V = value>
+V parse5(const std::string& string, std::pmr::memory_resource* resource = nullptr)
 {
     std::istringstream istream(string);
-    return parse5(istream, true);
+    return parse5<V>(istream, resource, true);
 }
 
 /**
  * @brief Parse string as JSON (JSON5)
  *
+ * @tparam V A value type
  * @param pointer A pointer to string to be parsed
  * @param length Length of string (in bytes)
+ * @param resource A memory resource for strings and containers of pmr storage types (nullptr for the default allocators)
  * @return JSON value
  */
-inline value parse5(const void* pointer, std::size_t length)
+template <class V = value>
+V parse5(const void* pointer, std::size_t length, std::pmr::memory_resource* resource = nullptr)
 {
     impl::imemstream istream(pointer, length);
-    return parse5(istream, true);
+    return parse5<V>(istream, resource, true);
 }
 
 /**
  * @brief Stringify value (ECMA-404 standard)
  *
+ * @tparam Traits Storage types of value
  * @tparam T A list of typenames of manipulators
  * @param v A value to stringify
  * @param args A list of manipulators
  * @return JSON string
  */
-template <class... T>
-auto stringify(const value& v, const T&... args)
+template <class Traits, class... T>
+auto stringify(const basic_value<Traits>& v, const T&... args)
 {
     std::ostringstream ostream;
     impl::flow_stringifier(ostream << rule::ecma404(), args..., v);
@@ -2337,19 +3313,48 @@ auto stringify(const value& v, const T&... args)
 /**
  * @brief Stringify value (JSON5)
  *
+ * @tparam Traits Storage types of value
  * @tparam T A list of typenames of manipulators
  * @param v A value to stringify
  * @param args A list of manipulators
  * @return JSON string
  */
-template <class... T>
-auto stringify5(const value& v, const T&... args)
+template <class Traits, class... T>
+auto stringify5(const basic_value<Traits>& v, const T&... args)
 {
     std::ostringstream ostream;
     impl::flow_stringifier(ostream << rule::json5(), args..., v);
     return ostream.str();
 }
 
+/**
+ * @brief Make a resumable stringifier (ECMA-404 standard)
+ *
+ * @tparam T A list of typenames of manipulators
+ * @param v A value to stringify (must outlive the stringifier)
+ * @param args A list of manipulators
+ * @return A pull stringifier, call read(buffer, size) until done
+ */
+template <class... T>
+auto pull_stringify(const value& v, const T&... args)
+{
+    return (impl::pull_stringifier<0, 0>(v) << rule::ecma404() << ... << args);
+}
+
+/**
+ * @brief Make a resumable stringifier (JSON5)
+ *
+ * @tparam T A list of typenames of manipulators
+ * @param v A value to stringify (must outlive the stringifier)
+ * @param args A list of manipulators
+ * @return A pull stringifier, call read(buffer, size) until done
+ */
+template <class... T>
+auto pull_stringify5(const value& v, const T&... args)
+{
+    return (impl::pull_stringifier<0, 0>(v) << rule::json5() << ... << args);
+}
+
 /**
  * @brief Stringify value (ECMA-404 standard)
  *
@@ -2357,8 +3362,9 @@ auto stringify5(const value& v, const T&... args)
  * @param args A list of manipulators
  * @return JSON string
  */
+template <class Traits>
 template <class... T>
-auto value::stringify(const T&... args) const
+auto basic_value<Traits>::stringify(const T&... args) const
 {
     return json5pp::stringify(*this, args...);
 }
@@ -2370,8 +3376,9 @@ auto value::stringify(const T&... args) const
  * @param args A list of manipulators
  * @return JSON string
  */
+template <class Traits>
 template <class... T>
-auto value::stringify5(const T&... args) const
+auto basic_value<Traits>::stringify5(const T&... args) const
 {
     return json5pp::stringify5(*this, args...);
 }
@@ -0,0 +1,1028 @@
+#ifndef _JSON5PP_LITE_HPP_
+#define _JSON5PP_LITE_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <limits>
+#include <string_view>
+
+/*
+ * Low-footprint JSON/JSON5 for freestanding-like targets
+ *
+ * This header does not include json5pp.hpp, iostreams nor containers and
+ * works with -fno-exceptions -fno-rtti: text is parsed from a caller's
+ * buffer into a caller's array of nodes, stringified into a caller's buffer
+ * (or sink), and errors are returned as codes. Nothing is allocated.
+ */
+namespace json5pp {
+namespace lite {
+
+/**
+ * @brief Error codes
+ */
+enum class errc : std::uint8_t {
+    ok = 0,         ///< Success
+    syntax_error,   ///< Illegal character
+    unexpected_end, ///< Text ends in the middle of a value
+    too_deep,       ///< Arrays / objects nest deeper than the limit
+    out_of_nodes,   ///< Node array is full
+    out_of_space,   ///< Output buffer is full
+};
+
+/**
+ * @brief Get a description of an error code
+ *
+ * @param ec An error code
+ * @return A static string
+ */
+inline const char* message(errc ec) noexcept
+{
+    switch (ec) {
+    case errc::ok:
+        return "success";
+    case errc::syntax_error:
+        return "JSON syntax error: illegal character";
+    case errc::unexpected_end:
+        return "JSON syntax error: unexpected EOS";
+    case errc::too_deep:
+        return "JSON nesting too deep";
+    case errc::out_of_nodes:
+        return "out of nodes";
+    case errc::out_of_space:
+        return "out of output buffer";
+    }
+    return "unknown error";
+}
+
+using rules_type = std::uint32_t;
+
+/**
+ * @brief Syntax rules (same meanings as json5pp::rule manipulators)
+ */
+namespace rule {
+enum : rules_type {
+    single_line_comment = (1u << 0),                                 ///< Allow "//" comments
+    multi_line_comment = (1u << 1),                                  ///< Allow "/ *" ... "* /" comments
+    comments = single_line_comment | multi_line_comment,             ///< Allow any comments
+    explicit_plus_sign = (1u << 2),                                  ///< Allow "+" before non-negative number
+    leading_decimal_point = (1u << 3),                               ///< Allow ".5"
+    trailing_decimal_point = (1u << 4),                              ///< Allow "5."
+    decimal_points = leading_decimal_point | trailing_decimal_point, ///< Allow both
+    infinity_number = (1u << 5),                                     ///< Allow infinity / -infinity
+    not_a_number = (1u << 6),                                        ///< Allow NaN
+    hexadecimal = (1u << 7),                                         ///< Allow 0x...
+    single_quote = (1u << 8),                                        ///< Allow single-quoted strings
+    multi_line_string = (1u << 9),                                   ///< Allow strings continued by "\"
+    trailing_comma = (1u << 10),                                     ///< Allow trailing comma
+    unquoted_key = (1u << 11),                                       ///< Allow unquoted keys
+    ecma404 = 0,                                                     ///< ECMA-404 standard
+    json5 = ((unquoted_key << 1) - 1),                               ///< JSON5
+};
+} /* namespace rule */
+
+/**
+ * @brief Type of a node
+ */
+enum class node_type : std::uint8_t {
+    null,
+    boolean,
+    integer,
+    number,
+    string,
+    array,
+    object,
+};
+
+namespace impl {
+class parser;
+} /* namespace impl */
+
+/**
+ * @brief A parsed value
+ *
+ * Nodes are stored in pre-order: elements (members) of an array (object)
+ * follow it in the same node array. Strings and keys point into the
+ * parsed text, which must outlive the nodes. Members keep the order of
+ * the text.
+ *
+ * Accessors never fail: they return false / 0 / empty for other types.
+ */
+class node
+{
+public:
+    /**
+     * @brief Iterator over elements / members
+     */
+    class iterator
+    {
+    public:
+        explicit iterator(const node* current) noexcept : current(current) {}
+        const node& operator*() const noexcept { return *current; }
+        const node* operator->() const noexcept { return current; }
+        iterator& operator++() noexcept
+        {
+            current += current->span;
+            return *this;
+        }
+        bool operator==(const iterator& other) const noexcept { return current == other.current; }
+        bool operator!=(const iterator& other) const noexcept { return current != other.current; }
+
+    private:
+        const node* current;
+    };
+
+    node_type type() const noexcept { return kind; }
+    bool is_null() const noexcept { return kind == node_type::null; }
+    bool is_boolean() const noexcept { return kind == node_type::boolean; }
+    bool is_integer() const noexcept { return kind == node_type::integer; }
+    bool is_number() const noexcept { return (kind == node_type::integer) || (kind == node_type::number); }
+    bool is_string() const noexcept { return kind == node_type::string; }
+    bool is_array() const noexcept { return kind == node_type::array; }
+    bool is_object() const noexcept { return kind == node_type::object; }
+
+    /**
+     * @brief Get boolean (false for other types)
+     */
+    bool as_boolean() const noexcept { return (kind == node_type::boolean) && payload.boolean; }
+
+    /**
+     * @brief Get integer (0 for other types)
+     */
+    long long as_integer() const noexcept { return (kind == node_type::integer) ? payload.integer : 0; }
+
+    /**
+     * @brief Get number (integers are converted, 0 for other types)
+     */
+    double as_number() const noexcept
+    {
+        return (kind == node_type::number) ? payload.number : static_cast<double>(as_integer());
+    }
+
+    /**
+     * @brief Get string (empty for other types)
+     */
+    std::string_view as_string() const noexcept
+    {
+        return (kind == node_type::string) ? std::string_view(payload.string, count) : std::string_view();
+    }
+
+    /**
+     * @brief Get the key of an object member (empty for others)
+     */
+    std::string_view key() const noexcept { return std::string_view(key_data, key_length); }
+
+    /**
+     * @brief Get the number of elements / members (0 for other types)
+     */
+    std::size_t size() const noexcept { return ((kind == node_type::array) || (kind == node_type::object)) ? count : 0; }
+
+    iterator begin() const noexcept { return iterator(this + 1); }
+    iterator end() const noexcept { return iterator(this + span); }
+
+    /**
+     * @brief Find an element by index
+     *
+     * @param index An index
+     * @return A pointer to the element, or nullptr if out of range (or not an array)
+     */
+    const node* at(std::size_t index) const noexcept
+    {
+        if ((kind != node_type::array) || (index >= count)) {
+            return nullptr;
+        }
+        iterator iter = begin();
+        for (; index > 0; --index) {
+            ++iter;
+        }
+        return iter.operator->();
+    }
+
+    /**
+     * @brief Find a member by key (the first one if duplicated)
+     *
+     * @param key A key
+     * @return A pointer to the member, or nullptr if not found (or not an object)
+     */
+    const node* find(std::string_view key) const noexcept
+    {
+        if (kind != node_type::object) {
+            return nullptr;
+        }
+        for (const auto& member : *this) {
+            if (member.key() == key) {
+                return &member;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    friend class impl::parser;
+
+    node_type kind = node_type::null; ///< Type
+    std::uint32_t count = 0;          ///< Length of string, number of elements / members
+    std::uint32_t span = 1;           ///< Number of nodes of this subtree (including self)
+    std::uint32_t key_length = 0;     ///< Length of key
+    const char* key_data = nullptr;   ///< Key (object members only)
+    union {
+        bool boolean;
+        long long integer;
+        double number;
+        const char* string;
+    } payload{};
+};
+
+/**
+ * @brief Result of parse()
+ */
+struct parse_result {
+    errc ec;           ///< Error code
+    std::size_t offset; ///< Offset of the error in text (or the end of text)
+    std::size_t nodes;  ///< Number of nodes used
+    const node* root;   ///< Root node (nullptr on error)
+
+    explicit operator bool() const noexcept { return ec == errc::ok; }
+};
+
+/**
+ * @brief Result of stringify()
+ */
+struct stringify_result {
+    errc ec;          ///< Error code
+    std::size_t size; ///< Length of the whole text (also when the buffer is short)
+
+    explicit operator bool() const noexcept { return ec == errc::ok; }
+};
+
+namespace impl {
+
+/**
+ * @brief In-situ parser
+ *
+ * Strings are unescaped in place (an escape sequence is never shorter than
+ * its result), so no other buffer is needed.
+ */
+class parser
+{
+public:
+    parser(char* text, std::size_t size, node* nodes, std::size_t capacity, rules_type rules, unsigned max_depth) noexcept
+        : text(text), p(text), end(text + size), nodes(nodes), capacity(capacity), rules(rules), max_depth(max_depth)
+    {
+    }
+
+    parse_result run() noexcept
+    {
+        errc ec = parse_value(0, nullptr, 0);
+        if (ec == errc::ok) {
+            ec = skip_spaces();
+            if ((ec == errc::ok) && (p != end)) {
+                ec = errc::syntax_error;
+            }
+        }
+        return parse_result{ec, static_cast<std::size_t>(p - text), used, (ec == errc::ok) ? nodes : nullptr};
+    }
+
+private:
+    bool has_rule(rules_type r) const noexcept { return (rules & r) != 0; }
+
+    static bool is_digit(char ch) noexcept { return (ch >= '0') && (ch <= '9'); }
+
+    static bool is_ident_start(char ch) noexcept
+    {
+        return ((ch >= 'A') && (ch <= 'Z')) || ((ch >= 'a') && (ch <= 'z')) || (ch == '_') || (ch == '$');
+    }
+
+    static int hex_value(char ch) noexcept
+    {
+        if (is_digit(ch)) {
+            return ch - '0';
+        } else if ((ch >= 'A') && (ch <= 'F')) {
+            return ch - 'A' + 10;
+        } else if ((ch >= 'a') && (ch <= 'f')) {
+            return ch - 'a' + 10;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Error at the current position (unexpected_end at the end of text)
+     */
+    errc syntax_error() const noexcept { return (p == end) ? errc::unexpected_end : errc::syntax_error; }
+
+    /**
+     * @brief Skip spaces (and comments)
+     */
+    errc skip_spaces() noexcept
+    {
+        while (p != end) {
+            const char ch = *p;
+            if ((ch == ' ') || (ch == '\t') || (ch == '\n') || (ch == '\r')) {
+                ++p;
+            } else if ((ch == '/') && ((end - p) >= 2) && (p[1] == '/') && has_rule(rule::single_line_comment)) {
+                // [single_line_comment] (JSON5)
+                for (p += 2; (p != end) && (*p != '\r') && (*p != '\n'); ++p) {
+                }
+            } else if ((ch == '/') && ((end - p) >= 2) && (p[1] == '*') && has_rule(rule::multi_line_comment)) {
+                // [multi_line_comment] (JSON5)
+                for (p += 2;; ++p) {
+                    if ((end - p) < 2) {
+                        p = end;
+                        return errc::unexpected_end;
+                    }
+                    if ((p[0] == '*') && (p[1] == '/')) {
+                        break;
+                    }
+                }
+                p += 2;
+            } else {
+                break;
+            }
+        }
+        return errc::ok;
+    }
+
+    /**
+     * @brief Consume a literal word
+     */
+    errc expect(const char* word) noexcept
+    {
+        for (; *word != '\0'; ++word, ++p) {
+            if ((p == end) || (*p != *word)) {
+                return syntax_error();
+            }
+        }
+        return errc::ok;
+    }
+
+    /**
+     * @brief Parse value into a new node
+     */
+    errc parse_value(unsigned depth, const char* key, std::uint32_t key_length) noexcept
+    {
+        if (errc ec = skip_spaces(); ec != errc::ok) {
+            return ec;
+        }
+        if (p == end) {
+            return errc::unexpected_end;
+        }
+        if (used >= capacity) {
+            return errc::out_of_nodes;
+        }
+        const std::size_t index = used++;
+        node& n = nodes[index];
+        n = node();
+        n.key_data = key;
+        n.key_length = key_length;
+
+        errc ec;
+        switch (*p) {
+        case '{':
+            ec = parse_object(index, depth);
+            break;
+        case '[':
+            ec = parse_array(index, depth);
+            break;
+        case '"':
+        case '\'':
+            n.kind = node_type::string;
+            ec = parse_string(n.payload.string, n.count);
+            break;
+        case 'n':
+            ec = expect("null");
+            break;
+        case 't':
+            n.kind = node_type::boolean;
+            n.payload.boolean = true;
+            ec = expect("true");
+            break;
+        case 'f':
+            n.kind = node_type::boolean;
+            n.payload.boolean = false;
+            ec = expect("false");
+            break;
+        default:
+            ec = parse_number(n);
+            break;
+        }
+        nodes[index].span = static_cast<std::uint32_t>(used - index);
+        return ec;
+    }
+
+    /**
+     * @brief Parse number (same grammar and conversion as json5pp::parse)
+     */
+    errc parse_number(node& n) noexcept
+    {
+        bool negative = false;
+        std::uint64_t int_part = 0;
+        double int_value = 0;
+        bool overflow = false;
+        bool has_digits = false;
+        std::uint64_t frac_part = 0;
+        int frac_divs = 0;
+        int exp_part = 0;
+        bool exp_negative = false;
+
+        // [int]
+        if (*p == '-') {
+            negative = true;
+            ++p;
+        } else if ((*p == '+') && has_rule(rule::explicit_plus_sign)) {
+            ++p;
+        }
+        if (p == end) {
+            return errc::unexpected_end;
+        }
+        if (*p == '0') {
+            // ["0"]
+            ++p;
+            has_digits = true;
+            if (has_rule(rule::hexadecimal) && (p != end) && ((*p == 'x') || (*p == 'X'))) {
+                // [hexdigit]+
+                ++p;
+                const char* first = p;
+                for (int digit; (p != end) && ((digit = hex_value(*p)) >= 0); ++p) {
+                    int_part = (int_part << 4) | static_cast<std::uint64_t>(digit);
+                }
+                if (p == first) {
+                    return syntax_error();
+                }
+                n.kind = node_type::number;
+                n.payload.number = negative ? -static_cast<double>(int_part) : static_cast<double>(int_part);
+                return errc::ok;
+            }
+        } else if (is_digit(*p)) {
+            // [onenine] [digit]*
+            has_digits = true;
+            for (; (p != end) && is_digit(*p); ++p) {
+                const unsigned digit = static_cast<unsigned>(*p - '0');
+                overflow = overflow || (int_part > (std::numeric_limits<std::uint64_t>::max() - digit) / 10);
+                int_part = int_part * 10 + digit;
+                int_value = int_value * 10 + digit;
+            }
+        } else if ((*p == '.') && has_rule(rule::leading_decimal_point)) {
+            // ['.'] (JSON5)
+        } else if ((*p == 'i') && has_rule(rule::infinity_number)) {
+            // ["infinity"] (JSON5)
+            n.kind = node_type::number;
+            n.payload.number = negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+            return expect("infinity");
+        } else if ((*p == 'N') && has_rule(rule::not_a_number)) {
+            // ["NaN"] (JSON5)
+            n.kind = node_type::number;
+            n.payload.number = std::numeric_limits<double>::quiet_NaN();
+            return expect("NaN");
+        } else {
+            return syntax_error();
+        }
+        if ((p != end) && (*p == '.')) {
+            // [frac]
+            for (++p; (p != end) && is_digit(*p); ++p, ++frac_divs) {
+                if (frac_divs < std::numeric_limits<std::uint64_t>::digits10) {
+                    frac_part = frac_part * 10 + static_cast<unsigned>(*p - '0');
+                }
+            }
+            if ((frac_divs == 0) && !has_rule(rule::trailing_decimal_point)) {
+                return syntax_error();
+            }
+            frac_divs = std::min(frac_divs, std::numeric_limits<std::uint64_t>::digits10);
+            has_digits = has_digits || (frac_divs > 0);
+        }
+        if (!has_digits) {
+            return syntax_error();
+        }
+        if ((p != end) && ((*p == 'e') || (*p == 'E'))) {
+            // [exp]
+            ++p;
+            if ((p != end) && ((*p == '-') || (*p == '+'))) {
+                exp_negative = (*p == '-');
+                ++p;
+            }
+            const char* first = p;
+            for (; (p != end) && is_digit(*p); ++p) {
+                exp_part = std::min(exp_part * 10 + (*p - '0'), 100000);
+            }
+            if (p == first) {
+                return syntax_error();
+            }
+        }
+        constexpr auto max_integer = static_cast<std::uint64_t>(std::numeric_limits<long long>::max());
+        if ((frac_part == 0) && (exp_part == 0) && !overflow && (int_part <= max_integer + (negative ? 1 : 0))) {
+            n.kind = node_type::integer;
+            n.payload.integer = negative ? static_cast<long long>(0 - int_part) : static_cast<long long>(int_part);
+            return errc::ok;
+        }
+        double number_value = int_value;
+        if (frac_part > 0) {
+            number_value += (static_cast<double>(frac_part) * std::pow(10, -frac_divs));
+        }
+        if (exp_part > 0) {
+            number_value *= std::pow(10, exp_negative ? -exp_part : +exp_part);
+        }
+        n.kind = node_type::number;
+        n.payload.number = negative ? -number_value : +number_value;
+        return errc::ok;
+    }
+
+    /**
+     * @brief Parse string and unescape it in place
+     */
+    errc parse_string(const char*& data, std::uint32_t& length) noexcept
+    {
+        const char quote = *p;
+        if (!((quote == '"') || ((quote == '\'') && has_rule(rule::single_quote)))) {
+            return syntax_error();
+        }
+        char* out = ++p;
+        data = out;
+        for (;;) {
+            if (p == end) {
+                return errc::unexpected_end;
+            }
+            char ch = *p;
+            if (ch == quote) {
+                ++p;
+                break;
+            } else if (static_cast<unsigned char>(ch) < ' ') {
+                return errc::syntax_error;
+            } else if (ch == '\\') {
+                // [escape]
+                if (++p == end) {
+                    return errc::unexpected_end;
+                }
+                ch = *p;
+                switch (ch) {
+                case '\'':
+                    if (!has_rule(rule::single_quote)) {
+                        return errc::syntax_error;
+                    }
+                    break;
+                case '"':
+                case '\\':
+                case '/':
+                    break;
+                case 'b':
+                    ch = '\b';
+                    break;
+                case 'f':
+                    ch = '\f';
+                    break;
+                case 'n':
+                    ch = '\n';
+                    break;
+                case 'r':
+                    ch = '\r';
+                    break;
+                case 't':
+                    ch = '\t';
+                    break;
+                case 'u':
+                    // ['u' hex hex hex hex]
+                    {
+                        unsigned code = 0;
+                        for (int i = 0; i < 4; ++i) {
+                            if (++p == end) {
+                                return errc::unexpected_end;
+                            }
+                            const int digit = hex_value(*p);
+                            if (digit < 0) {
+                                return errc::syntax_error;
+                            }
+                            code = (code << 4) | static_cast<unsigned>(digit);
+                        }
+                        ++p;
+                        if (code < 0x80) {
+                            *out++ = static_cast<char>(code);
+                        } else if (code < 0x800) {
+                            *out++ = static_cast<char>(0xc0 | (code >> 6));
+                            *out++ = static_cast<char>(0x80 | (code & 0x3f));
+                        } else {
+                            *out++ = static_cast<char>(0xe0 | (code >> 12));
+                            *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                            *out++ = static_cast<char>(0x80 | (code & 0x3f));
+                        }
+                    }
+                    continue;
+                case '\r':
+                    if (has_rule(rule::multi_line_string)) {
+                        if ((++p != end) && (*p == '\n')) {
+                            ++p;
+                        }
+                        continue;
+                    }
+                    return errc::syntax_error;
+                case '\n':
+                    if (has_rule(rule::multi_line_string)) {
+                        ++p;
+                        continue;
+                    }
+                    return errc::syntax_error;
+                default:
+                    return errc::syntax_error;
+                }
+            }
+            *out++ = ch;
+            ++p;
+        }
+        length = static_cast<std::uint32_t>(out - data);
+        return errc::ok;
+    }
+
+    /**
+     * @brief Parse array
+     */
+    errc parse_array(std::size_t index, unsigned depth) noexcept
+    {
+        if (depth >= max_depth) {
+            return errc::too_deep;
+        }
+        nodes[index].kind = node_type::array;
+        ++p;
+        std::uint32_t count = 0;
+        for (;; ++count) {
+            if (errc ec = skip_spaces(); ec != errc::ok) {
+                return ec;
+            }
+            if (p == end) {
+                return errc::unexpected_end;
+            }
+            if (*p == ']') {
+                ++p;
+                break;
+            }
+            if (count > 0) {
+                if (*p != ',') {
+                    return errc::syntax_error;
+                }
+                ++p;
+                if (has_rule(rule::trailing_comma)) {
+                    if (errc ec = skip_spaces(); ec != errc::ok) {
+                        return ec;
+                    }
+                    if ((p != end) && (*p == ']')) {
+                        ++p;
+                        break;
+                    }
+                }
+            }
+            // [value]
+            if (errc ec = parse_value(depth + 1, nullptr, 0); ec != errc::ok) {
+                return ec;
+            }
+        }
+        nodes[index].count = count;
+        return errc::ok;
+    }
+
+    /**
+     * @brief Parse object
+     */
+    errc parse_object(std::size_t index, unsigned depth) noexcept
+    {
+        if (depth >= max_depth) {
+            return errc::too_deep;
+        }
+        nodes[index].kind = node_type::object;
+        ++p;
+        std::uint32_t count = 0;
+        for (;; ++count) {
+            if (errc ec = skip_spaces(); ec != errc::ok) {
+                return ec;
+            }
+            if (p == end) {
+                return errc::unexpected_end;
+            }
+            if (*p == '}') {
+                ++p;
+                break;
+            }
+            if (count > 0) {
+                if (*p != ',') {
+                    return errc::syntax_error;
+                }
+                ++p;
+                if (errc ec = skip_spaces(); ec != errc::ok) {
+                    return ec;
+                }
+                if (has_rule(rule::trailing_comma) && (p != end) && (*p == '}')) {
+                    ++p;
+                    break;
+                }
+            }
+            if (p == end) {
+                return errc::unexpected_end;
+            }
+            // [string]
+            // [key] (JSON5)
+            const char* key;
+            std::uint32_t key_length;
+            if (has_rule(rule::unquoted_key) && is_ident_start(*p)) {
+                key = p;
+                for (++p; (p != end) && (is_ident_start(*p) || is_digit(*p)); ++p) {
+                }
+                key_length = static_cast<std::uint32_t>(p - key);
+            } else if (errc ec = parse_string(key, key_length); ec != errc::ok) {
+                return ec;
+            }
+            if (errc ec = skip_spaces(); ec != errc::ok) {
+                return ec;
+            }
+            if ((p == end) || (*p != ':')) {
+                return syntax_error();
+            }
+            ++p;
+            // [value]
+            if (errc ec = parse_value(depth + 1, key, key_length); ec != errc::ok) {
+                return ec;
+            }
+        }
+        nodes[index].count = count;
+        return errc::ok;
+    }
+
+    char* const text;           ///< Start of text
+    char* p;                    ///< Current position
+    char* const end;            ///< End of text
+    node* const nodes;          ///< Node array
+    const std::size_t capacity; ///< Number of nodes in the array
+    std::size_t used = 0;       ///< Number of nodes used
+    const rules_type rules;     ///< Syntax rules
+    const unsigned max_depth;   ///< Nesting limit
+};
+
+/**
+ * @brief Sink writing into a fixed buffer (and counting what does not fit)
+ */
+struct buffer_sink {
+    char* buffer;
+    std::size_t capacity;
+    std::size_t size = 0;
+
+    void write(const char* data, std::size_t n) noexcept
+    {
+        if (size < capacity) {
+            std::memcpy(buffer + size, data, std::min(n, capacity - size));
+        }
+        size += n;
+    }
+};
+
+/**
+ * @brief Stringifier
+ *
+ * @tparam S A typename of sink (write(const char*, std::size_t))
+ */
+template <class S>
+class stringifier
+{
+public:
+    stringifier(S& sink, int indent, rules_type rules) noexcept : sink(sink), indent(indent), rules(rules) {}
+
+    void run(const node& n) noexcept { stringify_value(n, 0); }
+
+private:
+    void write(std::string_view text) noexcept { sink.write(text.data(), text.size()); }
+
+    /**
+     * @brief Write a newline and the indent of a level
+     */
+    void write_indent(unsigned level) noexcept
+    {
+        write("\n");
+        const char ch = (indent > 0) ? ' ' : '\t';
+        const unsigned width = static_cast<unsigned>((indent > 0) ? indent : -indent) * level;
+        for (unsigned i = 0; i < width; ++i) {
+            sink.write(&ch, 1);
+        }
+    }
+
+    /**
+     * @brief Write a quoted and escaped string
+     */
+    void stringify_string(std::string_view s) noexcept
+    {
+        static const char hex[] = "0123456789abcdef";
+        write("\"");
+        std::size_t run = 0;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            const auto ch = static_cast<unsigned char>(s[i]);
+            const char* escaped;
+            char unicode[6];
+            switch (ch) {
+            case '"':
+                escaped = "\\\"";
+                break;
+            case '\\':
+                escaped = "\\\\";
+                break;
+            case '\b':
+                escaped = "\\b";
+                break;
+            case '\f':
+                escaped = "\\f";
+                break;
+            case '\n':
+                escaped = "\\n";
+                break;
+            case '\r':
+                escaped = "\\r";
+                break;
+            case '\t':
+                escaped = "\\t";
+                break;
+            default:
+                if (ch >= ' ') {
+                    continue;
+                }
+                unicode[0] = '\\';
+                unicode[1] = 'u';
+                unicode[2] = '0';
+                unicode[3] = '0';
+                unicode[4] = hex[(ch >> 4) & 0xf];
+                unicode[5] = hex[ch & 0xf];
+                sink.write(s.data() + run, i - run);
+                sink.write(unicode, 6);
+                run = i + 1;
+                continue;
+            }
+            sink.write(s.data() + run, i - run);
+            sink.write(escaped, 2);
+            run = i + 1;
+        }
+        sink.write(s.data() + run, s.size() - run);
+        write("\"");
+    }
+
+    /**
+     * @brief Write a number (same format as json5pp::stringify)
+     */
+    void stringify_number(double d) noexcept
+    {
+        if (std::isnan(d)) {
+            write((rules & rule::not_a_number) ? "NaN" : "null");
+        } else if (!std::isfinite(d)) {
+            write(!(rules & rule::infinity_number) ? "null" : (d > 0) ? "infinity" : "-infinity");
+        } else {
+            char buffer[32];
+            const int n = std::snprintf(buffer, sizeof(buffer), "%g", d);
+            sink.write(buffer, static_cast<std::size_t>(n));
+        }
+    }
+
+    void stringify_value(const node& n, unsigned level) noexcept
+    {
+        switch (n.type()) {
+        case node_type::null:
+            write("null");
+            break;
+        case node_type::boolean:
+            write(n.as_boolean() ? "true" : "false");
+            break;
+        case node_type::integer: {
+            char buffer[24];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), n.as_integer());
+            sink.write(buffer, static_cast<std::size_t>(result.ptr - buffer));
+            break;
+        }
+        case node_type::number:
+            stringify_number(n.as_number());
+            break;
+        case node_type::string:
+            stringify_string(n.as_string());
+            break;
+        case node_type::array:
+        case node_type::object: {
+            const bool is_object = n.is_object();
+            if (n.size() == 0) {
+                write(is_object ? "{}" : "[]");
+                break;
+            }
+            const char* delim = is_object ? "{" : "[";
+            for (const auto& item : n) {
+                write(delim);
+                if (indent != 0) {
+                    write_indent(level + 1);
+                }
+                if (is_object) {
+                    stringify_string(item.key());
+                    write((indent == 0) ? ":" : ": ");
+                }
+                stringify_value(item, level + 1);
+                delim = ",";
+            }
+            if (indent != 0) {
+                write_indent(level);
+            }
+            write(is_object ? "}" : "]");
+            break;
+        }
+        }
+    }
+
+    S& sink;                ///< Output
+    const int indent;       ///< Spaces (> 0) or tabs (< 0) per level
+    const rules_type rules; ///< Syntax rules (NaN and infinity only)
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Parse JSON text in place
+ *
+ * Strings in text are unescaped in place, and nodes point into it.
+ *
+ * @param text A text (modified)
+ * @param size Length of text
+ * @param nodes An array to store nodes (the root is nodes[0])
+ * @param capacity Number of nodes in the array
+ * @param rules Syntax rules (default: ECMA-404 standard)
+ * @param max_depth Maximum nesting of arrays / objects
+ * @return A result
+ */
+inline parse_result parse(char* text, std::size_t size, node* nodes, std::size_t capacity,
+                          rules_type rules = rule::ecma404, unsigned max_depth = 64) noexcept
+{
+    return impl::parser(text, size, nodes, capacity, rules, max_depth).run();
+}
+
+/**
+ * @brief Parse JSON text in place (with array of nodes)
+ */
+template <std::size_t N>
+parse_result parse(char* text, std::size_t size, node (&nodes)[N],
+                   rules_type rules = rule::ecma404, unsigned max_depth = 64) noexcept
+{
+    return parse(text, size, nodes, N, rules, max_depth);
+}
+
+/**
+ * @brief Parse JSON5 text in place
+ */
+inline parse_result parse5(char* text, std::size_t size, node* nodes, std::size_t capacity, unsigned max_depth = 64) noexcept
+{
+    return parse(text, size, nodes, capacity, rule::json5, max_depth);
+}
+
+/**
+ * @brief Parse JSON5 text in place (with array of nodes)
+ */
+template <std::size_t N>
+parse_result parse5(char* text, std::size_t size, node (&nodes)[N], unsigned max_depth = 64) noexcept
+{
+    return parse(text, size, nodes, N, rule::json5, max_depth);
+}
+
+/**
+ * @brief Stringify nodes to a sink
+ *
+ * @tparam S A typename of sink which has write(const char*, std::size_t)
+ * @param sink A sink
+ * @param root A root node
+ * @param indent Spaces (> 0) or tabs (< 0) per level, 0 for no indent
+ * @param rules Syntax rules (infinity_number and not_a_number are used)
+ */
+template <class S>
+void stringify(S& sink, const node& root, int indent = 0, rules_type rules = rule::ecma404) noexcept
+{
+    impl::stringifier<S>(sink, indent, rules).run(root);
+}
+
+/**
+ * @brief Stringify nodes into a buffer (ECMA-404 standard)
+ *
+ * The text is not NUL-terminated. When the buffer is short, the buffer
+ * holds the beginning of the text and the result has errc::out_of_space
+ * with the size needed.
+ *
+ * @param root A root node
+ * @param buffer A buffer
+ * @param size Size of buffer
+ * @param indent Spaces (> 0) or tabs (< 0) per level, 0 for no indent
+ * @return A result
+ */
+inline stringify_result stringify(const node& root, char* buffer, std::size_t size, int indent = 0) noexcept
+{
+    impl::buffer_sink sink{buffer, size};
+    stringify(sink, root, indent, rule::ecma404);
+    return stringify_result{(sink.size <= size) ? errc::ok : errc::out_of_space, sink.size};
+}
+
+/**
+ * @brief Stringify nodes into a buffer (JSON5)
+ */
+inline stringify_result stringify5(const node& root, char* buffer, std::size_t size, int indent = 0) noexcept
+{
+    impl::buffer_sink sink{buffer, size};
+    stringify(sink, root, indent, rule::json5);
+    return stringify_result{(sink.size <= size) ? errc::ok : errc::out_of_space, sink.size};
+}
+
+} /* namespace lite */
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_LITE_HPP_ */
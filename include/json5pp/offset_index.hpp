@@ -0,0 +1,365 @@
+#ifndef _JSON5PP_OFFSET_INDEX_HPP_
+#define _JSON5PP_OFFSET_INDEX_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "json5pp.hpp"
+#include "pointer.hpp"
+#include "pull_parser.hpp"
+#include "record_reader.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Sidecar index of record offsets for random access into record files
+ *
+ * An index keeps the byte offset of every record of an NDJSON or top-level
+ * array file, and optionally a hash of a key field per record. A record is
+ * then read with one seek and the usual parser.
+ *
+ * ```cpp
+ * std::ifstream data("dump.ndjson", std::ios::binary);
+ * auto index = json5pp::offset_index::build(data, json5pp::record_format::ndjson, "/id");
+ * std::ofstream sidecar("dump.ndjson.idx", std::ios::binary);
+ * index.save(sidecar);
+ *
+ * auto record = index.read_key(data, 12345);  // or index.read(data, n)
+ * ```
+ */
+class offset_index
+{
+public:
+    offset_index() = default;
+
+    /**
+     * @brief Build an index in one pass
+     *
+     * @param istream Input records (positioned at the beginning)
+     * @param format Layout of records
+     * @param key JSON pointer of a key field to index ("" for none)
+     * @param json5 Parse records as JSON5
+     * @throws json5pp::syntax_error on a syntax error (array format, or when indexing keys)
+     */
+    static offset_index build(std::istream& istream, record_format format = record_format::ndjson, std::string_view key = "", bool json5 = false)
+    {
+        offset_index index;
+        index.format = format;
+        index.json5 = json5;
+        index.key_path = std::string(key);
+        std::optional<pointer> path;
+        if (!key.empty()) {
+            path.emplace(key);
+        }
+        auto add_key = [&](const value& record) {
+            if (path) {
+                if (const value* k = path->find(record)) {
+                    index.keys.emplace_back(hash_of(*k), index.offsets.size() - 1);
+                }
+            }
+        };
+
+        if (format == record_format::ndjson) {
+            index.source_size = scan_lines(istream, [&](std::uint64_t offset, const std::string& line) {
+                index.offsets.push_back(offset);
+                if (path) {
+                    add_key(json5 ? parse5(line.data(), line.size()) : parse(line.data(), line.size()));
+                }
+            }, path.has_value());
+        } else {
+            pull_parser parser(istream, json5);
+            if (parser.next() != parse_event::begin_array) {
+                throw syntax_error(parser.event() == parse_event::end_of_input ? std::char_traits<char>::eof() : '?', "records");
+            }
+            while (parser.next() != parse_event::end_array) {
+                index.offsets.push_back(parser.offset());
+                if (path) {
+                    add_key(parser.read_value());
+                } else {
+                    parser.skip();
+                }
+            }
+            index.source_size = parser.position();
+        }
+        std::sort(index.keys.begin(), index.keys.end());
+        return index;
+    }
+
+    /// Number of records
+    std::size_t size() const noexcept { return offsets.size(); }
+
+    /// Byte offset of a record
+    std::uint64_t offset(std::size_t n) const { return offsets.at(n); }
+
+    /// Layout of records
+    record_format get_format() const noexcept { return format; }
+
+    /// JSON pointer of the indexed key ("" for none)
+    const std::string& get_key_path() const noexcept { return key_path; }
+
+    /// Bytes of input scanned when built (to detect a changed source)
+    std::uint64_t get_source_size() const noexcept { return source_size; }
+
+    /**
+     * @brief Read a record by position
+     *
+     * @param istream A seekable input (the indexed file)
+     * @param n Record number (0-based)
+     * @throws std::out_of_range if n is out of range
+     * @throws std::runtime_error if the input cannot be positioned
+     */
+    value read(std::istream& istream, std::size_t n) const
+    {
+        istream.clear();
+        if (!istream.seekg(static_cast<std::streamoff>(offset(n)))) {
+            throw std::runtime_error("offset_index: cannot seek");
+        }
+        return json5 ? parse5(istream, false) : parse(istream, false);
+    }
+
+    /**
+     * @brief Find records whose key equals a value
+     *
+     * Candidates are found by key hash and confirmed by reading them.
+     *
+     * @param istream A seekable input (the indexed file)
+     * @param key A key value
+     * @return Record numbers (ascending)
+     */
+    std::vector<std::size_t> find(std::istream& istream, const value& key) const
+    {
+        std::vector<std::size_t> result;
+        for_each_match(istream, key, [&](std::size_t n, value&) {
+            result.push_back(n);
+            return true;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Read the first record whose key equals a value
+     *
+     * The record parsed to confirm the key is returned (no second read).
+     *
+     * @return The record, or null if not found
+     */
+    value read_key(std::istream& istream, const value& key) const
+    {
+        value result;
+        for_each_match(istream, key, [&](std::size_t, value& record) {
+            result = std::move(record);
+            return false;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Read all records whose key equals a value
+     *
+     * @return Records (in file order)
+     */
+    std::vector<value> read_keys(std::istream& istream, const value& key) const
+    {
+        std::vector<value> result;
+        for_each_match(istream, key, [&](std::size_t, value& record) {
+            result.push_back(std::move(record));
+            return true;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Write the index (binary, native byte order)
+     */
+    void save(std::ostream& ostream) const
+    {
+        put(ostream, magic, sizeof(magic));
+        put_u64(ostream, version);
+        put_u64(ostream, static_cast<std::uint64_t>(format) | (json5 ? 0x100 : 0));
+        put_u64(ostream, source_size);
+        put_u64(ostream, key_path.size());
+        put(ostream, key_path.data(), key_path.size());
+        put_u64(ostream, offsets.size());
+        put(ostream, offsets.data(), offsets.size() * sizeof(std::uint64_t));
+        put_u64(ostream, keys.size());
+        for (const auto& e : keys) {
+            put_u64(ostream, e.first);
+            put_u64(ostream, e.second);
+        }
+        if (!ostream) {
+            throw std::runtime_error("offset_index: cannot write");
+        }
+    }
+
+    /**
+     * @brief Read an index written by save()
+     *
+     * @throws std::runtime_error if the input is not a valid index
+     */
+    static offset_index load(std::istream& istream)
+    {
+        offset_index index;
+        char m[sizeof(magic)];
+        get(istream, m, sizeof(m));
+        if ((std::memcmp(m, magic, sizeof(magic)) != 0) || (get_u64(istream) != version)) {
+            throw std::runtime_error("offset_index: not an index");
+        }
+        const auto flags = get_u64(istream);
+        index.format = static_cast<record_format>(flags & 0xff);
+        index.json5 = (flags & 0x100) != 0;
+        index.source_size = get_u64(istream);
+        index.key_path.resize(checked_size(get_u64(istream), 1));
+        get(istream, index.key_path.data(), index.key_path.size());
+        index.offsets.resize(checked_size(get_u64(istream), sizeof(std::uint64_t)));
+        get(istream, index.offsets.data(), index.offsets.size() * sizeof(std::uint64_t));
+        index.keys.resize(checked_size(get_u64(istream), 2 * sizeof(std::uint64_t)));
+        for (auto& e : index.keys) {
+            e.first = get_u64(istream);
+            e.second = static_cast<std::size_t>(get_u64(istream));
+            if (e.second >= index.offsets.size()) {
+                throw std::runtime_error("offset_index: not an index");
+            }
+        }
+        return index;
+    }
+
+private:
+    using entry = std::pair<std::uint64_t, std::size_t>; ///< (key hash, record number)
+
+    static constexpr char magic[8] = {'J', '5', 'P', 'I', 'N', 'D', 'E', 'X'};
+    static constexpr std::uint64_t version = 1;
+
+    /**
+     * @brief Read candidates of a key and call f(n, record) for each confirmed one
+     *
+     * @param f A function returning false to stop
+     */
+    template <class F>
+    void for_each_match(std::istream& istream, const value& key, F f) const
+    {
+        if (key_path.empty()) {
+            return;
+        }
+        const pointer path(key_path);
+        const entry probe{hash_of(key), 0};
+        auto iter = std::lower_bound(keys.begin(), keys.end(), probe, [](const entry& a, const entry& b) { return a.first < b.first; });
+        for (; (iter != keys.end()) && (iter->first == probe.first); ++iter) {
+            auto record = read(istream, iter->second);
+            const value* k = path.find(record);
+            if (k && (*k == key) && !f(iter->second, record)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief FNV-1a hash of the JSON text of a key (1 and "1" differ)
+     */
+    static std::uint64_t hash_of(const value& key)
+    {
+        std::uint64_t h = 14695981039346656037ull;
+        for (const char ch : key.is_string() ? "\"" + key.as_string() : key.stringify()) {
+            h = (h ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Find starts of non-blank lines
+     *
+     * @param f A function called as f(offset, line); line is filled only if needed
+     * @return Bytes scanned
+     */
+    template <class F>
+    static std::uint64_t scan_lines(std::istream& istream, F f, bool need_line)
+    {
+        std::vector<char> buffer(1 << 20);
+        std::uint64_t base = 0;
+        std::uint64_t start = 0;  ///< Offset of current line
+        bool blank = true;        ///< Current line has only spaces so far
+        std::string line;
+        for (;;) {
+            istream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            const auto n = static_cast<std::size_t>(istream.gcount());
+            if (n == 0) {
+                break;
+            }
+            std::size_t begin = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                const char ch = buffer[i];
+                if (ch == '\n') {
+                    if (need_line) {
+                        line.append(buffer.data() + begin, i - begin);
+                    }
+                    if (!blank) {
+                        f(start, line);
+                    }
+                    line.clear();
+                    begin = i + 1;
+                    start = base + i + 1;
+                    blank = true;
+                } else if (blank && (ch != ' ') && (ch != '\t') && (ch != '\r')) {
+                    blank = false;
+                    start = base + i;
+                }
+            }
+            if (need_line) {
+                line.append(buffer.data() + begin, n - begin);
+            }
+            base += n;
+        }
+        if (!blank) {
+            f(start, line);
+        }
+        return base;
+    }
+
+    static std::size_t checked_size(std::uint64_t n, std::size_t unit)
+    {
+        if (n > (std::uint64_t(1) << 40) / unit) {
+            throw std::runtime_error("offset_index: not an index");
+        }
+        return static_cast<std::size_t>(n);
+    }
+
+    static void put(std::ostream& ostream, const void* data, std::size_t size)
+    {
+        ostream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    static void put_u64(std::ostream& ostream, std::uint64_t n) { put(ostream, &n, sizeof(n)); }
+
+    static void get(std::istream& istream, void* data, std::size_t size)
+    {
+        if (!istream.read(static_cast<char*>(data), static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("offset_index: not an index");
+        }
+    }
+
+    static std::uint64_t get_u64(std::istream& istream)
+    {
+        std::uint64_t n;
+        get(istream, &n, sizeof(n));
+        return n;
+    }
+
+    record_format format = record_format::ndjson; ///< Layout of records
+    bool json5 = false;                           ///< Records are JSON5
+    std::string key_path;                         ///< JSON pointer of indexed key
+    std::uint64_t source_size = 0;                ///< Bytes scanned when built
+    std::vector<std::uint64_t> offsets;           ///< Offset per record
+    std::vector<entry> keys;                      ///< Key hashes (sorted)
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_OFFSET_INDEX_HPP_ */
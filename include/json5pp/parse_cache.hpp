@@ -0,0 +1,191 @@
+#ifndef _JSON5PP_PARSE_CACHE_HPP_
+#define _JSON5PP_PARSE_CACHE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Content-addressed cache of parsed documents
+ *
+ * Documents are keyed by the input bytes and the parse rules. A hit returns
+ * the same immutable document which was parsed before. The cache is bounded
+ * by number of entries and total input bytes, and evicts least recently used
+ * documents first. All methods are thread-safe.
+ */
+class parse_cache
+{
+public:
+    /// Shared immutable document
+    using document = std::shared_ptr<const value>;
+
+    /**
+     * @brief Cache statistics
+     */
+    struct statistics {
+        std::size_t hits = 0;      ///< Number of lookups served from cache
+        std::size_t misses = 0;    ///< Number of lookups which parsed input
+        std::size_t evictions = 0; ///< Number of evicted documents
+        std::size_t entries = 0;   ///< Number of cached documents
+        std::size_t bytes = 0;     ///< Total input bytes of cached documents
+    };
+
+    /**
+     * @brief Construct a new parse cache object
+     *
+     * @param max_entries Maximum number of cached documents
+     * @param max_bytes Maximum total input bytes of cached documents
+     */
+    explicit parse_cache(std::size_t max_entries = 64, std::size_t max_bytes = 64 * 1024 * 1024)
+        : max_entries(max_entries), max_bytes(max_bytes) {}
+
+    parse_cache(const parse_cache&) = delete;
+    parse_cache& operator=(const parse_cache&) = delete;
+
+    /**
+     * @brief Parse string as JSON (ECMA-404 standard), or get cached document
+     *
+     * @param text A string to be parsed
+     * @return Shared immutable JSON value
+     */
+    document parse(std::string_view text)
+    {
+        return lookup<impl::flags::finished>(text);
+    }
+
+    /**
+     * @brief Parse string as JSON (JSON5), or get cached document
+     *
+     * @param text A string to be parsed
+     * @return Shared immutable JSON value
+     */
+    document parse5(std::string_view text)
+    {
+        return lookup<impl::flags::json5_rules | impl::flags::finished>(text);
+    }
+
+    /**
+     * @brief Remove all cached documents
+     *
+     * Documents already returned stay valid.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        index.clear();
+        entries.clear();
+        stats.entries = 0;
+        stats.bytes = 0;
+    }
+
+    /**
+     * @brief Get cache statistics
+     */
+    statistics get_statistics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+private:
+    struct entry {
+        std::size_t hash;
+        impl::flags_type flags;
+        std::string text; ///< Input bytes (to verify hash hits)
+        document doc;
+    };
+    using entry_list = std::list<entry>;
+
+    /**
+     * @brief Find cached document, or parse and cache it
+     *
+     * @tparam F Parser flags
+     * @param text A string to be parsed
+     * @return Shared immutable JSON value
+     */
+    template <impl::flags_type F>
+    document lookup(std::string_view text)
+    {
+        const std::size_t hash = std::hash<std::string_view>()(text) ^ (F * 0x9e3779b97f4a7c15ull);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto range = index.equal_range(hash);
+            for (auto i = range.first; i != range.second; ++i) {
+                const auto& e = *i->second;
+                if ((e.flags == F) && (e.text == text)) {
+                    // Move to most recently used
+                    entries.splice(entries.begin(), entries, i->second);
+                    ++stats.hits;
+                    return e.doc;
+                }
+            }
+            ++stats.misses;
+        }
+
+        // Parse without holding the lock
+        value v;
+        impl::imemstream istream(text.data(), text.size());
+        impl::parser<F>(istream) >> v;
+        document doc = std::make_shared<const value>(std::move(v));
+
+        if (text.size() > max_bytes) {
+            return doc;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        auto range = index.equal_range(hash);
+        for (auto i = range.first; i != range.second; ++i) {
+            const auto& e = *i->second;
+            if ((e.flags == F) && (e.text == text)) {
+                // Parsed concurrently by another thread
+                return e.doc;
+            }
+        }
+        entries.push_front(entry{hash, F, std::string(text), doc});
+        index.emplace(hash, entries.begin());
+        ++stats.entries;
+        stats.bytes += text.size();
+        while ((stats.entries > max_entries) || (stats.bytes > max_bytes)) {
+            evict();
+        }
+        return doc;
+    }
+
+    /**
+     * @brief Remove least recently used document (mutex must be held)
+     */
+    void evict()
+    {
+        const auto last = std::prev(entries.end());
+        auto range = index.equal_range(last->hash);
+        for (auto i = range.first; i != range.second; ++i) {
+            if (i->second == last) {
+                index.erase(i);
+                break;
+            }
+        }
+        --stats.entries;
+        stats.bytes -= last->text.size();
+        ++stats.evictions;
+        entries.erase(last);
+    }
+
+    const std::size_t max_entries;                                         ///< Maximum number of cached documents
+    const std::size_t max_bytes;                                           ///< Maximum total input bytes
+    mutable std::mutex mutex;                                              ///< Guards members below
+    entry_list entries;                                                    ///< Cached documents (most recently used first)
+    std::unordered_multimap<std::size_t, entry_list::iterator> index;      ///< Hash to entry
+    statistics stats;                                                      ///< Cache statistics
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_PARSE_CACHE_HPP_ */
@@ -0,0 +1,615 @@
+#ifndef _JSON5PP_PIPELINED_HPP_
+#define _JSON5PP_PIPELINED_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#define _JSON5PP_PIPELINED_FD_ 1
+#endif
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Options for pipelined streams
+ */
+struct pipelined_options {
+    std::size_t buffer_size = 1024 * 1024; ///< Size of each buffer
+    std::size_t buffer_count = 4;          ///< Number of buffers in the ring (at least 2)
+};
+
+namespace impl {
+
+/**
+ * @brief Ring of fixed-size buffers passed between two threads
+ *
+ * Buffers cycle between a free list (owned by the producer) and a queue
+ * of filled buffers (owned by the consumer). Memory use is bounded by
+ * buffer_size * buffer_count.
+ */
+class buffer_ring
+{
+public:
+    /// A filled buffer
+    struct filled {
+        std::size_t index; ///< Buffer number
+        std::size_t size;  ///< Bytes used
+    };
+
+    /**
+     * @brief Construct a new buffer ring
+     *
+     * @param options Sizes
+     * @param reserve Extra bytes allocated before each buffer
+     */
+    explicit buffer_ring(const pipelined_options& options, std::size_t reserve = 0)
+        : buffers(options.buffer_count < 2 ? 2 : options.buffer_count, std::vector<char>(reserve + (options.buffer_size < 1 ? 1 : options.buffer_size))),
+          reserve(reserve)
+    {
+        for (std::size_t i = 0; i < buffers.size(); ++i) {
+            free.push_back(i);
+        }
+    }
+
+    char* data(std::size_t index) noexcept { return buffers[index].data() + reserve; }
+    std::size_t capacity() const noexcept { return buffers.front().size() - reserve; }
+
+    /**
+     * @brief Take a free buffer (waits until one is released)
+     *
+     * @return Buffer number, or none if the ring is closed
+     */
+    std::optional<std::size_t> acquire()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return !free.empty() || closed; });
+        if (closed) {
+            return std::nullopt;
+        }
+        const auto index = free.front();
+        free.pop_front();
+        return index;
+    }
+
+    /// Give a buffer back to the free list
+    void release(std::size_t index)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            free.push_back(index);
+        }
+        cv.notify_all();
+    }
+
+    /// Queue a filled buffer (a size of 0 marks the end of data)
+    void push(std::size_t index, std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(filled{index, size});
+        }
+        cv.notify_all();
+    }
+
+    /**
+     * @brief Take the next filled buffer (waits until one is queued)
+     *
+     * @return The buffer, or none if the ring is closed
+     */
+    std::optional<filled> pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return !queue.empty() || closed; });
+        if (closed) {
+            return std::nullopt;
+        }
+        const auto f = queue.front();
+        queue.pop_front();
+        return f;
+    }
+
+    /// Wait until all buffers are free (consumer idle)
+    void drain()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return (free.size() == buffers.size()) || closed; });
+    }
+
+    /// Wake up and stop both sides
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        cv.notify_all();
+    }
+
+private:
+    std::vector<std::vector<char>> buffers; ///< All buffers
+    const std::size_t reserve;              ///< Bytes reserved before each buffer
+    std::mutex mutex;                       ///< Guards members below
+    std::condition_variable cv;             ///< Signaled on any change
+    std::deque<std::size_t> free;           ///< Free buffers
+    std::deque<filled> queue;               ///< Filled buffers (in order)
+    bool closed = false;                    ///< Stopped
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Output stream buffer which writes on a background I/O thread
+ *
+ * Output is collected into buffers of a ring; each full buffer is handed to
+ * the I/O thread which writes it to the sink while the caller fills the
+ * next one. The caller waits only when all buffers are in flight.
+ */
+class pipelined_ostreambuf : public std::streambuf
+{
+public:
+    /**
+     * @brief Write to an output stream
+     *
+     * @param sink An output stream (used only by the I/O thread until close())
+     * @param options Options
+     */
+    explicit pipelined_ostreambuf(std::ostream& sink, const pipelined_options& options = {})
+        : ring(options), sink(&sink)
+    {
+        start();
+    }
+
+#ifdef _JSON5PP_PIPELINED_FD_
+    /**
+     * @brief Write to a file descriptor (POSIX)
+     *
+     * @param fd A file descriptor (not closed)
+     * @param options Options
+     */
+    explicit pipelined_ostreambuf(int fd, const pipelined_options& options = {})
+        : ring(options), fd(fd)
+    {
+        start();
+    }
+#endif
+
+    pipelined_ostreambuf(const pipelined_ostreambuf&) = delete;
+    pipelined_ostreambuf& operator=(const pipelined_ostreambuf&) = delete;
+
+    ~pipelined_ostreambuf() override
+    {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    /**
+     * @brief Write out everything and stop the I/O thread
+     *
+     * @throws std::runtime_error if writing to the sink failed
+     */
+    void close()
+    {
+        if (!writer.joinable()) {
+            return;
+        }
+        submit();
+        ring.push(0, 0);
+        writer.join();
+        ring.close();
+        setp(nullptr, nullptr);
+        check();
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (failed || !submit() || !next()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        std::streamsize done = 0;
+        while (done < n) {
+            if (pptr() == epptr()) {
+                if (traits_type::eq_int_type(overflow(traits_type::eof()), traits_type::eof())) {
+                    break;
+                }
+            }
+            const auto chunk = std::min<std::streamsize>(n - done, epptr() - pptr());
+            traits_type::copy(pptr(), s + done, static_cast<std::size_t>(chunk));
+            pbump(static_cast<int>(chunk));
+            done += chunk;
+        }
+        return done;
+    }
+
+    /// Write out buffered data and wait until the sink has it
+    int sync() override
+    {
+        if (!writer.joinable()) {
+            return failed ? -1 : 0;
+        }
+        submit();
+        ring.drain();
+        if (!failed && sink) {
+            std::lock_guard<std::mutex> lock(sink_mutex);
+            sink->flush();
+        }
+        if (!next()) {
+            return -1;
+        }
+        return failed ? -1 : 0;
+    }
+
+private:
+    void start()
+    {
+        writer = std::thread([this] { run(); });
+        next();
+    }
+
+    /// Take the next free buffer as the put area
+    bool next()
+    {
+        current = ring.acquire();
+        if (!current) {
+            setp(nullptr, nullptr);
+            return false;
+        }
+        char* p = ring.data(*current);
+        setp(p, p + ring.capacity());
+        return true;
+    }
+
+    /// Hand the put area to the I/O thread
+    bool submit()
+    {
+        if (!current) {
+            return !failed;
+        }
+        const auto size = static_cast<std::size_t>(pptr() - pbase());
+        if (size == 0) {
+            ring.release(*current);
+        } else {
+            ring.push(*current, size);
+        }
+        current.reset();
+        setp(nullptr, nullptr);
+        return !failed;
+    }
+
+    /// I/O thread
+    void run()
+    {
+        for (;;) {
+            const auto f = ring.pop();
+            if (!f || (f->size == 0)) {
+                break;
+            }
+            if (!failed && !write_out(ring.data(f->index), f->size)) {
+                failed = true;
+            }
+            ring.release(f->index);
+        }
+        if (!failed && sink) {
+            std::lock_guard<std::mutex> lock(sink_mutex);
+            sink->flush();
+            failed = !*sink;
+        }
+    }
+
+    bool write_out(const char* data, std::size_t size)
+    {
+        if (sink) {
+            std::lock_guard<std::mutex> lock(sink_mutex);
+            return static_cast<bool>(sink->write(data, static_cast<std::streamsize>(size)));
+        }
+#ifdef _JSON5PP_PIPELINED_FD_
+        while (size > 0) {
+            const auto n = ::write(fd, data, size);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void check() const
+    {
+        if (failed) {
+            throw std::runtime_error("pipelined_ostreambuf: write failed");
+        }
+    }
+
+    impl::buffer_ring ring;             ///< Buffers
+    std::ostream* sink = nullptr;       ///< Output stream (or nullptr)
+    int fd = -1;                        ///< File descriptor (if no sink)
+    std::mutex sink_mutex;              ///< Guards sink
+    std::optional<std::size_t> current; ///< Buffer being filled
+    std::atomic<bool> failed{false};    ///< Writing to the sink failed
+    std::thread writer;                 ///< I/O thread
+};
+
+/**
+ * @brief Output stream whose writes overlap with the caller (see pipelined_ostreambuf)
+ *
+ * ```cpp
+ * json5pp::pipelined_ostream out(std::cout);   // or a file descriptor
+ * out << json5pp::rule::json5() << json5pp::rule::space_indent<2>() << v;
+ * out.close();
+ * ```
+ */
+class pipelined_ostream : public std::ostream
+{
+public:
+    explicit pipelined_ostream(std::ostream& sink, const pipelined_options& options = {})
+        : std::ostream(nullptr), buf(sink, options)
+    {
+        rdbuf(&buf);
+    }
+
+#ifdef _JSON5PP_PIPELINED_FD_
+    explicit pipelined_ostream(int fd, const pipelined_options& options = {})
+        : std::ostream(nullptr), buf(fd, options)
+    {
+        rdbuf(&buf);
+    }
+#endif
+
+    using std::ostream::operator<<;
+
+    /**
+     * @brief Stringify JSON (as operator<<(std::ostream&, const value&))
+     *
+     * @param v A value to stringify
+     * @return A new stringifier
+     */
+    impl::stringifier<0, 0> operator<<(const value& v)
+    {
+        return static_cast<std::ostream&>(*this) << v;
+    }
+
+    /**
+     * @brief Write out everything and stop the I/O thread
+     *
+     * @throws std::runtime_error if writing to the sink failed
+     */
+    void close()
+    {
+        try {
+            buf.close();
+        } catch (...) {
+            setstate(std::ios::badbit);
+            throw;
+        }
+    }
+
+private:
+    pipelined_ostreambuf buf; ///< Stream buffer
+};
+
+/**
+ * @brief Input stream buffer which reads ahead on a background I/O thread
+ *
+ * The I/O thread fills buffers of a ring from the source while the caller
+ * consumes earlier ones, and waits when all buffers are filled. Each buffer
+ * is a contiguous get area; the last bytes of the previous buffer are kept
+ * before it, so that tokens can be put back across buffer boundaries.
+ */
+class pipelined_istreambuf : public std::streambuf
+{
+public:
+    /// Bytes which can be put back across buffer boundaries
+    static constexpr std::size_t putback = 8;
+
+    /**
+     * @brief Read from an input stream
+     *
+     * Each buffer is handed over when full (or at the end of input). For
+     * pipes and sockets, a file descriptor hands over partial reads.
+     *
+     * @param source An input stream (used only by the I/O thread)
+     * @param options Options
+     */
+    explicit pipelined_istreambuf(std::istream& source, const pipelined_options& options = {})
+        : ring(options, putback), source(&source)
+    {
+        reader = std::thread([this] { run(); });
+    }
+
+#ifdef _JSON5PP_PIPELINED_FD_
+    /**
+     * @brief Read from a file descriptor (POSIX)
+     *
+     * @param fd A file descriptor (not closed)
+     * @param options Options
+     */
+    explicit pipelined_istreambuf(int fd, const pipelined_options& options = {})
+        : ring(options, putback), fd(fd)
+    {
+        reader = std::thread([this] { run(); });
+    }
+#endif
+
+    pipelined_istreambuf(const pipelined_istreambuf&) = delete;
+    pipelined_istreambuf& operator=(const pipelined_istreambuf&) = delete;
+
+    /**
+     * @brief Stop the I/O thread
+     *
+     * If input is not consumed to the end, this waits for the read in
+     * progress to return.
+     */
+    ~pipelined_istreambuf() override
+    {
+        ring.close();
+        reader.join();
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        if (done) {
+            return traits_type::eof();
+        }
+        const auto f = ring.pop();
+        if (!f || (f->size == 0)) {
+            done = true;
+            if (failed) {
+                throw std::runtime_error("pipelined_istreambuf: read failed");
+            }
+            return traits_type::eof();
+        }
+        char* base = ring.data(f->index);
+        std::size_t keep = 0;
+        if (current) {
+            keep = std::min<std::size_t>(putback, static_cast<std::size_t>(egptr() - eback()));
+            std::memcpy(base - keep, egptr() - keep, keep);
+            ring.release(*current);
+        }
+        current = f->index;
+        setg(base - keep, base, base + f->size);
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    /// I/O thread
+    void run()
+    {
+        for (;;) {
+            const auto index = ring.acquire();
+            if (!index) {
+                return;
+            }
+            const auto size = read_in(ring.data(*index), ring.capacity());
+            if (size == 0) {
+                ring.release(*index);
+                ring.push(0, 0);
+                return;
+            }
+            ring.push(*index, size);
+        }
+    }
+
+    /// Read some bytes (0 at the end of input or on error)
+    std::size_t read_in(char* data, std::size_t size)
+    {
+        if (source) {
+            source->read(data, static_cast<std::streamsize>(size));
+            if (source->bad()) {
+                failed = true;
+                return 0;
+            }
+            return static_cast<std::size_t>(source->gcount());
+        }
+#ifdef _JSON5PP_PIPELINED_FD_
+        for (;;) {
+            const auto n = ::read(fd, data, size);
+            if (n >= 0) {
+                return static_cast<std::size_t>(n);
+            }
+            if (errno != EINTR) {
+                failed = true;
+                return 0;
+            }
+        }
+#else
+        return 0;
+#endif
+    }
+
+    impl::buffer_ring ring;             ///< Buffers
+    std::istream* source = nullptr;     ///< Input stream (or nullptr)
+    int fd = -1;                        ///< File descriptor (if no source)
+    std::optional<std::size_t> current; ///< Buffer being consumed
+    bool done = false;                  ///< End of input reached
+    std::atomic<bool> failed{false};    ///< Reading from the source failed
+    std::thread reader;                 ///< I/O thread
+};
+
+/**
+ * @brief Input stream which reads ahead of the caller (see pipelined_istreambuf)
+ *
+ * ```cpp
+ * json5pp::pipelined_istream in(STDIN_FILENO);   // or any std::istream
+ * auto v = json5pp::parse(in);
+ * ```
+ */
+class pipelined_istream : public std::istream
+{
+public:
+    explicit pipelined_istream(std::istream& source, const pipelined_options& options = {})
+        : std::istream(nullptr), buf(source, options)
+    {
+        rdbuf(&buf);
+    }
+
+#ifdef _JSON5PP_PIPELINED_FD_
+    explicit pipelined_istream(int fd, const pipelined_options& options = {})
+        : std::istream(nullptr), buf(fd, options)
+    {
+        rdbuf(&buf);
+    }
+#endif
+
+private:
+    pipelined_istreambuf buf; ///< Stream buffer
+};
+
+/**
+ * @brief Stringify value to an output stream with a background I/O thread
+ *
+ * @tparam T A list of typenames of manipulators
+ * @param sink An output stream
+ * @param v A value to stringify
+ * @param options Options
+ * @param args A list of manipulators (rule::ecma404() if none)
+ * @throws std::runtime_error if writing to the sink failed
+ */
+template <class... T>
+void stringify_pipelined(std::ostream& sink, const value& v, const pipelined_options& options, const T&... args)
+{
+    pipelined_ostream out(sink, options);
+    impl::flow_stringifier(out << rule::ecma404(), args..., v);
+    out.close();
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_PIPELINED_HPP_ */
@@ -0,0 +1,235 @@
+#ifndef _JSON5PP_POINTER_HPP_
+#define _JSON5PP_POINTER_HPP_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+namespace impl {
+
+/**
+ * @brief Append "/" and an escaped reference token to a JSON pointer string
+ *
+ * @param result A JSON pointer string
+ * @param token An object key or array index (unescaped)
+ */
+inline void append_pointer_token(std::string& result, std::string_view token)
+{
+    result.push_back('/');
+    for (const char ch : token) {
+        if (ch == '~') {
+            result.append("~0");
+        } else if (ch == '/') {
+            result.append("~1");
+        } else {
+            result.push_back(ch);
+        }
+    }
+}
+
+} /* namespace impl */
+
+/**
+ * @brief JSON pointer (RFC 6901)
+ * @see https://www.rfc-editor.org/rfc/rfc6901
+ */
+class pointer
+{
+public:
+    /**
+     * @brief Construct a pointer to the root
+     */
+    pointer() = default;
+
+    /**
+     * @brief Construct a pointer from string (ex: "/foo/0/bar")
+     *
+     * @param text A JSON pointer string ("" means root)
+     * @throws std::invalid_argument if text is not a valid JSON pointer
+     */
+    explicit pointer(std::string_view text)
+    {
+        if (text.empty()) {
+            return;
+        }
+        if (text.front() != '/') {
+            throw std::invalid_argument("JSON pointer must start with '/'");
+        }
+        std::string token;
+        for (std::size_t i = 1; i <= text.size(); ++i) {
+            if ((i == text.size()) || (text[i] == '/')) {
+                list.push_back(std::move(token));
+                token.clear();
+            } else if (text[i] == '~') {
+                const char next = (i + 1 < text.size()) ? text[++i] : '\0';
+                if (next == '0') {
+                    token.push_back('~');
+                } else if (next == '1') {
+                    token.push_back('/');
+                } else {
+                    throw std::invalid_argument("JSON pointer has invalid escape");
+                }
+            } else {
+                token.push_back(text[i]);
+            }
+        }
+    }
+
+    explicit pointer(const char* text) : pointer(std::string_view(text)) {}
+
+    /**
+     * @brief Get reference tokens (unescaped)
+     */
+    const std::vector<std::string>& tokens() const noexcept { return list; }
+
+    /**
+     * @brief Test if the pointer refers to the root
+     */
+    bool empty() const noexcept { return list.empty(); }
+
+    /**
+     * @brief Get pointer to the parent (root for root)
+     */
+    pointer parent() const
+    {
+        pointer result;
+        if (!list.empty()) {
+            result.list.assign(list.begin(), list.end() - 1);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Append a reference token
+     *
+     * @param token An object key or array index (unescaped)
+     * @return A reference to self
+     */
+    pointer& append(std::string token)
+    {
+        list.push_back(std::move(token));
+        return *this;
+    }
+
+    /**
+     * @brief Append an array index
+     *
+     * @param index An array index
+     * @return A reference to self
+     */
+    pointer& append(std::size_t index)
+    {
+        return append(std::to_string(index));
+    }
+
+    /**
+     * @brief Remove the last reference token (if any)
+     *
+     * @return A reference to self
+     */
+    pointer& pop()
+    {
+        if (!list.empty()) {
+            list.pop_back();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Get JSON pointer string
+     */
+    std::string to_string() const
+    {
+        std::string result;
+        for (const auto& token : list) {
+            impl::append_pointer_token(result, token);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Find the referenced value
+     *
+     * @param root A document
+     * @return A pointer to the value, nullptr if not found
+     */
+    const value* find(const value& root) const
+    {
+        const value* v = &root;
+        for (const auto& token : list) {
+            v = step(*v, token);
+            if (!v) {
+                break;
+            }
+        }
+        return v;
+    }
+
+    /**
+     * @brief Find the referenced value
+     *
+     * @param root A document
+     * @return A pointer to the value, nullptr if not found
+     */
+    value* find(value& root) const
+    {
+        return const_cast<value*>(find(static_cast<const value&>(root)));
+    }
+
+    /**
+     * @brief Parse token as array index
+     *
+     * @param token A reference token
+     * @param index [output] Parsed index
+     * @retval true Token is an array index (digits without leading zero)
+     */
+    static bool to_index(const std::string& token, std::size_t& index)
+    {
+        if (token.empty() || (token.size() > 1 && token[0] == '0') || (token.size() > 18)) {
+            return false;
+        }
+        index = 0;
+        for (const char ch : token) {
+            if ((ch < '0') || (ch > '9')) {
+                return false;
+            }
+            index = index * 10 + static_cast<std::size_t>(ch - '0');
+        }
+        return true;
+    }
+
+    friend bool operator==(const pointer& a, const pointer& b) { return a.list == b.list; }
+
+private:
+    /**
+     * @brief Step into a member or an element
+     */
+    static const value* step(const value& v, const std::string& token)
+    {
+        if (v.is_object()) {
+            const auto& members = v.as_object();
+            auto iter = members.find(token);
+            return (iter != members.end()) ? &iter->second : nullptr;
+        }
+        if (v.is_array()) {
+            const auto& elements = v.as_array();
+            std::size_t index;
+            if (to_index(token, index) && (index < elements.size())) {
+                return &elements[index];
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<std::string> list; ///< Reference tokens (unescaped)
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_POINTER_HPP_ */
@@ -0,0 +1,288 @@
+#ifndef _JSON5PP_POOL_HPP_
+#define _JSON5PP_POOL_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Memory pool with size-class free lists for long-lived mutable documents
+ *
+ * Blocks up to max_block_size bytes are carved from chunks and recycled
+ * through a free list per size class, so churn of values, map nodes and
+ * strings reuses memory instead of fragmenting the global heap. Larger
+ * blocks are passed to operator new. Memory is returned to the system when
+ * the pool is destroyed (or by release() when nothing is in use).
+ *
+ * A pool is a std::pmr::memory_resource: a document of a value type with
+ * pmr containers and strings (ex: pmr_value) allocates from the pool
+ * given to parse() / array() / object(). Blocks are allocated with
+ * allocate(size, align) of memory_resource; blocks aligned to more than
+ * alignment are not pooled.
+ *
+ * A pool is not thread-safe; use one pool per document and guard it as
+ * the document itself.
+ *
+ * ```cpp
+ * json5pp::node_pool pool;
+ * auto doc = json5pp::parse<json5pp::pmr_value>(text, &pool);
+ * doc["list"] = json5pp::array<json5pp::pmr_value>({1, 2}, &pool);
+ * ```
+ */
+class node_pool : public std::pmr::memory_resource
+{
+public:
+    /// Size classes (multiples of alignment); on 64-bit targets a value is 56 bytes and a node of object_type is 120 bytes
+    static constexpr std::array<std::size_t, 15> class_sizes = {16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 120, 128, 160, 192, 256};
+    static constexpr std::size_t classes = class_sizes.size();
+    static constexpr std::size_t max_block_size = class_sizes.back();
+    /// Alignment of pooled blocks (blocks with larger alignment are not pooled)
+    static constexpr std::size_t alignment = alignof(void*);
+
+    /**
+     * @brief Statistics of a size class (or of the whole pool)
+     */
+    struct statistics {
+        std::size_t allocations = 0;   ///< Number of allocations
+        std::size_t deallocations = 0; ///< Number of deallocations
+        std::size_t reuses = 0;        ///< Allocations served from a free list
+        std::size_t in_use = 0;        ///< Blocks in use
+        std::size_t free = 0;          ///< Blocks in free list
+        std::size_t carved = 0;        ///< Blocks carved from chunks
+
+        /// Ratio of allocations served from a free list
+        double reuse_rate() const noexcept { return allocations ? static_cast<double>(reuses) / static_cast<double>(allocations) : 0.0; }
+    };
+
+    /**
+     * @brief Construct a new pool
+     *
+     * @param chunk_size Size of a chunk carved into blocks
+     */
+    explicit node_pool(std::size_t chunk_size = 64 * 1024) : chunk_size(std::max(chunk_size, max_block_size)) {}
+
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    ~node_pool() override { release_chunks(); }
+
+    /**
+     * @brief Get statistics of a size class
+     *
+     * @param c Index of the size class (classes for blocks larger than max_block_size)
+     */
+    const statistics& get_statistics(std::size_t c) const noexcept { return (c < classes) ? stats[c] : large; }
+
+    /**
+     * @brief Get total statistics of all size classes (and large blocks)
+     */
+    statistics get_statistics() const noexcept
+    {
+        statistics total = large;
+        for (const auto& s : stats) {
+            total.allocations += s.allocations;
+            total.deallocations += s.deallocations;
+            total.reuses += s.reuses;
+            total.in_use += s.in_use;
+            total.free += s.free;
+            total.carved += s.carved;
+        }
+        return total;
+    }
+
+    /// Bytes reserved from the system for chunks
+    std::size_t reserved() const noexcept { return chunks.size() * chunk_size; }
+
+    /**
+     * @brief Return all chunks to the system if no pooled block is in use
+     *
+     * @retval true Released
+     * @retval false Some blocks are in use
+     */
+    bool release() noexcept
+    {
+        for (const auto& s : stats) {
+            if (s.in_use) {
+                return false;
+            }
+        }
+        release_chunks();
+        for (std::size_t c = 0; c < classes; ++c) {
+            free_lists[c] = nullptr;
+            stats[c].free = 0;
+        }
+        cursor = limit = nullptr;
+        return true;
+    }
+
+private:
+    struct node {
+        node* next;
+    };
+
+    void* do_allocate(std::size_t size, std::size_t align) override { return allocate_block(size, align); }
+
+    void do_deallocate(void* p, std::size_t size, std::size_t align) override { deallocate_block(p, size, align); }
+
+    /**
+     * @brief Allocate a block
+     *
+     * @param size Size in bytes
+     * @param align Alignment
+     * @return Allocated block
+     * @throws std::bad_alloc on failure
+     */
+    void* allocate_block(std::size_t size, std::size_t align)
+    {
+        const std::size_t c = class_of(size, align);
+        if (c == classes) {
+            ++large.allocations;
+            ++large.in_use;
+            return ::operator new(size, std::align_val_t(std::max(align, alignof(std::max_align_t))));
+        }
+        auto& s = stats[c];
+        ++s.allocations;
+        ++s.in_use;
+        if (free_lists[c]) {
+            ++s.reuses;
+            --s.free;
+            node* n = free_lists[c];
+            free_lists[c] = n->next;
+            return n;
+        }
+        ++s.carved;
+        return carve(class_sizes[c]);
+    }
+
+    /**
+     * @brief Deallocate a block
+     *
+     * @param p A block returned by allocate_block()
+     * @param size Size passed to allocate_block()
+     * @param align Alignment passed to allocate_block()
+     */
+    void deallocate_block(void* p, std::size_t size, std::size_t align) noexcept
+    {
+        const std::size_t c = class_of(size, align);
+        if (c == classes) {
+            ++large.deallocations;
+            --large.in_use;
+            ::operator delete(p, std::align_val_t(std::max(align, alignof(std::max_align_t))));
+            return;
+        }
+        auto& s = stats[c];
+        ++s.deallocations;
+        --s.in_use;
+        ++s.free;
+        node* n = static_cast<node*>(p);
+        n->next = free_lists[c];
+        free_lists[c] = n;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    /**
+     * @brief Get size class of a block (classes for large blocks)
+     */
+    static std::size_t class_of(std::size_t size, std::size_t align) noexcept
+    {
+        if ((size > max_block_size) || (align > alignment)) {
+            return classes;
+        }
+        std::size_t c = 0;
+        while (class_sizes[c] < size) {
+            ++c;
+        }
+        return c;
+    }
+
+    /**
+     * @brief Carve a new block from the current chunk
+     */
+    void* carve(std::size_t size)
+    {
+        if (static_cast<std::size_t>(limit - cursor) < size) {
+            // the tail of the current chunk (less than max_block_size) is left unused
+            chunks.push_back(static_cast<char*>(::operator new(chunk_size, std::align_val_t(alignment))));
+            cursor = chunks.back();
+            limit = cursor + chunk_size;
+        }
+        void* p = cursor;
+        cursor += size;
+        return p;
+    }
+
+    void release_chunks() noexcept
+    {
+        for (auto* chunk : chunks) {
+            ::operator delete(chunk, std::align_val_t(alignment));
+        }
+        chunks.clear();
+    }
+
+    std::size_t chunk_size;                      ///< Size of a chunk
+    std::vector<char*> chunks;                   ///< Chunks reserved from the system
+    char* cursor = nullptr;                      ///< Next free byte in the current chunk
+    char* limit = nullptr;                       ///< End of the current chunk
+    std::array<node*, classes> free_lists = {};  ///< Free list per size class
+    std::array<statistics, classes> stats = {};  ///< Statistics per size class
+    statistics large;                            ///< Statistics of large blocks
+};
+
+/**
+ * @brief Standard allocator which allocates from a node_pool
+ *
+ * For a container owned by the caller. The allocator has no default
+ * constructor, so it cannot be an allocator of storage types of values;
+ * use std::pmr containers with the pool as their resource instead.
+ *
+ * ```cpp
+ * json5pp::node_pool pool;
+ * std::map<std::string, int, std::less<>, json5pp::pool_allocator<std::pair<const std::string, int>>> m(pool);
+ * ```
+ *
+ * @tparam T A type of elements
+ */
+template <class T>
+class pool_allocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    pool_allocator(node_pool& pool) noexcept : pool(&pool) {}
+
+    template <class U>
+    pool_allocator(const pool_allocator<U>& other) noexcept : pool(other.pool) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(pool->allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T* p, std::size_t n) noexcept { pool->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    /// The pool
+    node_pool& resource() const noexcept { return *pool; }
+
+    template <class U>
+    friend bool operator==(const pool_allocator& a, const pool_allocator<U>& b) noexcept { return &a.resource() == &b.resource(); }
+
+private:
+    template <class U>
+    friend class pool_allocator;
+
+    node_pool* pool; ///< The pool
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_POOL_HPP_ */
@@ -0,0 +1,247 @@
+#ifndef _JSON5PP_PULL_PARSER_HPP_
+#define _JSON5PP_PULL_PARSER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "json5pp.hpp"
+#include "record_reader.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Event of pull parser
+ */
+enum class parse_event : std::uint8_t {
+    begin_object,
+    end_object,
+    begin_array,
+    end_array,
+    key,    ///< Object key (key() holds it)
+    scalar, ///< Null, boolean, number or string (scalar() holds it)
+    end_of_input,
+};
+
+/**
+ * @brief Pull (event) parser which reads input without building a tree
+ *
+ * next() returns one event at a time. Memory use is bounded by the nesting
+ * depth and the largest key or scalar. Concatenated documents (ex: NDJSON)
+ * are read one after another.
+ *
+ * ```cpp
+ * json5pp::pull_parser p(ifs);
+ * for (auto e = p.next(); e != json5pp::parse_event::end_of_input; e = p.next()) {
+ *     if (e == json5pp::parse_event::key && p.key() == "items") ...
+ * }
+ * ```
+ */
+class pull_parser
+{
+public:
+    /**
+     * @brief Construct a new pull parser
+     *
+     * @param istream An input stream
+     * @param json5 If true, parse as JSON5
+     */
+    explicit pull_parser(std::istream& istream, bool json5 = false)
+        : buf(istream.rdbuf(), 0), stream(&buf), json5(json5) {}
+
+    pull_parser(const pull_parser&) = delete;
+    pull_parser& operator=(const pull_parser&) = delete;
+
+    /**
+     * @brief Read the next event
+     *
+     * @throws json5pp::syntax_error on a syntax error
+     */
+    parse_event next()
+    {
+        using namespace impl;
+        last = json5 ? next_event<flags::json5_rules>() : next_event<0>();
+        return last;
+    }
+
+    /// The last event
+    parse_event event() const noexcept { return last; }
+
+    /// Key of the last key event
+    const std::string& key() const noexcept { return current_key; }
+
+    /// Value of the last scalar event
+    const value& scalar() const noexcept { return current; }
+
+    /// Nesting depth (number of open containers)
+    std::size_t depth() const noexcept { return stack.size(); }
+
+    /// Byte offset of the first character of the last event
+    std::uint64_t offset() const noexcept { return token_offset; }
+
+    /// Byte offset of the next character to read
+    std::uint64_t position() const { return buf.position(); }
+
+    /**
+     * @brief Read the rest of the current value as a tree
+     *
+     * After a begin event, reads the container up to its end (the end event
+     * is consumed). After a scalar event, returns the scalar.
+     */
+    value read_value()
+    {
+        using namespace impl;
+        value v;
+        if ((last == parse_event::begin_object) || (last == parse_event::begin_array)) {
+            if (json5) {
+                read_container<flags::json5_rules>(v);
+            } else {
+                read_container<0>(v);
+            }
+        } else if (last == parse_event::scalar) {
+            v = current;
+        }
+        return v;
+    }
+
+    /**
+     * @brief Skip the rest of the current value
+     *
+     * After a begin event, skips events up to the matching end event.
+     */
+    void skip()
+    {
+        if ((last != parse_event::begin_object) && (last != parse_event::begin_array)) {
+            return;
+        }
+        const std::size_t target = stack.size() - 1;
+        while (stack.size() > target) {
+            if (next() == parse_event::end_of_input) {
+                break;
+            }
+        }
+    }
+
+private:
+    struct frame {
+        bool object;     ///< Object or array
+        bool value_next; ///< Object: key is read, value is next
+        std::size_t count; ///< Number of elements / members read
+    };
+
+    template <impl::flags_type F>
+    parse_event next_event()
+    {
+        static const char context[] = "pull";
+        impl::parser<F> parser(stream);
+        if (stack.empty()) {
+            int ch = parser.skip_spaces();
+            if (ch == std::char_traits<char>::eof()) {
+                token_offset = buf.position();
+                return parse_event::end_of_input;
+            }
+            stream.unget();
+            return begin_value(parser);
+        }
+
+        frame& f = stack.back();
+        if (f.value_next) {
+            f.value_next = false;
+            return begin_value(parser);
+        }
+        int ch = parser.skip_spaces();
+        const int close = f.object ? '}' : ']';
+        if (ch == close) {
+            return end_container();
+        }
+        if (f.count > 0) {
+            if (ch != ',') {
+                throw syntax_error(ch, context);
+            }
+            ch = parser.skip_spaces();
+            if ((ch == close) && (F & impl::flags::trailing_comma)) {
+                return end_container();
+            }
+        }
+        if ((ch == std::char_traits<char>::eof()) || (ch == close)) {
+            throw syntax_error(ch, context);
+        }
+        stream.unget();
+        ++f.count;
+        if (!f.object) {
+            return begin_value(parser);
+        }
+        token_offset = buf.position();
+        current_key = parser.parse_key();
+        ch = parser.skip_spaces();
+        if (ch != ':') {
+            throw syntax_error(ch, context);
+        }
+        f.value_next = true;
+        return parse_event::key;
+    }
+
+    template <impl::flags_type F>
+    parse_event begin_value(impl::parser<F>& parser)
+    {
+        static const char context[] = "value";
+        const int ch = parser.skip_spaces();
+        token_offset = buf.position() - 1;
+        if (ch == '{') {
+            stack.push_back(frame{true, false, 0});
+            return parse_event::begin_object;
+        }
+        if (ch == '[') {
+            stack.push_back(frame{false, false, 0});
+            return parse_event::begin_array;
+        }
+        if (ch == std::char_traits<char>::eof()) {
+            throw syntax_error(ch, context);
+        }
+        stream.unget();
+        parser.parse_value(current, context);
+        return parse_event::scalar;
+    }
+
+    parse_event end_container()
+    {
+        token_offset = buf.position() - 1;
+        const bool object = stack.back().object;
+        stack.pop_back();
+        return object ? parse_event::end_object : parse_event::end_array;
+    }
+
+    /**
+     * @brief Parse the rest of a container just begun (with the parser of the tree API)
+     */
+    template <impl::flags_type F>
+    void read_container(value& v)
+    {
+        impl::parser<F> parser(stream);
+        const frame f = stack.back();
+        stack.pop_back();
+        if (f.object) {
+            parser.parse_object(v);
+            last = parse_event::end_object;
+        } else {
+            parser.parse_array(v);
+            last = parse_event::end_array;
+        }
+        token_offset = buf.position() - 1;
+    }
+
+    impl::counting_streambuf buf; ///< Counting stream buffer over the input
+    std::istream stream;          ///< A stream over buf
+    const bool json5;             ///< Parse as JSON5
+    std::vector<frame> stack;     ///< Open containers
+    parse_event last = parse_event::end_of_input; ///< The last event
+    std::string current_key;      ///< The last key
+    value current;                ///< The last scalar
+    std::uint64_t token_offset = 0; ///< Offset of the last event
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_PULL_PARSER_HPP_ */
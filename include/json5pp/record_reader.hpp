@@ -0,0 +1,275 @@
+#ifndef _JSON5PP_RECORD_READER_HPP_
+#define _JSON5PP_RECORD_READER_HPP_
+
+#include <cstdint>
+#include <istream>
+#include <stdexcept>
+#include <streambuf>
+#include <vector>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Layout of records in an input
+ */
+enum class record_format : std::uint8_t {
+    ndjson, ///< Values separated by spaces or newlines (NDJSON / concatenated JSON)
+    array,  ///< Elements of a top-level array
+};
+
+/**
+ * @brief Resumable position of a record_reader
+ *
+ * A checkpoint is taken at a record boundary and holds everything needed to
+ * continue reading from there: the byte offset and the framing state.
+ */
+struct checkpoint {
+    std::uint64_t offset = 0;                   ///< Byte offset of the next record (from the beginning of input)
+    std::uint64_t records = 0;                  ///< Number of records read before offset
+    record_format format = record_format::ndjson; ///< Layout of records
+    std::uint8_t state = 0;                     ///< Framing state (record_format::array only)
+
+    /**
+     * @brief Convert to JSON value (to store the checkpoint durably)
+     */
+    value to_value() const
+    {
+        return json5pp::object({
+            {"offset", static_cast<long long>(offset)},
+            {"records", static_cast<long long>(records)},
+            {"format", (format == record_format::array) ? "array" : "ndjson"},
+            {"state", static_cast<int>(state)},
+        });
+    }
+
+    /**
+     * @brief Restore from JSON value made by to_value()
+     *
+     * @throws std::bad_cast if the value is not a checkpoint
+     */
+    static checkpoint from_value(const value& v)
+    {
+        checkpoint cp;
+        cp.offset = static_cast<std::uint64_t>(v["offset"].get<long long>());
+        cp.records = static_cast<std::uint64_t>(v["records"].get<long long>());
+        cp.format = (v["format"].as_string() == "array") ? record_format::array : record_format::ndjson;
+        cp.state = static_cast<std::uint8_t>(v["state"].get<int>());
+        return cp;
+    }
+};
+
+namespace impl {
+
+/**
+ * @brief Buffered stream buffer which counts consumed bytes
+ */
+class counting_streambuf : public std::streambuf
+{
+public:
+    /**
+     * @brief Construct a new counting stream buffer
+     *
+     * @param source A stream buffer to read from
+     * @param offset Byte offset of the current position of source
+     * @param size Size of the read buffer
+     */
+    counting_streambuf(std::streambuf* source, std::uint64_t offset, std::size_t size = 64 * 1024)
+        : source(source), buffer(size + 1), base(offset)
+    {
+        setg(buffer.data(), buffer.data() + 1, buffer.data() + 1);
+    }
+
+    /**
+     * @brief Get byte offset of the next character to read
+     */
+    std::uint64_t position() const
+    {
+        return base + static_cast<std::uint64_t>(gptr() - (buffer.data() + 1));
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        const auto consumed = egptr() - (buffer.data() + 1);
+        if (consumed > 0) {
+            // Keep the last character for putback
+            base += static_cast<std::uint64_t>(consumed);
+            buffer[0] = egptr()[-1];
+        }
+        const auto n = source->sgetn(buffer.data() + 1, static_cast<std::streamsize>(buffer.size() - 1));
+        setg(buffer.data(), buffer.data() + 1, buffer.data() + 1 + (n > 0 ? n : 0));
+        if (n <= 0) {
+            return traits_type::eof();
+        }
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    std::streambuf* source;  ///< A stream buffer to read from
+    std::vector<char> buffer; ///< Read buffer (with one putback character)
+    std::uint64_t base;      ///< Byte offset of buffer[1]
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Reader of records (NDJSON or top-level array elements) with checkpoints
+ *
+ * get_checkpoint() can be called after any read(). A new reader constructed
+ * from that checkpoint continues with the next record without rescanning
+ * the records before it.
+ */
+class record_reader
+{
+public:
+    /**
+     * @brief Construct a reader from the current position of input
+     *
+     * @param istream An input stream (positioned at the beginning of input)
+     * @param format Layout of records
+     * @param json5 If true, parse records as JSON5
+     */
+    explicit record_reader(std::istream& istream, record_format format = record_format::ndjson, bool json5 = false)
+        : buf(istream.rdbuf(), 0), stream(&buf), json5(json5)
+    {
+        cp.format = format;
+    }
+
+    /**
+     * @brief Construct a reader resuming from a checkpoint
+     *
+     * @param istream A seekable input stream
+     * @param from A checkpoint taken by get_checkpoint()
+     * @param json5 If true, parse records as JSON5
+     * @throws std::runtime_error if the input cannot be positioned at the checkpoint
+     */
+    record_reader(std::istream& istream, const checkpoint& from, bool json5 = false)
+        : buf(seek(istream, from.offset), from.offset), stream(&buf), json5(json5), cp(from)
+    {
+    }
+
+    record_reader(const record_reader&) = delete;
+    record_reader& operator=(const record_reader&) = delete;
+
+    /**
+     * @brief Read the next record
+     *
+     * @param v A value to store the record
+     * @retval true A record is read
+     * @retval false No more records
+     * @throws json5pp::syntax_error on a syntax error
+     */
+    bool read(value& v)
+    {
+        using namespace impl;
+        const bool found = json5 ? read_record<flags::json5_rules>(v) : read_record<0>(v);
+        if (found) {
+            ++cp.records;
+            cp.offset = buf.position();
+        }
+        return found;
+    }
+
+    /**
+     * @brief Get checkpoint after the last record read
+     */
+    const checkpoint& get_checkpoint() const noexcept { return cp; }
+
+private:
+    enum : std::uint8_t {
+        array_open = 0,  ///< Before '['
+        array_first = 1, ///< Before the first element
+        array_next = 2,  ///< After an element
+        array_end = 3,   ///< After ']'
+    };
+
+    static std::streambuf* seek(std::istream& istream, std::uint64_t offset)
+    {
+        if (!istream.seekg(static_cast<std::streamoff>(offset))) {
+            throw std::runtime_error("record_reader: cannot seek to checkpoint");
+        }
+        return istream.rdbuf();
+    }
+
+    /**
+     * @brief Find and parse the next record
+     *
+     * @tparam F Parser flags
+     * @param v A value to store the record
+     * @retval true A record is read
+     * @retval false No more records
+     */
+    template <impl::flags_type F>
+    bool read_record(value& v)
+    {
+        static const char context[] = "records";
+        impl::parser<F> parser(stream);
+        if (cp.format == record_format::ndjson) {
+            int ch = parser.skip_spaces();
+            if (ch == std::char_traits<char>::eof()) {
+                return false;
+            }
+            stream.unget();
+            parser.parse_value(v, context);
+            return true;
+        }
+        for (;;) {
+            int ch = parser.skip_spaces();
+            switch (cp.state) {
+            case array_open:
+                if (ch != '[') {
+                    throw syntax_error(ch, context);
+                }
+                cp.state = array_first;
+                continue;
+            case array_first:
+                if (ch == ']') {
+                    cp.state = array_end;
+                    continue;
+                }
+                stream.unget();
+                break;
+            case array_next:
+                if (ch == ']') {
+                    cp.state = array_end;
+                    continue;
+                }
+                if (ch != ',') {
+                    throw syntax_error(ch, context);
+                }
+                if (F & impl::flags::trailing_comma) {
+                    ch = parser.skip_spaces();
+                    if (ch == ']') {
+                        cp.state = array_end;
+                        continue;
+                    }
+                    stream.unget();
+                }
+                break;
+            default:
+                if (ch != std::char_traits<char>::eof()) {
+                    throw syntax_error(ch, context);
+                }
+                cp.offset = buf.position();
+                return false;
+            }
+            parser.parse_value(v, context);
+            cp.state = array_next;
+            return true;
+        }
+    }
+
+    impl::counting_streambuf buf; ///< Counting stream buffer over the input
+    std::istream stream;          ///< A stream over buf
+    const bool json5;             ///< Parse as JSON5
+    checkpoint cp;                ///< Position after the last record
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_RECORD_READER_HPP_ */
@@ -0,0 +1,352 @@
+#ifndef _JSON5PP_REDACT_HPP_
+#define _JSON5PP_REDACT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json5pp.hpp"
+#include "pointer.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Compiled set of members to hide when stringifying
+ *
+ * Patterns are JSON pointers (ex: "/user/password") whose tokens may be
+ * "*" (any one key or array index) or "**" (any number of levels, also
+ * none). A trailing "**" matches one or more levels: "/a/ **" (without
+ * spaces) matches all members below "/a" but not "/a" itself. A pattern
+ * without leading "/" is a key path at any depth ("token" is the same as
+ * "/ ** /token").
+ *
+ * Members are matched while the stringifier walks the tree, so the value
+ * is not copied. Build a redaction once and reuse it for many documents.
+ */
+class redaction
+{
+public:
+    using action = impl::member_filter::action;
+
+    class matcher;
+
+    /**
+     * @brief Leave out members matching a pattern
+     *
+     * @param pattern A pattern
+     * @return A reference to self
+     * @throws std::invalid_argument if the pattern is invalid
+     */
+    redaction& omit(std::string_view pattern)
+    {
+        add(pattern, action::omit, 0);
+        return *this;
+    }
+
+    /**
+     * @brief Replace values of members matching a pattern with the mask text
+     *
+     * @param pattern A pattern
+     * @return A reference to self
+     * @throws std::invalid_argument if the pattern is invalid
+     */
+    redaction& mask(std::string_view pattern)
+    {
+        add(pattern, action::mask, 0);
+        return *this;
+    }
+
+    /**
+     * @brief Cut strings of members matching a pattern (other values are kept)
+     *
+     * @param pattern A pattern
+     * @param length Maximum length in bytes (followed by "...")
+     * @return A reference to self
+     * @throws std::invalid_argument if the pattern is invalid
+     */
+    redaction& truncate(std::string_view pattern, std::size_t length)
+    {
+        add(pattern, action::truncate, length);
+        return *this;
+    }
+
+    /**
+     * @brief Set the text written for masked members (default: "***")
+     *
+     * @param text A text
+     * @return A reference to self
+     */
+    redaction& mask_text(std::string text)
+    {
+        mask_string = std::move(text);
+        return *this;
+    }
+
+    /**
+     * @brief Get the text written for masked members
+     */
+    const std::string& get_mask_text() const noexcept { return mask_string; }
+
+private:
+    static constexpr std::uint32_t none = ~std::uint32_t(0);
+
+    /**
+     * @brief A node of the pattern trie
+     */
+    struct node {
+        std::map<std::string, std::uint32_t, std::less<>> children; ///< Children by key
+        std::uint32_t any = none;                                   ///< Child for "*"
+        std::uint32_t deep = none;                                  ///< Child for "**"
+        bool recursive = false;                                     ///< This node is "**"
+        action act = action::keep;                                  ///< Action of patterns ending here
+        std::size_t length = 0;                                     ///< Length limit (action::truncate)
+    };
+
+    /**
+     * @brief Add a pattern to the trie
+     */
+    void add(std::string_view pattern, action act, std::size_t length)
+    {
+        if (pattern.empty()) {
+            throw std::invalid_argument("redaction: pattern must not be empty");
+        }
+        std::vector<std::string> tokens;
+        if (pattern.front() == '/') {
+            tokens = pointer(pattern).tokens();
+        } else {
+            tokens = pointer("/" + std::string(pattern)).tokens();
+            tokens.insert(tokens.begin(), "**");
+        }
+        if (tokens.back() == "**") {
+            // descendants only
+            tokens.insert(tokens.end() - 1, "*");
+        }
+        std::uint32_t n = 0;
+        for (const auto& token : tokens) {
+            std::uint32_t next;
+            if (token == "**") {
+                next = nodes[n].deep;
+            } else if (token == "*") {
+                next = nodes[n].any;
+            } else {
+                auto iter = nodes[n].children.find(token);
+                next = (iter != nodes[n].children.end()) ? iter->second : none;
+            }
+            if (next == none) {
+                next = static_cast<std::uint32_t>(nodes.size());
+                nodes.emplace_back();
+                nodes.back().recursive = (token == "**");
+                if (token == "**") {
+                    nodes[n].deep = next;
+                } else if (token == "*") {
+                    nodes[n].any = next;
+                } else {
+                    nodes[n].children.emplace(token, next);
+                }
+            }
+            n = next;
+        }
+        merge(nodes[n].act, nodes[n].length, act, length);
+    }
+
+    /**
+     * @brief Merge actions of patterns matching the same member
+     *
+     * omit wins over mask, mask wins over truncate, and the shortest
+     * length wins among truncates.
+     */
+    static void merge(action& act, std::size_t& length, action other, std::size_t other_length)
+    {
+        constexpr auto strength = [](action a) {
+            switch (a) {
+            case action::omit:
+                return 3;
+            case action::mask:
+                return 2;
+            case action::truncate:
+                return 1;
+            default:
+                return 0;
+            }
+        };
+        if ((act == action::truncate) && (other == action::truncate)) {
+            length = std::min(length, other_length);
+        } else if (strength(other) > strength(act)) {
+            act = other;
+            length = other_length;
+        }
+    }
+
+    std::vector<node> nodes{1};     ///< Pattern trie (nodes[0] is the root)
+    std::string mask_string = "***"; ///< Text of masked members
+};
+
+/**
+ * @brief Member filter matching a redaction while stringifying
+ *
+ * Holds the set of trie nodes active at each level; one matcher serves one
+ * stringify at a time.
+ */
+class redaction::matcher final : public impl::member_filter
+{
+public:
+    /**
+     * @brief Construct a matcher
+     *
+     * @param rules A redaction (must outlive the matcher)
+     */
+    explicit matcher(const redaction& rules) : rules(rules)
+    {
+        starts.push_back(0);
+        add_closure(0, 0);
+    }
+
+    action enter(std::string_view key) override
+    {
+        const std::size_t begin = starts.back();
+        const std::size_t end = active.size();
+        starts.push_back(end);
+        action result = action::keep;
+        length = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& n = rules.nodes[active[i]];
+            if (n.recursive) {
+                add(active[i], end);
+            }
+            if (!n.children.empty()) {
+                auto iter = n.children.find(key);
+                if (iter != n.children.end()) {
+                    add_closure(iter->second, end);
+                }
+            }
+            if (n.any != none) {
+                add_closure(n.any, end);
+            }
+        }
+        for (std::size_t i = end; i < active.size(); ++i) {
+            const auto& n = rules.nodes[active[i]];
+            redaction::merge(result, length, n.act, n.length);
+        }
+        return result;
+    }
+
+    void leave() override
+    {
+        active.resize(starts.back());
+        starts.pop_back();
+    }
+
+    std::string_view mask_text() const override { return rules.mask_string; }
+
+    std::size_t truncate_length() const override { return length; }
+
+private:
+    /**
+     * @brief Add a node to the set of the current level
+     */
+    void add(std::uint32_t n, std::size_t begin)
+    {
+        if (std::find(active.begin() + static_cast<std::ptrdiff_t>(begin), active.end(), n) == active.end()) {
+            active.push_back(n);
+        }
+    }
+
+    /**
+     * @brief Add a node and "**" nodes following it (they also match no level)
+     */
+    void add_closure(std::uint32_t n, std::size_t begin)
+    {
+        for (; n != none; n = rules.nodes[n].deep) {
+            add(n, begin);
+        }
+    }
+
+    const redaction& rules;            ///< Patterns
+    std::vector<std::uint32_t> active; ///< Active nodes of all levels
+    std::vector<std::size_t> starts;   ///< Start of each level in active
+    std::size_t length = 0;            ///< Length limit of the member entered last
+};
+
+/**
+ * @brief Stringify value with redaction (ECMA-404 standard)
+ *
+ * @tparam Traits Storage types of value
+ * @tparam T A list of typenames of manipulators
+ * @param v A value to stringify
+ * @param rules Members to hide
+ * @param args A list of manipulators
+ * @return JSON string
+ */
+template <class Traits, class... T>
+std::string stringify_redacted(const basic_value<Traits>& v, const redaction& rules, const T&... args)
+{
+    std::ostringstream ostream;
+    redaction::matcher matcher(rules);
+    impl::flow_stringifier(impl::stringifier<0, 0>(ostream, &matcher) << rule::ecma404(), args..., v);
+    return ostream.str();
+}
+
+/**
+ * @brief Stringify value with redaction (JSON5)
+ *
+ * @tparam Traits Storage types of value
+ * @tparam T A list of typenames of manipulators
+ * @param v A value to stringify
+ * @param rules Members to hide
+ * @param args A list of manipulators
+ * @return JSON string
+ */
+template <class Traits, class... T>
+std::string stringify5_redacted(const basic_value<Traits>& v, const redaction& rules, const T&... args)
+{
+    std::ostringstream ostream;
+    redaction::matcher matcher(rules);
+    impl::flow_stringifier(impl::stringifier<0, 0>(ostream, &matcher) << rule::json5(), args..., v);
+    return ostream.str();
+}
+
+/**
+ * @brief Write value with redaction to an output stream (ECMA-404 standard)
+ *
+ * @tparam Traits Storage types of value
+ * @tparam T A list of typenames of manipulators
+ * @param ostream An output stream
+ * @param v A value to stringify
+ * @param rules Members to hide
+ * @param args A list of manipulators
+ */
+template <class Traits, class... T>
+void stringify_redacted(std::ostream& ostream, const basic_value<Traits>& v, const redaction& rules, const T&... args)
+{
+    redaction::matcher matcher(rules);
+    impl::flow_stringifier(impl::stringifier<0, 0>(ostream, &matcher) << rule::ecma404(), args..., v);
+}
+
+/**
+ * @brief Write value with redaction to an output stream (JSON5)
+ *
+ * @tparam Traits Storage types of value
+ * @tparam T A list of typenames of manipulators
+ * @param ostream An output stream
+ * @param v A value to stringify
+ * @param rules Members to hide
+ * @param args A list of manipulators
+ */
+template <class Traits, class... T>
+void stringify5_redacted(std::ostream& ostream, const basic_value<Traits>& v, const redaction& rules, const T&... args)
+{
+    redaction::matcher matcher(rules);
+    impl::flow_stringifier(impl::stringifier<0, 0>(ostream, &matcher) << rule::json5(), args..., v);
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_REDACT_HPP_ */
@@ -0,0 +1,396 @@
+#ifndef _JSON5PP_SHAPE_HPP_
+#define _JSON5PP_SHAPE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Shape (schema) summary inferred from observed values
+ *
+ * A shape node counts JSON types seen at one position of documents, and
+ * keeps numeric ranges, string length histogram and array length
+ * statistics. Objects have a child shape per field, arrays have one shared
+ * child shape for all elements.
+ */
+class shape
+{
+public:
+    /**
+     * @brief JSON types distinguished by shape
+     */
+    enum kind : std::size_t {
+        null,
+        boolean,
+        integer,
+        number, ///< Non-integer number
+        string,
+        array,
+        object,
+        kinds
+    };
+
+    /// Number of buckets in string length histogram: [0], [1], [2,3], [4,7], ..., [2^30,)
+    static constexpr std::size_t length_buckets = 32;
+
+    /**
+     * @brief Construct a new shape object
+     *
+     * @param max_fields Maximum number of fields tracked per object shape
+     */
+    explicit shape(std::size_t max_fields = 256) : max_fields(max_fields) {}
+
+    shape(const shape& other) { *this = other; }
+    shape(shape&&) = default;
+    shape& operator=(shape&&) = default;
+    shape& operator=(const shape& other)
+    {
+        if (this != &other) {
+            max_fields = other.max_fields;
+            observations = other.observations;
+            kind_counts = other.kind_counts;
+            int_min = other.int_min;
+            int_max = other.int_max;
+            num_min = other.num_min;
+            num_max = other.num_max;
+            whole_numbers = other.whole_numbers;
+            length_counts = other.length_counts;
+            str_min = other.str_min;
+            str_max = other.str_max;
+            arr_min = other.arr_min;
+            arr_max = other.arr_max;
+            arr_total = other.arr_total;
+            items = other.items ? std::make_unique<shape>(*other.items) : nullptr;
+            members = other.members;
+            dropped_fields = other.dropped_fields;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Observe a value
+     *
+     * @param v A value (document or record)
+     */
+    void observe(const value& v)
+    {
+        ++observations;
+        if (v.is_null()) {
+            ++kind_counts[null];
+        } else if (v.is_boolean()) {
+            ++kind_counts[boolean];
+        } else if (v.is_integer()) {
+            ++kind_counts[integer];
+            const auto n = v.get<long long>();
+            int_min = std::min(int_min, n);
+            int_max = std::max(int_max, n);
+        } else if (v.is_number()) {
+            ++kind_counts[number];
+            const auto n = v.as_number();
+            num_min = std::min(num_min, n);
+            num_max = std::max(num_max, n);
+            if ((n >= -0x1p63) && (n < 0x1p63) && (n == std::trunc(n))) {
+                ++whole_numbers;
+            }
+        } else if (v.is_string()) {
+            ++kind_counts[string];
+            const auto length = v.as_string().size();
+            ++length_counts[length_bucket(length)];
+            str_min = std::min(str_min, length);
+            str_max = std::max(str_max, length);
+        } else if (v.is_array()) {
+            ++kind_counts[array];
+            const auto& elements = v.as_array();
+            arr_min = std::min(arr_min, elements.size());
+            arr_max = std::max(arr_max, elements.size());
+            arr_total += elements.size();
+            if (!elements.empty() && !items) {
+                items = std::make_unique<shape>(max_fields);
+            }
+            for (const auto& e : elements) {
+                items->observe(e);
+            }
+        } else {
+            ++kind_counts[object];
+            for (const auto& pair : v.as_object()) {
+                auto iter = members.find(pair.first);
+                if (iter == members.end()) {
+                    if (members.size() >= max_fields) {
+                        ++dropped_fields;
+                        continue;
+                    }
+                    iter = members.emplace(pair.first, shape(max_fields)).first;
+                }
+                iter->second.observe(pair.second);
+            }
+        }
+    }
+
+    /**
+     * @brief Merge another shape (ex: partial result of another thread)
+     *
+     * @param other A shape to merge
+     */
+    void merge(const shape& other)
+    {
+        observations += other.observations;
+        for (std::size_t k = 0; k < kinds; ++k) {
+            kind_counts[k] += other.kind_counts[k];
+        }
+        int_min = std::min(int_min, other.int_min);
+        int_max = std::max(int_max, other.int_max);
+        num_min = std::min(num_min, other.num_min);
+        num_max = std::max(num_max, other.num_max);
+        whole_numbers += other.whole_numbers;
+        for (std::size_t b = 0; b < length_buckets; ++b) {
+            length_counts[b] += other.length_counts[b];
+        }
+        str_min = std::min(str_min, other.str_min);
+        str_max = std::max(str_max, other.str_max);
+        arr_min = std::min(arr_min, other.arr_min);
+        arr_max = std::max(arr_max, other.arr_max);
+        arr_total += other.arr_total;
+        if (other.items) {
+            if (!items) {
+                items = std::make_unique<shape>(max_fields);
+            }
+            items->merge(*other.items);
+        }
+        for (const auto& pair : other.members) {
+            auto iter = members.find(pair.first);
+            if (iter == members.end()) {
+                if (members.size() >= max_fields) {
+                    ++dropped_fields;
+                    continue;
+                }
+                iter = members.emplace(pair.first, shape(max_fields)).first;
+            }
+            iter->second.merge(pair.second);
+        }
+        dropped_fields += other.dropped_fields;
+    }
+
+    /*================================================================================
+     * Queries
+     */
+    /// Number of observed values at this position
+    std::size_t count() const noexcept { return observations; }
+
+    /// Number of observed values of the given kind
+    std::size_t count(kind k) const noexcept { return kind_counts[k]; }
+
+    /// Get the kind if all observed values are the same kind
+    std::optional<kind> uniform_kind() const noexcept
+    {
+        for (std::size_t k = 0; k < kinds; ++k) {
+            if ((kind_counts[k] > 0) && (kind_counts[k] == observations)) {
+                return static_cast<kind>(k);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Test if all observed values are numbers (integers and non-integers mixed)
+    bool is_numeric() const noexcept
+    {
+        return (observations > 0) && (kind_counts[integer] + kind_counts[number] == observations);
+    }
+
+    /// Test if all numbers are integral (integers, or non-integer numbers with integral values in the range of long long)
+    bool is_integral() const noexcept
+    {
+        return (kind_counts[integer] + kind_counts[number] > 0) && (kind_counts[number] == whole_numbers);
+    }
+
+    /// Test if values are the same kind except for nulls (ex: optional field)
+    bool is_nullable() const noexcept
+    {
+        const auto non_null = observations - kind_counts[null];
+        if ((kind_counts[null] == 0) || (non_null == 0)) {
+            return false;
+        }
+        for (std::size_t k = null + 1; k < kinds; ++k) {
+            if (kind_counts[k] == non_null) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Range of integer values (if any)
+    std::optional<std::pair<long long, long long>> integer_range() const
+    {
+        if (kind_counts[integer] == 0) return std::nullopt;
+        return std::make_pair(int_min, int_max);
+    }
+
+    /// Range of all numeric values (if any)
+    std::optional<std::pair<double, double>> number_range() const
+    {
+        if (kind_counts[integer] + kind_counts[number] == 0) return std::nullopt;
+        double lo = num_min, hi = num_max;
+        if (kind_counts[integer] > 0) {
+            lo = std::min(lo, static_cast<double>(int_min));
+            hi = std::max(hi, static_cast<double>(int_max));
+        }
+        return std::make_pair(lo, hi);
+    }
+
+    /// Range of string lengths (if any)
+    std::optional<std::pair<std::size_t, std::size_t>> string_length_range() const
+    {
+        if (kind_counts[string] == 0) return std::nullopt;
+        return std::make_pair(str_min, str_max);
+    }
+
+    /// String length histogram (bucket b counts lengths in [2^(b-1), 2^b), bucket 0 counts empty strings)
+    const std::array<std::size_t, length_buckets>& string_length_histogram() const noexcept { return length_counts; }
+
+    /// Range of array lengths (if any)
+    std::optional<std::pair<std::size_t, std::size_t>> array_length_range() const
+    {
+        if (kind_counts[array] == 0) return std::nullopt;
+        return std::make_pair(arr_min, arr_max);
+    }
+
+    /// Average array length
+    double array_length_mean() const noexcept
+    {
+        return kind_counts[array] ? static_cast<double>(arr_total) / static_cast<double>(kind_counts[array]) : 0.0;
+    }
+
+    /// Shape of array elements (nullptr if no element observed)
+    const shape* elements() const noexcept { return items.get(); }
+
+    /// Shapes of object fields
+    const std::map<std::string, shape>& fields() const noexcept { return members; }
+
+    /// Ratio of objects which have the field (0.0 - 1.0)
+    double presence(const std::string& key) const
+    {
+        auto iter = members.find(key);
+        if ((iter == members.end()) || (kind_counts[object] == 0)) return 0.0;
+        return static_cast<double>(iter->second.observations) / static_cast<double>(kind_counts[object]);
+    }
+
+    /// Number of fields not tracked because of max_fields
+    std::size_t dropped() const noexcept { return dropped_fields; }
+
+    /**
+     * @brief Get the summary as JSON value
+     *
+     * @return JSON value
+     */
+    value to_value() const
+    {
+        static const char* const names[kinds] = {"null", "boolean", "integer", "number", "string", "array", "object"};
+        value v = json5pp::object({{"count", static_cast<long long>(observations)}});
+        value types = json5pp::object();
+        for (std::size_t k = 0; k < kinds; ++k) {
+            if (kind_counts[k] > 0) {
+                types[names[k]] = static_cast<long long>(kind_counts[k]);
+            }
+        }
+        v["types"] = std::move(types);
+        if (auto r = number_range()) {
+            v["min"] = r->first;
+            v["max"] = r->second;
+        }
+        if (auto r = string_length_range()) {
+            v["string_length"] = json5pp::object({
+                {"min", static_cast<long long>(r->first)},
+                {"max", static_cast<long long>(r->second)},
+            });
+            value histogram = json5pp::array();
+            auto last = length_buckets;
+            while ((last > 0) && (length_counts[last - 1] == 0)) --last;
+            for (std::size_t b = 0; b < last; ++b) {
+                histogram.append(static_cast<long long>(length_counts[b]));
+            }
+            v["string_length"]["histogram"] = std::move(histogram);
+        }
+        if (auto r = array_length_range()) {
+            v["array_length"] = json5pp::object({
+                {"min", static_cast<long long>(r->first)},
+                {"max", static_cast<long long>(r->second)},
+                {"mean", array_length_mean()},
+            });
+        }
+        if (items) {
+            v["elements"] = items->to_value();
+        }
+        if (!members.empty()) {
+            value fields = json5pp::object();
+            for (const auto& pair : members) {
+                fields[pair.first] = pair.second.to_value();
+                fields[pair.first]["presence"] = presence(pair.first);
+            }
+            v["fields"] = std::move(fields);
+        }
+        if (dropped_fields > 0) {
+            v["dropped_fields"] = static_cast<long long>(dropped_fields);
+        }
+        return v;
+    }
+
+private:
+    static std::size_t length_bucket(std::size_t length) noexcept
+    {
+        std::size_t b = 0;
+        while ((length > 0) && (b < length_buckets - 1)) {
+            length >>= 1;
+            ++b;
+        }
+        return b;
+    }
+
+    std::size_t max_fields;                            ///< Maximum number of fields per object shape
+    std::size_t observations = 0;                      ///< Number of observed values
+    std::array<std::size_t, kinds> kind_counts{};      ///< Number of observed values per kind
+    long long int_min = std::numeric_limits<long long>::max();
+    long long int_max = std::numeric_limits<long long>::min();
+    double num_min = std::numeric_limits<double>::infinity();
+    double num_max = -std::numeric_limits<double>::infinity();
+    std::size_t whole_numbers = 0;                     ///< Non-integer numbers with integral values (ex: integers beyond int)
+    std::array<std::size_t, length_buckets> length_counts{}; ///< String length histogram
+    std::size_t str_min = std::numeric_limits<std::size_t>::max();
+    std::size_t str_max = 0;
+    std::size_t arr_min = std::numeric_limits<std::size_t>::max();
+    std::size_t arr_max = 0;
+    std::size_t arr_total = 0;                         ///< Sum of array lengths
+    std::unique_ptr<shape> items;                      ///< Shape of array elements
+    std::map<std::string, shape> members;              ///< Shapes of object fields
+    std::size_t dropped_fields = 0;                    ///< Fields not tracked
+};
+
+/**
+ * @brief Infer shape from a range of values
+ *
+ * @tparam I A typename of iterator
+ * @param first Beginning of values
+ * @param last End of values
+ * @return Inferred shape
+ */
+template <class I>
+shape infer_shape(I first, I last)
+{
+    shape s;
+    for (; first != last; ++first) {
+        s.observe(*first);
+    }
+    return s;
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_SHAPE_HPP_ */
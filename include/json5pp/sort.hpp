@@ -0,0 +1,191 @@
+#ifndef _JSON5PP_SORT_HPP_
+#define _JSON5PP_SORT_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json5pp.hpp"
+#include "pointer.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Sort order
+ */
+enum class sort_order {
+    ascending,
+    descending,
+};
+
+namespace impl {
+
+/**
+ * @brief Sort key extracted from an array element
+ *
+ * Keys order as: missing/null < boolean < number < string. Arrays and
+ * objects compare equal to each other and come last.
+ */
+struct sort_entry {
+    std::uint8_t rank;         ///< Type rank
+    bool integer;              ///< Number key is an integer
+    long long integer_key;     ///< Integer (or boolean) key
+    double number;             ///< Number key (if not integer)
+    const std::string* string; ///< String key
+    std::size_t index;         ///< Index of element in array
+};
+
+inline sort_entry make_sort_entry(const value* key, std::size_t index)
+{
+    if (!key || key->is_null()) {
+        return sort_entry{0, true, 0, 0.0, nullptr, index};
+    }
+    if (key->is_boolean()) {
+        return sort_entry{1, true, key->as_boolean() ? 1 : 0, 0.0, nullptr, index};
+    }
+    if (key->is_integer()) {
+        return sort_entry{2, true, key->get<long long>(), 0.0, nullptr, index};
+    }
+    if (key->is_number()) {
+        const auto n = key->as_number();
+        // NaN has no order, treat it as null
+        if (std::isnan(n)) {
+            return sort_entry{0, true, 0, 0.0, nullptr, index};
+        }
+        return sort_entry{2, false, 0, n, nullptr, index};
+    }
+    if (key->is_string()) {
+        return sort_entry{3, true, 0, 0.0, &key->as_string(), index};
+    }
+    return sort_entry{4, true, 0, 0.0, nullptr, index};
+}
+
+inline bool less_sort_entry(const sort_entry& a, const sort_entry& b)
+{
+    if (a.rank != b.rank) {
+        return a.rank < b.rank;
+    }
+    if (a.rank == 3) {
+        return *a.string < *b.string;
+    }
+    // integers compare exactly (also against floating point numbers)
+    if (a.integer) {
+        return b.integer ? (a.integer_key < b.integer_key) : (compare_numbers(a.integer_key, b.number) < 0);
+    }
+    return b.integer ? (compare_numbers(a.number, b.integer_key) < 0) : (a.number < b.number);
+}
+
+/**
+ * @brief Stable sort using multiple threads (sort chunks, then merge pairs)
+ *
+ * @param entries Entries to sort
+ * @param less A comparator
+ * @param threads Number of threads
+ */
+template <class C>
+void parallel_stable_sort(std::vector<sort_entry>& entries, C less, std::size_t threads)
+{
+    const std::size_t n = entries.size();
+    std::vector<std::size_t> bounds;
+    for (std::size_t t = 0; t <= threads; ++t) {
+        bounds.push_back(n * t / threads);
+    }
+    auto run = [](std::vector<std::thread>& workers) {
+        for (auto& w : workers) {
+            w.join();
+        }
+        workers.clear();
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] { std::stable_sort(entries.begin() + bounds[t], entries.begin() + bounds[t + 1], less); });
+    }
+    run(workers);
+    for (std::size_t width = 1; width < threads; width *= 2) {
+        for (std::size_t t = 0; t + width < threads; t += 2 * width) {
+            const auto first = bounds[t];
+            const auto middle = bounds[t + width];
+            const auto last = bounds[std::min(t + 2 * width, threads)];
+            workers.emplace_back([&, first, middle, last] {
+                std::inplace_merge(entries.begin() + first, entries.begin() + middle, entries.begin() + last, less);
+            });
+        }
+        run(workers);
+    }
+}
+
+} /* namespace impl */
+
+/**
+ * @brief Sort elements of an array by a key path (stable)
+ *
+ * Sort keys are extracted once, so comparisons do not look up members.
+ * Numbers compare numerically, strings by bytes. Elements without the key
+ * (or with null) come first in ascending order.
+ *
+ * @param array An array value
+ * @param key A pointer to the key in each element (root pointer sorts by the element itself)
+ * @param order Sort order
+ * @param threads Maximum number of threads (0: number of hardware threads)
+ * @param min_parallel Minimum number of elements to sort in parallel
+ * @throws std::bad_cast if the value is not an array
+ */
+inline void sort_by(value& array, const pointer& key, sort_order order = sort_order::ascending, unsigned threads = 0, std::size_t min_parallel = 1 << 16)
+{
+    auto& elements = array.as_array();
+    const std::size_t n = elements.size();
+
+    std::vector<impl::sort_entry> entries;
+    entries.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        entries.push_back(impl::make_sort_entry(key.find(elements[i]), i));
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::size_t workers = (n >= min_parallel) ? std::min<std::size_t>(threads, n / 2) : 1;
+    auto sort = [&](auto less) {
+        if (workers > 1) {
+            impl::parallel_stable_sort(entries, less, workers);
+        } else {
+            std::stable_sort(entries.begin(), entries.end(), less);
+        }
+    };
+    if (order == sort_order::ascending) {
+        sort(impl::less_sort_entry);
+    } else {
+        sort([](const impl::sort_entry& a, const impl::sort_entry& b) { return impl::less_sort_entry(b, a); });
+    }
+
+    value::array_type sorted;
+    sorted.reserve(n);
+    for (const auto& e : entries) {
+        sorted.push_back(std::move(elements[e.index]));
+    }
+    elements.swap(sorted);
+}
+
+/**
+ * @brief Sort elements of an array by a key path (stable)
+ *
+ * @param array An array value
+ * @param key A JSON pointer string to the key in each element (ex: "/user/id")
+ * @param order Sort order
+ * @param threads Maximum number of threads (0: number of hardware threads)
+ * @param min_parallel Minimum number of elements to sort in parallel
+ * @throws std::bad_cast if the value is not an array
+ * @throws std::invalid_argument if key is not a valid JSON pointer
+ */
+inline void sort_by(value& array, std::string_view key, sort_order order = sort_order::ascending, unsigned threads = 0, std::size_t min_parallel = 1 << 16)
+{
+    sort_by(array, pointer(key), order, threads, min_parallel);
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_SORT_HPP_ */
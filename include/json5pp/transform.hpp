@@ -0,0 +1,723 @@
+#ifndef _JSON5PP_TRANSFORM_HPP_
+#define _JSON5PP_TRANSFORM_HPP_
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "json5pp.hpp"
+#include "pointer.hpp"
+#include "record_reader.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Comparison of a filter stage
+ */
+enum class compare_op {
+    eq,
+    ne,
+    lt,
+    le,
+    gt,
+    ge,
+    exists,  ///< The path exists (operand is ignored)
+    missing, ///< The path does not exist (operand is ignored)
+};
+
+/**
+ * @brief Target type of a coerce stage
+ */
+enum class coerce_type {
+    integer,
+    number,
+    string,
+    boolean,
+};
+
+/**
+ * @brief Aggregate of a group-by stage
+ */
+struct aggregate {
+    enum kind_type {
+        count, ///< Number of records
+        sum,   ///< Sum of numbers at path
+        min,   ///< Minimum of numbers at path
+        max,   ///< Maximum of numbers at path
+        mean,  ///< Mean of numbers at path
+    };
+
+    kind_type kind;   ///< Kind of aggregate
+    pointer path;     ///< Path of the aggregated number (not used by count)
+    std::string name; ///< Output key
+
+    static aggregate count_of(std::string name) { return aggregate{count, pointer(), std::move(name)}; }
+    static aggregate sum_of(std::string_view path, std::string name) { return aggregate{sum, pointer(path), std::move(name)}; }
+    static aggregate min_of(std::string_view path, std::string name) { return aggregate{min, pointer(path), std::move(name)}; }
+    static aggregate max_of(std::string_view path, std::string name) { return aggregate{max, pointer(path), std::move(name)}; }
+    static aggregate mean_of(std::string_view path, std::string name) { return aggregate{mean, pointer(path), std::move(name)}; }
+};
+
+/**
+ * @brief Options of pipeline::run()
+ */
+struct pipeline_options {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency()); ///< Number of worker threads
+    std::size_t chunk_size = 1024;                                         ///< Records per chunk
+    record_format format = record_format::ndjson;                          ///< Layout of input records
+    bool json5 = false;                                                    ///< Parse records as JSON5
+};
+
+/**
+ * @brief Statistics of pipeline::run()
+ */
+struct pipeline_statistics {
+    std::size_t records_in = 0;  ///< Records read
+    std::size_t records_out = 0; ///< Records written
+};
+
+namespace impl {
+
+/**
+ * @brief Set a value at a path, creating objects for missing parents
+ */
+inline void put_path(value& root, const pointer& path, value v)
+{
+    value* node = &root;
+    for (const auto& token : path.tokens()) {
+        if (!node->is_object()) {
+            *node = object();
+        }
+        node = &node->as_object()[token];
+    }
+    *node = std::move(v);
+}
+
+/**
+ * @brief Remove a value at a path
+ *
+ * @return The removed value (null if not found)
+ */
+inline value take_path(value& root, const pointer& path)
+{
+    if (path.empty()) {
+        return std::move(root);
+    }
+    value* parent = path.parent().find(root);
+    const auto& token = path.tokens().back();
+    value result;
+    if (parent && parent->is_object()) {
+        auto& members = parent->as_object();
+        auto iter = members.find(token);
+        if (iter != members.end()) {
+            result = std::move(iter->second);
+            members.erase(iter);
+        }
+    } else if (parent && parent->is_array()) {
+        auto& elements = parent->as_array();
+        std::size_t index;
+        if (pointer::to_index(token, index) && (index < elements.size())) {
+            result = std::move(elements[index]);
+            elements.erase(elements.begin() + index);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Make a value from an integer (int if it fits)
+ */
+inline value integer_value(long long n)
+{
+    if ((n >= std::numeric_limits<value::integer_type>::min()) && (n <= std::numeric_limits<value::integer_type>::max())) {
+        return value(static_cast<value::integer_type>(n));
+    }
+    return value(n);
+}
+
+/**
+ * @brief Convert a value (null if not convertible)
+ *
+ * A number is converted to integer by truncation; it must be finite and
+ * within the range of long long.
+ */
+inline value coerce_value(const value& v, coerce_type type)
+{
+    switch (type) {
+    case coerce_type::integer:
+        if (v.is_integer()) {
+            return v;
+        }
+        if (v.is_number()) {
+            // [-2^63, 2^63) is exact in double (NaN fails both tests)
+            constexpr double limit = 9223372036854775808.0;
+            const double d = v.as_number();
+            if ((d >= -limit) && (d < limit)) {
+                return integer_value(static_cast<long long>(d));
+            }
+            return value();
+        }
+        if (v.is_boolean()) {
+            return value(v.as_boolean() ? 1 : 0);
+        }
+        if (v.is_string()) {
+            const auto& s = v.as_string();
+            long long n;
+            const auto r = std::from_chars(s.data(), s.data() + s.size(), n);
+            return ((r.ec == std::errc()) && (r.ptr == s.data() + s.size())) ? integer_value(n) : value();
+        }
+        return value();
+    case coerce_type::number:
+        if (v.is_number()) {
+            return value(v.as_number());
+        }
+        if (v.is_boolean()) {
+            return value(v.as_boolean() ? 1.0 : 0.0);
+        }
+        if (v.is_string()) {
+            const auto& s = v.as_string();
+            double d;
+            const auto r = std::from_chars(s.data(), s.data() + s.size(), d);
+            return ((r.ec == std::errc()) && (r.ptr == s.data() + s.size())) ? value(d) : value();
+        }
+        return value();
+    case coerce_type::string:
+        if (v.is_string()) {
+            return v;
+        }
+        if (v.is_null() || v.is_boolean() || v.is_number()) {
+            return value(v.stringify());
+        }
+        return value();
+    default:
+        if (v.is_boolean()) {
+            return v;
+        }
+        if (v.is_number()) {
+            return value(v.as_number() != 0);
+        }
+        if (v.is_string()) {
+            if (v.as_string() == "true") {
+                return value(true);
+            }
+            if (v.as_string() == "false") {
+                return value(false);
+            }
+        }
+        return value();
+    }
+}
+
+/**
+ * @brief Compare two numbers exactly (integers are not rounded to double)
+ *
+ * @return Ordering (unordered if either is NaN)
+ */
+inline std::partial_ordering compare_number_values(const value& a, const value& b)
+{
+    if (a.is_integer()) {
+        const auto n = a.get<long long>();
+        return b.is_integer() ? compare_numbers(n, b.get<long long>()) : compare_numbers(n, b.as_number());
+    }
+    return b.is_integer() ? compare_numbers(a.as_number(), b.get<long long>()) : compare_numbers(a.as_number(), b.as_number());
+}
+
+/**
+ * @brief Compare a value with an operand
+ */
+inline bool compare_value(const value* v, compare_op op, const value& operand)
+{
+    if (op == compare_op::exists) {
+        return v != nullptr;
+    }
+    if (op == compare_op::missing) {
+        return v == nullptr;
+    }
+    if (!v) {
+        return false;
+    }
+    int order;
+    if (v->is_number() && operand.is_number()) {
+        const auto c = compare_number_values(*v, operand);
+        if (c == std::partial_ordering::unordered) {
+            return op == compare_op::ne;
+        }
+        order = (c < 0) ? -1 : (c > 0) ? 1 : 0;
+    } else if (v->is_string() && operand.is_string()) {
+        order = v->as_string().compare(operand.as_string());
+    } else {
+        // not ordered: only (in)equality
+        const bool equal = (*v == operand);
+        return (op == compare_op::eq) ? equal : (op == compare_op::ne) ? !equal : false;
+    }
+    switch (op) {
+    case compare_op::eq:
+        return order == 0;
+    case compare_op::ne:
+        return order != 0;
+    case compare_op::lt:
+        return order < 0;
+    case compare_op::le:
+        return order <= 0;
+    case compare_op::gt:
+        return order > 0;
+    default:
+        return order >= 0;
+    }
+}
+
+/**
+ * @brief Partial aggregates of a group
+ */
+struct group_state {
+    struct number_state {
+        long long integer_sum = 0; ///< Sum of integers (exact)
+        double sum = 0.0;          ///< Sum of other numbers (and of integers once integer_sum overflows)
+        bool integer = true;       ///< sum has no part (integer_sum is the sum)
+        value min;                 ///< Minimum (null if none)
+        value max;                 ///< Maximum (null if none)
+        std::size_t count = 0;     ///< Number of numbers
+
+        void add_integer(long long n)
+        {
+            if ((n > 0) ? (integer_sum > std::numeric_limits<long long>::max() - n) : (integer_sum < std::numeric_limits<long long>::min() - n)) {
+                // overflow: continue in floating point
+                sum += static_cast<double>(integer_sum);
+                integer_sum = n;
+                integer = false;
+            } else {
+                integer_sum += n;
+            }
+        }
+
+        void add_extremes(const value& lo, const value& hi)
+        {
+            // NaN is not ordered and never becomes an extreme
+            if (lo.is_number() && (min.is_null() ? (compare_number_values(lo, lo) == 0) : (compare_number_values(lo, min) < 0))) {
+                min = lo;
+            }
+            if (hi.is_number() && (max.is_null() ? (compare_number_values(hi, hi) == 0) : (compare_number_values(hi, max) > 0))) {
+                max = hi;
+            }
+        }
+
+        void add(const value& v)
+        {
+            if (v.is_integer()) {
+                add_integer(v.get<long long>());
+            } else {
+                sum += v.as_number();
+                integer = false;
+            }
+            add_extremes(v, v);
+            ++count;
+        }
+
+        void merge(const number_state& other)
+        {
+            add_integer(other.integer_sum);
+            sum += other.sum;
+            integer = integer && other.integer;
+            add_extremes(other.min, other.max);
+            count += other.count;
+        }
+
+        value total() const { return integer ? integer_value(integer_sum) : value(static_cast<double>(integer_sum) + sum); }
+
+        double mean() const { return (static_cast<double>(integer_sum) + sum) / static_cast<double>(count); }
+    };
+
+    value key;                         ///< Group key
+    std::size_t count = 0;             ///< Number of records
+    std::vector<number_state> numbers; ///< State per aggregate
+
+    void merge(const group_state& other)
+    {
+        count += other.count;
+        for (std::size_t i = 0; i < numbers.size(); ++i) {
+            numbers[i].merge(other.numbers[i]);
+        }
+    }
+};
+
+/// Groups by stringified key (ordered)
+using group_map = std::map<std::string, group_state>;
+
+} /* namespace impl */
+
+/**
+ * @brief Transformation pipeline over record streams
+ *
+ * Stages are applied to each record in the order they are added. A
+ * group-by stage must be the last one; it replaces the output by one record
+ * per group.
+ *
+ * ```cpp
+ * json5pp::pipeline p;
+ * p.filter("/status", json5pp::compare_op::ge, 500)
+ *  .project({"/service", "/bytes"})
+ *  .group_by("/service", {json5pp::aggregate::count_of("n"), json5pp::aggregate::sum_of("/bytes", "bytes")});
+ * p.run(std::cin, std::cout);
+ * ```
+ */
+class pipeline
+{
+public:
+    /**
+     * @brief Add a filter stage which keeps records matching a comparison
+     *
+     * Numbers compare numerically and strings by bytes; other values only
+     * compare for (in)equality. A missing path matches only compare_op::missing.
+     *
+     * @param path A JSON pointer
+     * @param op Comparison
+     * @param operand Operand of comparison
+     */
+    pipeline& filter(std::string_view path, compare_op op, value operand = value())
+    {
+        return add(filter_stage{pointer(path), op, std::move(operand), {}});
+    }
+
+    /**
+     * @brief Add a filter stage with a predicate
+     *
+     * @param predicate A function called as predicate(record) (must be thread-safe)
+     */
+    pipeline& filter(std::function<bool(const value&)> predicate)
+    {
+        return add(filter_stage{pointer(), compare_op::exists, value(), std::move(predicate)});
+    }
+
+    /**
+     * @brief Add a projection stage which keeps only the given paths
+     *
+     * Missing paths are omitted; parents of the kept paths are objects.
+     */
+    pipeline& project(std::initializer_list<std::string_view> paths)
+    {
+        project_stage stage;
+        for (const auto path : paths) {
+            stage.paths.emplace_back(path);
+        }
+        return add(std::move(stage));
+    }
+
+    /**
+     * @brief Add a stage which moves a value to another path (if it exists)
+     */
+    pipeline& rename(std::string_view from, std::string_view to)
+    {
+        return add(rename_stage{pointer(from), pointer(to)});
+    }
+
+    /**
+     * @brief Add a stage which converts a value (null if not convertible)
+     */
+    pipeline& coerce(std::string_view path, coerce_type type)
+    {
+        return add(coerce_stage{pointer(path), type});
+    }
+
+    /**
+     * @brief Add a group-by stage (must be the last stage)
+     *
+     * Each group is written as an object of the key (named by the last
+     * token of path, or "key") and the aggregates. Groups are ordered by the JSON text of the key.
+     *
+     * @param path A JSON pointer to the key (missing keys are grouped as null)
+     * @param aggregates Aggregates to compute
+     */
+    pipeline& group_by(std::string_view path, std::vector<aggregate> aggregates)
+    {
+        if (grouping) {
+            throw std::logic_error("pipeline: group_by must be the last stage");
+        }
+        grouping = true;
+        group_key = pointer(path);
+        group_aggregates = std::move(aggregates);
+        return *this;
+    }
+
+    /**
+     * @brief Apply stages (except group-by) to a record
+     *
+     * @retval false The record is filtered out
+     */
+    bool apply(value& record) const
+    {
+        for (const auto& s : stages) {
+            if (const auto* f = std::get_if<filter_stage>(&s)) {
+                if (!(f->predicate ? f->predicate(record) : impl::compare_value(f->path.find(record), f->op, f->operand))) {
+                    return false;
+                }
+            } else if (const auto* p = std::get_if<project_stage>(&s)) {
+                value projected = object();
+                for (const auto& path : p->paths) {
+                    if (const value* v = path.find(record)) {
+                        impl::put_path(projected, path, *v);
+                    }
+                }
+                record = std::move(projected);
+            } else if (const auto* r = std::get_if<rename_stage>(&s)) {
+                if (r->from.find(record)) {
+                    value moved = impl::take_path(record, r->from);
+                    impl::put_path(record, r->to, std::move(moved));
+                }
+            } else if (const auto* c = std::get_if<coerce_stage>(&s)) {
+                if (value* v = c->path.find(record)) {
+                    *v = impl::coerce_value(*v, c->type);
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Run the pipeline over records and write NDJSON output
+     *
+     * Records are read in chunks; chunks are parsed (NDJSON), transformed
+     * and stringified by worker threads, and written in input order.
+     * Top-level array records are parsed by the reading thread.
+     *
+     * @param istream Input records
+     * @param ostream Output writer
+     * @param options Options
+     * @return Statistics
+     * @throws json5pp::syntax_error on a syntax error in input
+     */
+    pipeline_statistics run(std::istream& istream, std::ostream& ostream, const pipeline_options& options = {}) const
+    {
+        const std::size_t threads = std::max(1u, options.threads);
+        const std::size_t chunk_size = std::max<std::size_t>(1, options.chunk_size);
+        std::vector<worker> workers(threads);
+        std::optional<record_reader> reader;
+        if (options.format == record_format::array) {
+            reader.emplace(istream, record_format::array, options.json5);
+        }
+
+        pipeline_statistics stats;
+        for (bool more = true; more;) {
+            std::size_t used = 0;
+            for (auto& w : workers) {
+                w.lines.clear();
+                w.records.clear();
+                more = reader ? fill(*reader, w.records, chunk_size) : fill(istream, w.lines, chunk_size);
+                stats.records_in += w.lines.size() + w.records.size();
+                ++used;
+                if (!more) {
+                    break;
+                }
+            }
+            if (used == 1) {
+                process(workers[0], options.json5);
+            } else {
+                std::vector<std::thread> pool;
+                for (std::size_t t = 0; t < used; ++t) {
+                    pool.emplace_back([&, t] { process(workers[t], options.json5); });
+                }
+                for (auto& t : pool) {
+                    t.join();
+                }
+            }
+            for (std::size_t t = 0; t < used; ++t) {
+                auto& w = workers[t];
+                if (w.error) {
+                    std::rethrow_exception(w.error);
+                }
+                ostream.write(w.output.data(), static_cast<std::streamsize>(w.output.size()));
+                stats.records_out += w.written;
+                w.output.clear();
+                w.written = 0;
+            }
+        }
+
+        if (grouping) {
+            auto& groups = workers[0].groups;
+            for (std::size_t t = 1; t < threads; ++t) {
+                for (auto& pair : workers[t].groups) {
+                    auto iter = groups.find(pair.first);
+                    if (iter == groups.end()) {
+                        groups.emplace(pair.first, std::move(pair.second));
+                    } else {
+                        iter->second.merge(pair.second);
+                    }
+                }
+            }
+            std::string line;
+            for (const auto& pair : groups) {
+                line = group_record(pair.second).stringify();
+                line.push_back('\n');
+                ostream.write(line.data(), static_cast<std::streamsize>(line.size()));
+                ++stats.records_out;
+            }
+        }
+        return stats;
+    }
+
+private:
+    struct filter_stage {
+        pointer path;
+        compare_op op;
+        value operand;
+        std::function<bool(const value&)> predicate;
+    };
+    struct project_stage {
+        std::vector<pointer> paths;
+    };
+    struct rename_stage {
+        pointer from;
+        pointer to;
+    };
+    struct coerce_stage {
+        pointer path;
+        coerce_type type;
+    };
+    using stage = std::variant<filter_stage, project_stage, rename_stage, coerce_stage>;
+
+    /**
+     * @brief Per-thread state of run()
+     */
+    struct worker {
+        std::vector<std::string> lines; ///< NDJSON input chunk
+        std::vector<value> records;     ///< Parsed input chunk
+        std::string output;             ///< Output of the chunk
+        std::size_t written = 0;        ///< Records in output
+        impl::group_map groups;         ///< Partial aggregates
+        std::exception_ptr error;       ///< Error of the chunk
+    };
+
+    pipeline& add(stage s)
+    {
+        if (grouping) {
+            throw std::logic_error("pipeline: group_by must be the last stage");
+        }
+        stages.push_back(std::move(s));
+        return *this;
+    }
+
+    static bool fill(std::istream& istream, std::vector<std::string>& lines, std::size_t size)
+    {
+        std::string line;
+        while (lines.size() < size) {
+            if (!std::getline(istream, line)) {
+                return false;
+            }
+            if (line.find_first_not_of(" \t\r") != std::string::npos) {
+                lines.push_back(std::move(line));
+            }
+        }
+        return true;
+    }
+
+    static bool fill(record_reader& reader, std::vector<value>& records, std::size_t size)
+    {
+        while (records.size() < size) {
+            value v;
+            if (!reader.read(v)) {
+                return false;
+            }
+            records.push_back(std::move(v));
+        }
+        return true;
+    }
+
+    void process(worker& w, bool json5) const
+    {
+        try {
+            for (const auto& line : w.lines) {
+                value v = json5 ? parse5(line.data(), line.size()) : parse(line.data(), line.size());
+                process(w, v);
+            }
+            for (auto& v : w.records) {
+                process(w, v);
+            }
+        } catch (...) {
+            w.error = std::current_exception();
+        }
+    }
+
+    void process(worker& w, value& record) const
+    {
+        if (!apply(record)) {
+            return;
+        }
+        if (!grouping) {
+            w.output += record.stringify();
+            w.output.push_back('\n');
+            ++w.written;
+            return;
+        }
+        const value* key = group_key.find(record);
+        auto [iter, added] = w.groups.try_emplace(key ? key->stringify() : "null");
+        auto& g = iter->second;
+        if (added) {
+            g.key = key ? *key : value();
+            g.numbers.resize(group_aggregates.size());
+        }
+        ++g.count;
+        for (std::size_t i = 0; i < group_aggregates.size(); ++i) {
+            const auto& a = group_aggregates[i];
+            if (a.kind == aggregate::count) {
+                continue;
+            }
+            const value* v = a.path.find(record);
+            if (v && v->is_number()) {
+                g.numbers[i].add(*v);
+            }
+        }
+    }
+
+    value group_record(const impl::group_state& g) const
+    {
+        value v = object();
+        v[group_key.empty() ? std::string("key") : group_key.tokens().back()] = g.key;
+        for (std::size_t i = 0; i < group_aggregates.size(); ++i) {
+            const auto& a = group_aggregates[i];
+            const auto& n = g.numbers[i];
+            value& out = v[a.name];
+            switch (a.kind) {
+            case aggregate::count:
+                out = impl::integer_value(static_cast<long long>(g.count));
+                break;
+            case aggregate::sum:
+                out = n.total();
+                break;
+            case aggregate::min:
+                out = n.min;
+                break;
+            case aggregate::max:
+                out = n.max;
+                break;
+            default:
+                out = n.count ? value(n.mean()) : value();
+                break;
+            }
+        }
+        return v;
+    }
+
+    std::vector<stage> stages;             ///< Compiled stages
+    bool grouping = false;                 ///< Has group-by stage
+    pointer group_key;                     ///< Path of group key
+    std::vector<aggregate> group_aggregates; ///< Aggregates per group
+};
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_TRANSFORM_HPP_ */
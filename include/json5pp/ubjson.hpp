@@ -0,0 +1,655 @@
+#ifndef _JSON5PP_UBJSON_HPP_
+#define _JSON5PP_UBJSON_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <string>
+
+#include "json5pp.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief UBJSON (Universal Binary JSON, draft 12) encoder/decoder
+ * @see https://ubjson.org/
+ */
+namespace ubjson {
+
+/**
+ * @brief Default maximum total count of elements in typed null/boolean arrays in decode()
+ *
+ * Elements of such arrays take no bytes, so their count is not bounded by
+ * the input size.
+ */
+inline constexpr std::size_t default_max_count = std::size_t(1) << 20;
+
+/**
+ * @brief Default maximum nesting of arrays / objects in decode()
+ */
+inline constexpr std::size_t default_max_depth = 512;
+
+/**
+ * @brief Options of decode()
+ */
+struct decode_options {
+    std::size_t max_count = default_max_count; ///< Maximum total count of elements in typed null/boolean arrays
+    std::size_t max_depth = default_max_depth; ///< Maximum nesting of arrays / objects
+};
+
+namespace impl {
+
+/**
+ * @brief UBJSON encoder
+ */
+class encoder
+{
+public:
+    /**
+     * @brief Construct a new encoder object
+     *
+     * @param out A buffer to append encoded bytes
+     * @param optimize If true, use count-prefixed containers and type-prefixed arrays
+     */
+    encoder(std::string& out, bool optimize) : out(out), optimize(optimize) {}
+
+    /**
+     * @brief Encode value with type marker
+     *
+     * @param v A value to encode
+     */
+    void encode_value(const value& v)
+    {
+        if (v.is_null()) {
+            out.push_back('Z');
+        } else if (v.is_boolean()) {
+            out.push_back(v.as_boolean() ? 'T' : 'F');
+        } else if (v.is_integer()) {
+            const auto n = v.get<long long>();
+            const char marker = int_marker(n, n);
+            out.push_back(marker);
+            encode_int(marker, n);
+        } else if (v.is_number()) {
+            const auto n = v.as_number();
+            if (!std::isfinite(n)) {
+                // NaN and infinity are encoded as null (see UBJSON specification)
+                out.push_back('Z');
+            } else {
+                out.push_back('D');
+                encode_float64(n);
+            }
+        } else if (v.is_string()) {
+            out.push_back('S');
+            encode_string(v.as_string());
+        } else if (v.is_array()) {
+            encode_array(v.as_array());
+        } else {
+            encode_object(v.as_object());
+        }
+    }
+
+private:
+    /**
+     * @brief Select the smallest integer marker for range [lo, hi]
+     */
+    static char int_marker(long long lo, long long hi)
+    {
+        if ((lo >= 0) && (hi <= 0xff)) return 'U';
+        if ((lo >= -0x80) && (hi <= 0x7f)) return 'i';
+        if ((lo >= -0x8000) && (hi <= 0x7fff)) return 'I';
+        if ((lo >= -0x80000000LL) && (hi <= 0x7fffffffLL)) return 'l';
+        return 'L';
+    }
+
+    void encode_be(std::uint64_t n, int bytes)
+    {
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((n >> shift) & 0xff));
+        }
+    }
+
+    void encode_int(char marker, long long n)
+    {
+        switch (marker) {
+        case 'U':
+        case 'i': return encode_be(static_cast<std::uint64_t>(n), 1);
+        case 'I': return encode_be(static_cast<std::uint64_t>(n), 2);
+        case 'l': return encode_be(static_cast<std::uint64_t>(n), 4);
+        default: return encode_be(static_cast<std::uint64_t>(n), 8);
+        }
+    }
+
+    void encode_float64(double n)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &n, sizeof(bits));
+        encode_be(bits, 8);
+    }
+
+    void encode_length(std::size_t n)
+    {
+        const auto length = static_cast<long long>(n);
+        const char marker = int_marker(length, length);
+        out.push_back(marker);
+        encode_int(marker, length);
+    }
+
+    void encode_string(const std::string& s)
+    {
+        encode_length(s.size());
+        out.append(s);
+    }
+
+    /**
+     * @brief Get the element marker if array can be type-prefixed
+     *
+     * @return Marker of all elements, or 0 if elements are not uniform
+     */
+    static char uniform_marker(const value::array_type& elements)
+    {
+        if (elements.empty()) return 0;
+        if (elements.front().is_integer()) {
+            long long lo = std::numeric_limits<long long>::max();
+            long long hi = std::numeric_limits<long long>::min();
+            for (const auto& e : elements) {
+                if (!e.is_integer()) return 0;
+                const auto n = e.get<long long>();
+                lo = std::min(lo, n);
+                hi = std::max(hi, n);
+            }
+            return int_marker(lo, hi);
+        }
+        if (elements.front().is_number()) {
+            for (const auto& e : elements) {
+                if (!e.is_number() || e.is_integer() || !std::isfinite(e.as_number())) return 0;
+            }
+            return 'D';
+        }
+        if (elements.front().is_string()) {
+            for (const auto& e : elements) {
+                if (!e.is_string()) return 0;
+            }
+            return 'S';
+        }
+        return 0;
+    }
+
+    void encode_array(const value::array_type& elements)
+    {
+        out.push_back('[');
+        if (!optimize) {
+            for (const auto& e : elements) {
+                encode_value(e);
+            }
+            out.push_back(']');
+            return;
+        }
+        const char marker = uniform_marker(elements);
+        if (marker) {
+            out.push_back('$');
+            out.push_back(marker);
+        }
+        out.push_back('#');
+        encode_length(elements.size());
+        if (!marker) {
+            for (const auto& e : elements) {
+                encode_value(e);
+            }
+        } else if (marker == 'D') {
+            for (const auto& e : elements) {
+                encode_float64(e.as_number());
+            }
+        } else if (marker == 'S') {
+            for (const auto& e : elements) {
+                encode_string(e.as_string());
+            }
+        } else {
+            for (const auto& e : elements) {
+                encode_int(marker, e.get<long long>());
+            }
+        }
+    }
+
+    void encode_object(const value::object_type& members)
+    {
+        out.push_back('{');
+        if (optimize) {
+            out.push_back('#');
+            encode_length(members.size());
+        }
+        for (const auto& pair : members) {
+            encode_string(pair.first);
+            encode_value(pair.second);
+        }
+        if (!optimize) {
+            out.push_back('}');
+        }
+    }
+
+    std::string& out;    ///< A buffer to append encoded bytes
+    const bool optimize; ///< Use optimized container format
+};
+
+/**
+ * @brief UBJSON decoder
+ */
+class decoder
+{
+public:
+    /**
+     * @brief Construct a new decoder object
+     *
+     * @param data A pointer to encoded bytes
+     * @param size Number of bytes
+     * @param options Decode options
+     */
+    decoder(const void* data, std::size_t size, const decode_options& options)
+        : p(static_cast<const unsigned char*>(data)), end(p + size), max_count(options.max_count), max_depth(options.max_depth) {}
+
+    /**
+     * @brief Decode one value and check that no data follows
+     *
+     * @param v A value object to store decoded value
+     */
+    void decode(value& v)
+    {
+        decode_value(v, next_marker(), "ubjson value");
+        if (p != end) {
+            throw syntax_error(*p, "ubjson value");
+        }
+    }
+
+private:
+    int next_byte(const char* context)
+    {
+        if (p == end) {
+            throw syntax_error(std::char_traits<char>::eof(), context);
+        }
+        return *p++;
+    }
+
+    /// Get next type marker (skipping no-op markers)
+    int next_marker()
+    {
+        int marker;
+        while ((marker = next_byte("ubjson marker")) == 'N') {
+        }
+        return marker;
+    }
+
+    std::uint64_t decode_be(int bytes, const char* context)
+    {
+        if (end - p < bytes) {
+            throw syntax_error(std::char_traits<char>::eof(), context);
+        }
+        std::uint64_t n = 0;
+        for (int i = 0; i < bytes; ++i) {
+            n = (n << 8) | *p++;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Decode integer payload
+     *
+     * @param marker Integer type marker
+     * @retval true The marker is an integer type
+     */
+    bool decode_int(int marker, long long& n)
+    {
+        static const char context[] = "ubjson integer";
+        switch (marker) {
+        case 'U': n = static_cast<long long>(decode_be(1, context)); return true;
+        case 'i': n = static_cast<std::int8_t>(decode_be(1, context)); return true;
+        case 'I': n = static_cast<std::int16_t>(decode_be(2, context)); return true;
+        case 'l': n = static_cast<std::int32_t>(decode_be(4, context)); return true;
+        case 'L': n = static_cast<std::int64_t>(decode_be(8, context)); return true;
+        default: return false;
+        }
+    }
+
+    std::size_t decode_length(int marker)
+    {
+        static const char context[] = "ubjson length";
+        long long n;
+        if (!decode_int(marker, n) || (n < 0)) {
+            throw syntax_error(marker, context);
+        }
+        return static_cast<std::size_t>(n);
+    }
+
+    void decode_string(std::string& s, int marker)
+    {
+        const std::size_t size = decode_length(marker);
+        if (static_cast<std::size_t>(end - p) < size) {
+            throw syntax_error(std::char_traits<char>::eof(), "ubjson string");
+        }
+        s.assign(reinterpret_cast<const char*>(p), size);
+        p += size;
+    }
+
+    static void set_int(value& v, long long n)
+    {
+        if ((n >= std::numeric_limits<int>::min()) && (n <= std::numeric_limits<int>::max())) {
+            v = static_cast<int>(n);
+        } else {
+            v = n;
+        }
+    }
+
+    /**
+     * @brief Decode value (payload only, marker already read)
+     *
+     * @param v A value object to store decoded value
+     * @param marker Type marker
+     * @param context A description of context
+     */
+    void decode_value(value& v, int marker, const char* context)
+    {
+        long long n;
+        if (decode_int(marker, n)) {
+            set_int(v, n);
+            return;
+        }
+        switch (marker) {
+        case 'Z':
+            v = nullptr;
+            return;
+        case 'T':
+            v = true;
+            return;
+        case 'F':
+            v = false;
+            return;
+        case 'd': {
+            const auto bits = static_cast<std::uint32_t>(decode_be(4, "ubjson float32"));
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            v = static_cast<double>(f);
+            return;
+        }
+        case 'D': {
+            const auto bits = decode_be(8, "ubjson float64");
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            v = d;
+            return;
+        }
+        case 'H': {
+            std::string digits;
+            decode_string(digits, next_byte("ubjson high-precision number"));
+            v = json5pp::parse(digits);
+            if (!v.is_number()) {
+                throw syntax_error(marker, "ubjson high-precision number");
+            }
+            return;
+        }
+        case 'C':
+            v = std::string(1, static_cast<char>(next_byte("ubjson char")));
+            return;
+        case 'S':
+            v = "";
+            decode_string(v.as_string(), next_byte("ubjson string"));
+            return;
+        case '[':
+            return decode_array(v);
+        case '{':
+            return decode_object(v);
+        default:
+            throw syntax_error(marker, context);
+        }
+    }
+
+    /**
+     * @brief Enter a nested array / object
+     *
+     * @param marker Container marker ('[' or '{')
+     * @param context A description of context
+     */
+    void enter(int marker, const char* context)
+    {
+        if (depth >= max_depth) {
+            // Nesting is limited to protect the call stack
+            throw syntax_error(marker, context);
+        }
+        ++depth;
+    }
+
+    /**
+     * @brief Read optimized container header ('$' type and/or '#' count)
+     *
+     * @param marker First marker after '[' or '{', replaced by the next unread marker
+     * @param type Element type marker (0 if not typed)
+     * @param count Number of elements (valid if returns true)
+     * @retval true Count-prefixed container
+     */
+    bool decode_header(int& marker, int& type, std::size_t& count, const char* context)
+    {
+        type = 0;
+        if (marker == '$') {
+            type = next_byte(context);
+            marker = next_byte(context);
+            if (marker != '#') {
+                // type requires count
+                throw syntax_error(marker, context);
+            }
+        }
+        if (marker == '#') {
+            count = decode_length(next_byte(context));
+            return true;
+        }
+        return false;
+    }
+
+    void decode_array(value& v)
+    {
+        static const char context[] = "ubjson array";
+        enter('[', context);
+        v = json5pp::array();
+        auto& elements = v.as_array();
+        int marker = next_marker();
+        int type;
+        std::size_t count;
+        if (!decode_header(marker, type, count, context)) {
+            for (; marker != ']'; marker = next_marker()) {
+                elements.emplace_back(nullptr);
+                decode_value(elements.back(), marker, context);
+            }
+            --depth;
+            return;
+        }
+        if ((type == 'Z') || (type == 'T') || (type == 'F')) {
+            // Elements take no bytes: limit them by count instead of input size
+            if (count > max_count) {
+                throw syntax_error(type, context);
+            }
+            max_count -= count;
+        }
+        // Each element takes one byte at least (unless typed as null/boolean)
+        elements.reserve(std::min<std::size_t>(count, static_cast<std::size_t>(end - p)));
+        if (type == 0) {
+            for (std::size_t i = 0; i < count; ++i) {
+                elements.emplace_back(nullptr);
+                decode_value(elements.back(), next_marker(), context);
+            }
+        } else if (type == 'D') {
+            if (static_cast<std::size_t>(end - p) / 8 < count) {
+                throw syntax_error(std::char_traits<char>::eof(), context);
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto bits = decode_be(8, context);
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                elements.emplace_back(d);
+            }
+        } else {
+            long long n;
+            for (std::size_t i = 0; i < count; ++i) {
+                elements.emplace_back(nullptr);
+                if (decode_int(type, n)) {
+                    set_int(elements.back(), n);
+                } else {
+                    decode_value(elements.back(), type, context);
+                }
+            }
+        }
+        --depth;
+    }
+
+    void decode_object(value& v)
+    {
+        static const char context[] = "ubjson object";
+        enter('{', context);
+        v = json5pp::object();
+        auto& members = v.as_object();
+        int marker = next_marker();
+        int type;
+        std::size_t count;
+        std::string key;
+        if (!decode_header(marker, type, count, context)) {
+            for (; marker != '}'; marker = next_marker()) {
+                decode_string(key, marker);
+                decode_value(members[key], next_marker(), context);
+            }
+            --depth;
+            return;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            decode_string(key, next_byte(context));
+            decode_value(members[key], type ? type : next_marker(), context);
+        }
+        --depth;
+    }
+
+    const unsigned char* p;   ///< Next byte to decode
+    const unsigned char* end; ///< End of encoded bytes
+    std::size_t max_count;    ///< Remaining count of elements in typed null/boolean arrays
+    const std::size_t max_depth; ///< Maximum nesting of arrays / objects
+    std::size_t depth = 0;       ///< Current nesting of arrays / objects
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Encode value as UBJSON
+ *
+ * @param v A value to encode
+ * @param optimize If true, use count-prefixed containers and type-prefixed uniform arrays
+ * @return Encoded bytes
+ */
+inline std::string encode(const value& v, bool optimize = true)
+{
+    std::string out;
+    impl::encoder(out, optimize).encode_value(v);
+    return out;
+}
+
+/**
+ * @brief Encode value as UBJSON to an output stream
+ *
+ * @param ostream An output stream
+ * @param v A value to encode
+ * @param optimize If true, use count-prefixed containers and type-prefixed uniform arrays
+ */
+inline void encode(std::ostream& ostream, const value& v, bool optimize = true)
+{
+    const auto out = encode(v, optimize);
+    ostream.write(out.data(), static_cast<std::streamsize>(out.size()));
+}
+
+/**
+ * @brief Decode UBJSON
+ *
+ * @param pointer A pointer to encoded bytes
+ * @param length Number of bytes
+ * @param options Decode options (limits for untrusted input)
+ * @return JSON value
+ * @throws json5pp::syntax_error on malformed input or if a limit is exceeded
+ */
+inline value decode(const void* pointer, std::size_t length, const decode_options& options)
+{
+    value v;
+    impl::decoder(pointer, length, options).decode(v);
+    return v;
+}
+
+/**
+ * @brief Decode UBJSON
+ *
+ * @param pointer A pointer to encoded bytes
+ * @param length Number of bytes
+ * @param max_count Maximum total count of elements in typed null/boolean arrays (such elements take no bytes)
+ * @return JSON value
+ * @throws json5pp::syntax_error on malformed input or if a limit is exceeded
+ */
+inline value decode(const void* pointer, std::size_t length, std::size_t max_count = default_max_count)
+{
+    decode_options options;
+    options.max_count = max_count;
+    return decode(pointer, length, options);
+}
+
+/**
+ * @brief Decode UBJSON
+ *
+ * @param bytes Encoded bytes
+ * @param options Decode options (limits for untrusted input)
+ * @return JSON value
+ * @throws json5pp::syntax_error on malformed input or if a limit is exceeded
+ */
+inline value decode(const std::string& bytes, const decode_options& options)
+{
+    return decode(bytes.data(), bytes.size(), options);
+}
+
+/**
+ * @brief Decode UBJSON
+ *
+ * @param bytes Encoded bytes
+ * @param max_count Maximum total count of elements in typed null/boolean arrays (such elements take no bytes)
+ * @return JSON value
+ * @throws json5pp::syntax_error on malformed input or if a limit is exceeded
+ */
+inline value decode(const std::string& bytes, std::size_t max_count = default_max_count)
+{
+    return decode(bytes.data(), bytes.size(), max_count);
+}
+
+/**
+ * @brief Decode UBJSON from an input stream (reads until EOF)
+ *
+ * @param istream An input stream
+ * @param options Decode options (limits for untrusted input)
+ * @return JSON value
+ * @throws json5pp::syntax_error on malformed input or if a limit is exceeded
+ */
+inline value decode(std::istream& istream, const decode_options& options)
+{
+    const std::string bytes((std::istreambuf_iterator<char>(istream)), std::istreambuf_iterator<char>());
+    return decode(bytes, options);
+}
+
+/**
+ * @brief Decode UBJSON from an input stream (reads until EOF)
+ *
+ * @param istream An input stream
+ * @param max_count Maximum total count of elements in typed null/boolean arrays (such elements take no bytes)
+ * @return JSON value
+ * @throws json5pp::syntax_error on malformed input or if a limit is exceeded
+ */
+inline value decode(std::istream& istream, std::size_t max_count = default_max_count)
+{
+    decode_options options;
+    options.max_count = max_count;
+    return decode(istream, options);
+}
+
+} /* namespace ubjson */
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_UBJSON_HPP_ */
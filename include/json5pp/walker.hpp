@@ -0,0 +1,346 @@
+#ifndef _JSON5PP_WALKER_HPP_
+#define _JSON5PP_WALKER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "json5pp.hpp"
+#include "pointer.hpp"
+
+namespace json5pp {
+
+/**
+ * @brief Action returned by walk visitors
+ */
+enum class walk_action {
+    next, ///< Continue (visit children of the node)
+    skip, ///< Do not visit children of the node (pre-order visitor only)
+    stop, ///< Stop walking
+};
+
+/**
+ * @brief One step of the path from root to a node
+ */
+struct path_segment {
+    const std::string* key = nullptr; ///< Object key (nullptr for array element)
+    std::size_t index = 0;            ///< Array index (if key is nullptr)
+};
+
+/**
+ * @brief Options for walk_parallel()
+ */
+struct parallel_options {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency()); ///< Maximum number of threads
+    std::size_t min_children = 1024;                                       ///< Minimum children of a container to split
+};
+
+namespace impl {
+template <class V, class Pre, class Post>
+class walker;
+}
+
+/**
+ * @brief Position of the visited node
+ */
+class walk_context
+{
+public:
+    /// Depth of the node (0 for root)
+    std::size_t depth() const noexcept { return path.size(); }
+
+    /// Path from root to the node
+    const std::vector<path_segment>& segments() const noexcept { return path; }
+
+    /**
+     * @brief Get the path as JSON pointer (RFC 6901)
+     *
+     * @return JSON pointer string (empty for root)
+     */
+    std::string pointer() const
+    {
+        std::string result;
+        for (const auto& s : path) {
+            if (s.key) {
+                impl::append_pointer_token(result, *s.key);
+            } else {
+                impl::append_pointer_token(result, std::to_string(s.index));
+            }
+        }
+        return result;
+    }
+
+private:
+    template <class V, class Pre, class Post>
+    friend class impl::walker;
+
+    std::vector<path_segment> path; ///< Path from root to the node
+};
+
+namespace impl {
+
+/**
+ * @brief Visitor which does nothing
+ */
+struct no_visit {
+    template <class V>
+    void operator()(V&, const walk_context&) const {}
+};
+
+/**
+ * @brief Iterative (explicit stack) tree walker
+ *
+ * @tparam V value or const value
+ * @tparam Pre A typename of pre-order visitor
+ * @tparam Post A typename of post-order visitor
+ */
+template <class V, class Pre, class Post>
+class walker
+{
+private:
+    using object_iterator = decltype(std::declval<V&>().as_object().begin());
+
+    struct frame {
+        V* node;              ///< Container being visited
+        std::size_t index;    ///< Next element (array)
+        object_iterator iter; ///< Next member (object)
+    };
+
+public:
+    /**
+     * @brief Construct a new walker object
+     *
+     * @param pre Pre-order visitor
+     * @param post Post-order visitor
+     * @param parallel Options to split large containers (nullptr to walk sequentially)
+     * @param stopped Stop flag shared by all walkers
+     */
+    walker(Pre& pre, Post& post, const parallel_options* parallel, std::atomic<bool>& stopped)
+        : pre(pre), post(post), parallel(parallel), stopped(stopped) {}
+
+    /**
+     * @brief Walk a subtree
+     *
+     * @param root Root of the subtree
+     * @param ctx Context of root (path is restored on return)
+     * @retval true Walk completed
+     * @retval false Stopped by a visitor
+     */
+    bool run(V& root, walk_context& ctx)
+    {
+        const std::size_t base = ctx.path.size();
+        std::vector<frame> stack;
+        if (!visit(root, ctx, base, stack)) {
+            return false;
+        }
+        while (!stack.empty()) {
+            if (stopped.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            frame& f = stack.back();
+            V& node = *f.node;
+            if (node.is_array()) {
+                auto& elements = node.as_array();
+                if (f.index < elements.size()) {
+                    ctx.path.push_back(path_segment{nullptr, f.index});
+                    if (!visit(elements[f.index++], ctx, base, stack)) {
+                        return false;
+                    }
+                    continue;
+                }
+            } else if (f.iter != node.as_object().end()) {
+                ctx.path.push_back(path_segment{&f.iter->first, 0});
+                V& child = (f.iter++)->second;
+                if (!visit(child, ctx, base, stack)) {
+                    return false;
+                }
+                continue;
+            }
+            stack.pop_back();
+            if (!leave(node, ctx, base)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    /**
+     * @brief Invoke visitor (visitors may return void)
+     */
+    template <class F>
+    static walk_action call(F& f, V& node, const walk_context& ctx)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, V&, const walk_context&>>) {
+            f(node, ctx);
+            return walk_action::next;
+        } else {
+            return f(node, ctx);
+        }
+    }
+
+    /**
+     * @brief Call pre-order visitor and schedule children
+     *
+     * @retval false Stopped
+     */
+    bool visit(V& node, walk_context& ctx, std::size_t base, std::vector<frame>& stack)
+    {
+        const auto action = call(pre, node, ctx);
+        if (action == walk_action::stop) {
+            stopped = true;
+            return false;
+        }
+        if ((action == walk_action::next) && (node.is_array() || node.is_object()) && !node.empty()) {
+            if (parallel && (parallel->threads > 1) && (node.size() >= parallel->min_children)) {
+                if (!split(node, ctx)) {
+                    return false;
+                }
+            } else {
+                stack.push_back(frame{&node, 0, {}});
+                if (node.is_object()) {
+                    stack.back().iter = node.as_object().begin();
+                }
+                return true;
+            }
+        }
+        return leave(node, ctx, base);
+    }
+
+    /**
+     * @brief Call post-order visitor and leave the node
+     *
+     * @retval false Stopped
+     */
+    bool leave(V& node, walk_context& ctx, std::size_t base)
+    {
+        if (call(post, node, ctx) == walk_action::stop) {
+            stopped = true;
+            return false;
+        }
+        if (ctx.path.size() > base) {
+            ctx.path.pop_back();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Walk children of a large container in parallel
+     *
+     * @retval false Stopped
+     */
+    bool split(V& node, const walk_context& ctx)
+    {
+        std::vector<std::pair<V*, path_segment>> children;
+        children.reserve(node.size());
+        if (node.is_array()) {
+            std::size_t index = 0;
+            for (auto& e : node.as_array()) {
+                children.emplace_back(&e, path_segment{nullptr, index++});
+            }
+        } else {
+            for (auto& pair : node.as_object()) {
+                children.emplace_back(&pair.second, path_segment{&pair.first, 0});
+            }
+        }
+
+        const std::size_t count = std::min<std::size_t>(parallel->threads, children.size());
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(count);
+        for (std::size_t t = 0; t < count; ++t) {
+            const std::size_t first = children.size() * t / count;
+            const std::size_t last = children.size() * (t + 1) / count;
+            threads.emplace_back([&, t, first, last] {
+                try {
+                    walker<V, Pre, Post> worker(pre, post, nullptr, stopped);
+                    walk_context local = ctx;
+                    for (std::size_t i = first; (i < last) && !stopped.load(std::memory_order_relaxed); ++i) {
+                        local.path.push_back(children[i].second);
+                        if (!worker.run(*children[i].first, local)) {
+                            break;
+                        }
+                        local.path.pop_back();
+                    }
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                    stopped = true;
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        for (const auto& e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+        return !stopped;
+    }
+
+    Pre& pre;                          ///< Pre-order visitor
+    Post& post;                        ///< Post-order visitor
+    const parallel_options* parallel;  ///< Options to split large containers
+    std::atomic<bool>& stopped;        ///< Stop flag
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Walk all nodes of a tree (depth-first, without recursion)
+ *
+ * Visitors are called as `f(node, ctx)` and may return walk_action (or void
+ * for walk_action::next). Post-order visitor is called after children of the
+ * node are visited (or skipped). Visitors may modify the visited node, but
+ * must not add or remove members of its ancestors.
+ *
+ * @tparam V value or const value
+ * @param root Root of the tree
+ * @param pre Pre-order visitor
+ * @param post Post-order visitor
+ * @retval true Walk completed
+ * @retval false Stopped by a visitor
+ */
+template <class V, class Pre, class Post = impl::no_visit>
+requires std::is_same_v<std::remove_const_t<V>, value>
+bool walk(V& root, Pre&& pre, Post&& post = {})
+{
+    std::atomic<bool> stopped{false};
+    walk_context ctx;
+    return impl::walker<V, std::remove_reference_t<Pre>, std::remove_reference_t<Post>>(pre, post, nullptr, stopped).run(root, ctx);
+}
+
+/**
+ * @brief Walk all nodes of a tree, visiting children of large containers in parallel
+ *
+ * Same as walk(), but the children of the outermost containers which have
+ * at least options.min_children children are split among threads.
+ * Visitors must be thread-safe. Visiting order among split children is
+ * not specified; ancestors are visited (pre and post) on the calling thread.
+ *
+ * @tparam V value or const value
+ * @param root Root of the tree
+ * @param options Parallel options
+ * @param pre Pre-order visitor
+ * @param post Post-order visitor
+ * @retval true Walk completed
+ * @retval false Stopped by a visitor
+ */
+template <class V, class Pre, class Post = impl::no_visit>
+requires std::is_same_v<std::remove_const_t<V>, value>
+bool walk_parallel(V& root, const parallel_options& options, Pre&& pre, Post&& post = {})
+{
+    std::atomic<bool> stopped{false};
+    walk_context ctx;
+    return impl::walker<V, std::remove_reference_t<Pre>, std::remove_reference_t<Post>>(pre, post, &options, stopped).run(root, ctx);
+}
+
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_WALKER_HPP_ */
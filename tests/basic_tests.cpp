@@ -292,4 +292,26 @@ TEST_CASE("optional", tag)
 
     json5pp::value().get(i);
     CHECK(!i);
-}
\ No newline at end of file
+}
+
+TEST_CASE("lexer character classes", tag)
+{
+    // value tokens
+    CHECK(json5pp::parse5("[+1, .5, 0x1F, infinity, NaN, 'a', \"b\", null, true, false]").size() == 10);
+    CHECK(json5pp::parse5("0xfF") == 255.0);
+    CHECK_THROWS_AS(json5pp::parse("'a'"), json5pp::syntax_error);
+    CHECK_THROWS_AS(json5pp::parse("x"), json5pp::syntax_error);
+    CHECK_THROWS_AS(json5pp::parse(std::string("\0", 1)), json5pp::syntax_error);
+    CHECK_THROWS_AS(json5pp::parse("\xff"), json5pp::syntax_error);
+
+    // unquoted keys
+    CHECK(json5pp::parse5("{$a_1: 1, _: 2, Z9: 3}") == json5pp::parse(R"({"$a_1":1,"_":2,"Z9":3})"));
+    CHECK_THROWS_AS(json5pp::parse5("{1a: 1}"), json5pp::syntax_error);
+    CHECK_THROWS_AS(json5pp::parse("{a: 1}"), json5pp::syntax_error);
+
+    // spaces and comments
+    CHECK(json5pp::parse5(" \t\r\n// line\n/* block ** */ 1 /**/") == 1);
+    CHECK_THROWS_AS(json5pp::parse("/**/ 1"), json5pp::syntax_error);
+    CHECK_THROWS_AS(json5pp::parse5("1 /* open"), json5pp::syntax_error);
+    CHECK_THROWS_AS(json5pp::parse5("\f1"), json5pp::syntax_error);
+}
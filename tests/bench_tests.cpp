@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+
+#include "../tools/bench.hpp"
+
+/**
+ * @brief unit tests for benchmark results and comparison
+ */
+
+namespace {
+const auto tag = "[bench]";
+
+json5pp::bench::result make(const char* operation, std::vector<double> samples)
+{
+    json5pp::bench::result r;
+    r.workload = "records";
+    r.operation = operation;
+    r.bytes = 1000000;
+    r.samples = std::move(samples);
+    return r;
+}
+} // namespace
+
+TEST_CASE("bench statistics", tag)
+{
+    const auto s = json5pp::bench::summarize({1.0, 2.0, 3.0, 4.0, 100.0});
+    CHECK(s.count == 5);
+    CHECK(s.median == 3.0);
+    CHECK(s.mad == Approx(1.4826));
+    CHECK(s.min == 1.0);
+    CHECK(s.max == 100.0);
+    CHECK(json5pp::bench::summarize({4.0, 1.0, 3.0, 2.0}).median == 2.5);
+    CHECK(json5pp::bench::summarize({}).count == 0);
+}
+
+TEST_CASE("bench result file", tag)
+{
+    const std::vector<json5pp::bench::result> results = {make("parse", {1.0, 2.0}), make("stringify", {0.5})};
+    auto doc = json5pp::parse(json5pp::bench::to_json(results, json5pp::object({{"label", "x"}})).stringify());
+    CHECK(doc["context"]["label"] == "x");
+    // repeated runs of a benchmark are merged
+    doc["benchmarks"].as_array().push_back(doc["benchmarks"][0]);
+    const auto loaded = json5pp::bench::from_json(doc);
+    REQUIRE(loaded.size() == 2);
+    CHECK(loaded[0].name() == "parse/records");
+    CHECK(loaded[0].bytes == 1000000);
+    CHECK(loaded[0].samples == std::vector<double>{1.0, 2.0, 1.0, 2.0});
+    CHECK(loaded[1].samples == std::vector<double>{0.5});
+
+    CHECK_THROWS_AS(json5pp::bench::from_json(json5pp::parse(R"({"format":"other"})")), std::invalid_argument);
+    doc["benchmarks"][0]["samples"] = json5pp::array({"1"});
+    CHECK_THROWS_AS(json5pp::bench::from_json(doc), std::invalid_argument);
+}
+
+TEST_CASE("bench comparison", tag)
+{
+    const std::vector<double> base = {1.00, 1.02, 0.98, 1.01, 0.99, 1.03, 0.97, 1.00, 1.01, 0.99};
+    std::vector<double> slower, faster, noisy;
+    for (const auto s : base) {
+        slower.push_back(s * 1.25);
+        faster.push_back(s / 1.5);
+        noisy.push_back(s * 1.02);
+    }
+    const auto c = json5pp::bench::compare({make("parse", base), make("parse5", base), make("stringify", base), make("gone", base)},
+                                           {make("parse", slower), make("parse5", faster), make("stringify", noisy), make("added", base)});
+    REQUIRE(c.size() == 3);
+    CHECK(c[0].outcome == json5pp::bench::verdict::regressed);
+    CHECK(c[0].speedup == Approx(0.8));
+    CHECK(c[0].ci_low <= c[0].speedup);
+    CHECK(c[0].ci_high >= c[0].speedup);
+    CHECK(c[0].ci_high < 1);
+    CHECK(c[1].outcome == json5pp::bench::verdict::improved);
+    CHECK(c[2].outcome == json5pp::bench::verdict::same);
+
+    std::ostringstream os;
+    json5pp::bench::report(os, c);
+    CHECK(os.str().find("parse/records") != std::string::npos);
+    CHECK(os.str().find("regressed <<<") != std::string::npos);
+    CHECK(json5pp::bench::report_json(c)[1]["verdict"] == "improved");
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <json5pp/parse_cache.hpp>
+
+/**
+ * @brief unit tests for parse cache
+ *
+ */
+
+namespace {
+const auto tag = "[cache]";
+}
+
+TEST_CASE("parse cache hit", tag)
+{
+    json5pp::parse_cache cache;
+
+    auto a = cache.parse(R"({"foo":[1,2]})");
+    auto b = cache.parse(std::string(R"({"foo":[1,2]})"));
+    CHECK(a == b);
+    CHECK((*a)["foo"][1] == 2);
+
+    // rules are part of the key
+    auto c = cache.parse5(R"({"foo":[1,2]})");
+    CHECK(a != c);
+    CHECK(*a == *c);
+
+    auto s = cache.get_statistics();
+    CHECK(s.hits == 1);
+    CHECK(s.misses == 2);
+    CHECK(s.entries == 2);
+}
+
+TEST_CASE("parse cache errors", tag)
+{
+    json5pp::parse_cache cache;
+    CHECK_THROWS_AS(cache.parse("{foo:1}"), json5pp::syntax_error);
+    CHECK(cache.parse5("{foo:1}")->at("foo") == 1);
+    CHECK(cache.get_statistics().entries == 1);
+}
+
+TEST_CASE("parse cache eviction", tag)
+{
+    json5pp::parse_cache cache(2);
+
+    auto one = cache.parse("1");
+    cache.parse("2");
+    cache.parse("1"); // "2" becomes least recently used
+    cache.parse("3");
+
+    auto s = cache.get_statistics();
+    CHECK(s.entries == 2);
+    CHECK(s.evictions == 1);
+    CHECK(cache.parse("1") == one);
+    CHECK(cache.get_statistics().hits == 2);
+
+    cache.parse("2");
+    CHECK(cache.get_statistics().misses == 4);
+
+    cache.clear();
+    CHECK(cache.get_statistics().entries == 0);
+    CHECK(*one == 1);
+}
+
+TEST_CASE("parse cache bytes limit", tag)
+{
+    json5pp::parse_cache cache(16, 8);
+
+    cache.parse("[1,2]");
+    cache.parse("[3,4]"); // total 10 bytes > 8
+    CHECK(cache.get_statistics().entries == 1);
+    CHECK(cache.get_statistics().bytes == 5);
+
+    auto big = cache.parse("[1,2,3,4,5]"); // larger than the cache itself
+    CHECK(big->size() == 5);
+    CHECK(cache.get_statistics().entries == 1);
+}
+
+TEST_CASE("parse cache threads", tag)
+{
+    json5pp::parse_cache cache(4);
+    std::vector<std::thread> threads;
+    std::vector<json5pp::parse_cache::document> docs(8);
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&, i] {
+            for (int n = 0; n < 100; ++n) {
+                docs[i] = cache.parse(std::to_string(n % 3));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (const auto& d : docs) {
+        CHECK(*d == 0);
+    }
+    CHECK(cache.get_statistics().entries == 3);
+}
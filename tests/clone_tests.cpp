@@ -0,0 +1,84 @@
+#include <catch2/catch.hpp>
+
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+#include <json5pp/clone.hpp>
+
+/**
+ * @brief unit tests for parallel clone
+ *
+ */
+
+namespace {
+const auto tag = "[clone]";
+
+json5pp::value sample(int size)
+{
+    auto items = json5pp::array();
+    for (int i = 0; i < size; ++i) {
+        items.as_array().push_back(json5pp::object({{"id", i}, {"name", "item" + std::to_string(i)}, {"tags", json5pp::array({i % 2 == 0, nullptr, 0.5 * i})}}));
+    }
+    return json5pp::object({{"items", items}, {"empty", json5pp::array()}, {"meta", json5pp::object({{"count", size}, {"big", 1LL << 40}})}});
+}
+} // namespace
+
+TEST_CASE("clone equals the source", tag)
+{
+    const auto v = sample(1000);
+    for (unsigned threads : {1u, 2u, 4u, 16u}) {
+        json5pp::clone_options options;
+        options.threads = threads;
+        const auto c = json5pp::clone(v, options);
+        CHECK(c == v);
+        CHECK(c.stringify() == v.stringify());
+    }
+
+    // scalars and small trees
+    CHECK(json5pp::clone(json5pp::value(1)) == 1);
+    CHECK(json5pp::clone(json5pp::value("text")) == "text");
+    CHECK(json5pp::clone(json5pp::parse("[[[[1]]], {}]")) == json5pp::parse("[[[[1]]], {}]"));
+    CHECK(json5pp::clone(json5pp::array()).as_array().empty());
+}
+
+TEST_CASE("clone does not share storage", tag)
+{
+    auto v = sample(100);
+    auto c = json5pp::clone(v);
+    c["items"].as_array()[0]["name"] = "changed";
+    CHECK(v["items"][0]["name"] == "item0");
+}
+
+TEST_CASE("clone into another value type", tag)
+{
+    const auto v = sample(500);
+    std::pmr::synchronized_pool_resource arena;
+    for (unsigned threads : {1u, 4u}) {
+        json5pp::clone_options options;
+        options.threads = threads;
+        options.resource = &arena;
+        const auto c = json5pp::clone<json5pp::pmr_value>(v, options);
+        CHECK(c.stringify() == v.stringify());
+        CHECK(c.as_object().get_allocator().resource() == &arena);
+        CHECK(c.as_object().begin()->first.get_allocator().resource() == &arena);
+        CHECK(c["items"].as_array().get_allocator().resource() == &arena);
+        CHECK(c["items"][499].as_object().get_allocator().resource() == &arena);
+        CHECK(c["items"][499]["name"].as_string().get_allocator().resource() == &arena);
+        CHECK(c["items"][499]["tags"].as_array().get_allocator().resource() == &arena);
+        CHECK(c["meta"]["big"] == (1LL << 40));
+
+        // same value type into another arena
+        std::pmr::synchronized_pool_resource other;
+        options.resource = &other;
+        const auto d = json5pp::clone(c, options);
+        CHECK(d == c);
+        CHECK(d["items"][0]["name"].as_string().get_allocator().resource() == &other);
+    }
+    CHECK(std::pmr::get_default_resource() == std::pmr::new_delete_resource());
+
+    // and back again
+    json5pp::clone_options options;
+    options.resource = &arena;
+    CHECK(json5pp::clone<json5pp::value>(json5pp::clone<json5pp::pmr_value>(v, options)) == v);
+}
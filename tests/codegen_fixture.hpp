@@ -0,0 +1,127 @@
+// Generated by json5pp-codegen. Do not edit.
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <json5pp/codegen_support.hpp>
+#include <json5pp/json5pp.hpp>
+
+namespace fixture {
+
+struct Owner {
+    std::string first_name{};
+    std::vector<std::string> tags{};
+};
+
+struct PointsItem {
+    int x{};
+    int y{};
+};
+
+struct CatalogItem {
+    bool active{};
+    long long big{};
+    std::string class_{};
+    std::optional<std::string> comment{};
+    std::vector<json5pp::value> extra{};
+    int id{};
+    std::string name{};
+    std::optional<std::string> note{};
+    Owner owner{};
+    std::vector<PointsItem> points{};
+    double score{};
+};
+
+inline void from_json(const json5pp::value& v, Owner& out)
+{
+    json5pp::codegen_support::read(v["first-name"], out.first_name);
+    json5pp::codegen_support::read(v["tags"], out.tags);
+}
+
+inline json5pp::value to_json(const Owner& in)
+{
+    json5pp::value v = json5pp::object();
+    v["first-name"] = json5pp::codegen_support::write(in.first_name);
+    v["tags"] = json5pp::codegen_support::write(in.tags);
+    return v;
+}
+
+inline Owner parse_Owner(const std::string& json)
+{
+    Owner out;
+    from_json(json5pp::parse5(json), out);
+    return out;
+}
+
+inline void from_json(const json5pp::value& v, PointsItem& out)
+{
+    json5pp::codegen_support::read(v["x"], out.x);
+    json5pp::codegen_support::read(v["y"], out.y);
+}
+
+inline json5pp::value to_json(const PointsItem& in)
+{
+    json5pp::value v = json5pp::object();
+    v["x"] = json5pp::codegen_support::write(in.x);
+    v["y"] = json5pp::codegen_support::write(in.y);
+    return v;
+}
+
+inline PointsItem parse_PointsItem(const std::string& json)
+{
+    PointsItem out;
+    from_json(json5pp::parse5(json), out);
+    return out;
+}
+
+inline void from_json(const json5pp::value& v, CatalogItem& out)
+{
+    json5pp::codegen_support::read(v["active"], out.active);
+    json5pp::codegen_support::read(v["big"], out.big);
+    json5pp::codegen_support::read(v["class"], out.class_);
+    json5pp::codegen_support::read(v["comment"], out.comment);
+    json5pp::codegen_support::read(v["extra"], out.extra);
+    json5pp::codegen_support::read(v["id"], out.id);
+    json5pp::codegen_support::read(v["name"], out.name);
+    json5pp::codegen_support::read(v["note"], out.note);
+    json5pp::codegen_support::read(v["owner"], out.owner);
+    json5pp::codegen_support::read(v["points"], out.points);
+    json5pp::codegen_support::read(v["score"], out.score);
+}
+
+inline json5pp::value to_json(const CatalogItem& in)
+{
+    json5pp::value v = json5pp::object();
+    v["active"] = json5pp::codegen_support::write(in.active);
+    v["big"] = json5pp::codegen_support::write(in.big);
+    v["class"] = json5pp::codegen_support::write(in.class_);
+    if (in.comment) v["comment"] = json5pp::codegen_support::write(in.comment);
+    v["extra"] = json5pp::codegen_support::write(in.extra);
+    v["id"] = json5pp::codegen_support::write(in.id);
+    v["name"] = json5pp::codegen_support::write(in.name);
+    v["note"] = json5pp::codegen_support::write(in.note);
+    v["owner"] = json5pp::codegen_support::write(in.owner);
+    v["points"] = json5pp::codegen_support::write(in.points);
+    v["score"] = json5pp::codegen_support::write(in.score);
+    return v;
+}
+
+inline CatalogItem parse_CatalogItem(const std::string& json)
+{
+    CatalogItem out;
+    from_json(json5pp::parse5(json), out);
+    return out;
+}
+
+using Catalog = std::vector<CatalogItem>;
+
+inline Catalog parse_Catalog(const std::string& json)
+{
+    Catalog out;
+    json5pp::codegen_support::read(json5pp::parse5(json), out);
+    return out;
+}
+
+} // namespace fixture
@@ -0,0 +1,100 @@
+// Generated by json5pp-codegen. Do not edit.
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <json5pp/codegen_support.hpp>
+#include <json5pp/json5pp.hpp>
+
+namespace fixture {
+
+struct Customer {
+    std::string name{};
+    bool vip{};
+};
+
+struct LinesItem {
+    double price{};
+    int qty{};
+    std::string sku{};
+};
+
+struct Order {
+    Customer customer{};
+    std::vector<LinesItem> lines{};
+    json5pp::value note{};
+    int order_id{};
+};
+
+inline void from_json(const json5pp::value& v, Customer& out)
+{
+    json5pp::codegen_support::read(v["name"], out.name);
+    json5pp::codegen_support::read(v["vip"], out.vip);
+}
+
+inline json5pp::value to_json(const Customer& in)
+{
+    json5pp::value v = json5pp::object();
+    v["name"] = json5pp::codegen_support::write(in.name);
+    v["vip"] = json5pp::codegen_support::write(in.vip);
+    return v;
+}
+
+inline Customer parse_Customer(const std::string& json)
+{
+    Customer out;
+    from_json(json5pp::parse5(json), out);
+    return out;
+}
+
+inline void from_json(const json5pp::value& v, LinesItem& out)
+{
+    json5pp::codegen_support::read(v["price"], out.price);
+    json5pp::codegen_support::read(v["qty"], out.qty);
+    json5pp::codegen_support::read(v["sku"], out.sku);
+}
+
+inline json5pp::value to_json(const LinesItem& in)
+{
+    json5pp::value v = json5pp::object();
+    v["price"] = json5pp::codegen_support::write(in.price);
+    v["qty"] = json5pp::codegen_support::write(in.qty);
+    v["sku"] = json5pp::codegen_support::write(in.sku);
+    return v;
+}
+
+inline LinesItem parse_LinesItem(const std::string& json)
+{
+    LinesItem out;
+    from_json(json5pp::parse5(json), out);
+    return out;
+}
+
+inline void from_json(const json5pp::value& v, Order& out)
+{
+    json5pp::codegen_support::read(v["customer"], out.customer);
+    json5pp::codegen_support::read(v["lines"], out.lines);
+    json5pp::codegen_support::read(v["note"], out.note);
+    json5pp::codegen_support::read(v["order-id"], out.order_id);
+}
+
+inline json5pp::value to_json(const Order& in)
+{
+    json5pp::value v = json5pp::object();
+    v["customer"] = json5pp::codegen_support::write(in.customer);
+    v["lines"] = json5pp::codegen_support::write(in.lines);
+    v["note"] = json5pp::codegen_support::write(in.note);
+    v["order-id"] = json5pp::codegen_support::write(in.order_id);
+    return v;
+}
+
+inline Order parse_Order(const std::string& json)
+{
+    Order out;
+    from_json(json5pp::parse5(json), out);
+    return out;
+}
+
+} // namespace fixture
@@ -0,0 +1,187 @@
+#include <catch2/catch.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+#include <json5pp/shape.hpp>
+
+#include "../tools/codegen.hpp"
+#include "codegen_fixture.hpp"
+#include "codegen_fixture_order.hpp"
+
+/**
+ * @brief unit tests for C++ binding generator
+ */
+
+namespace {
+const auto tag = "[codegen]";
+
+std::string generate(std::initializer_list<const char*> samples, json5pp::codegen::options opts = {})
+{
+    json5pp::shape shape;
+    for (const auto sample : samples) {
+        shape.observe(json5pp::parse5(sample));
+    }
+    return json5pp::codegen::generate(shape, opts);
+}
+
+bool contains(const std::string& text, const std::string& part)
+{
+    return text.find(part) != std::string::npos;
+}
+
+// Sample of codegen_fixture.hpp, generated by:
+//   json5pp-codegen --root Catalog --namespace fixture sample.json > codegen_fixture.hpp
+const char* const catalog_sample = R"([
+  {"id": 1, "name": "alpha", "score": 1, "active": true, "class": "a", "big": 10000000000,
+   "owner": {"first-name": "Ann", "tags": ["x", "y"]}, "points": [{"x": 1, "y": 2}], "note": null, "extra": [1, "mixed"]},
+  {"id": 2, "name": "beta", "score": 2.5, "active": false, "class": "b", "big": 1,
+   "owner": {"first-name": "Bob", "tags": []}, "points": [], "note": "n", "extra": []},
+  {"id": 3, "name": "gamma", "score": 3, "active": true, "class": "c", "big": -5, "comment": "only here",
+   "owner": {"first-name": "Cy", "tags": ["z"]}, "points": [{"x": -1, "y": 0}, {"x": 5, "y": 6}], "note": null, "extra": [null]}
+])";
+
+// Sample of codegen_fixture_order.hpp (the same namespace as codegen_fixture.hpp), generated by:
+//   json5pp-codegen --root Order --namespace fixture order.json > codegen_fixture_order.hpp
+const char* const order_sample = R"({"order-id": 7, "customer": {"name": "Ann", "vip": true}, "lines": [{"sku": "a-1", "qty": 2, "price": 9.5}, {"sku": "b-2", "qty": 1, "price": 20}], "note": null})";
+} // namespace
+
+TEST_CASE("codegen scalar fields", tag)
+{
+    const auto code = generate({R"({"id": 1, "name": "a", "score": 1, "ok": true})",
+                                R"({"id": 2, "name": "b", "score": 2.5, "ok": false})"});
+    CHECK(contains(code, "struct Root {\n"));
+    CHECK(contains(code, "    int id{};\n"));
+    CHECK(contains(code, "    std::string name{};\n"));
+    CHECK(contains(code, "    double score{};\n"));
+    CHECK(contains(code, "    bool ok{};\n"));
+    CHECK(contains(code, "inline void from_json(const json5pp::value& v, Root& out)"));
+    CHECK(contains(code, "inline json5pp::value to_json(const Root& in)"));
+
+    json5pp::shape wide;
+    wide.observe(json5pp::object({{"big", 10000000000LL}}));
+    CHECK(contains(json5pp::codegen::generate(wide), "    long long big{};\n"));
+
+    // integers beyond int are parsed as double, but are still integral
+    const auto parsed = generate({R"({"big": 10000000000, "whole": 1, "real": 1})", R"({"big": 1, "whole": 1e10, "real": 0.5})"});
+    CHECK(contains(parsed, "    long long big{};\n"));
+    CHECK(contains(parsed, "    long long whole{};\n"));
+    CHECK(contains(parsed, "    double real{};\n"));
+}
+
+TEST_CASE("codegen optional fields", tag)
+{
+    const auto code = generate({R"({"a": 1, "b": null, "c": 1})", R"({"a": 2, "b": "x"})"});
+    CHECK(contains(code, "    int a{};\n"));
+    CHECK(contains(code, "    std::optional<std::string> b{};\n"));
+    CHECK(contains(code, "    std::optional<int> c{};\n"));
+    // missing fields are omitted when serialized, null fields are kept
+    CHECK(contains(code, "    if (in.c) v[\"c\"] = json5pp::codegen_support::write(in.c);\n"));
+    CHECK(contains(code, "    v[\"b\"] = json5pp::codegen_support::write(in.b);\n"));
+}
+
+TEST_CASE("codegen nested types", tag)
+{
+    const auto code = generate({R"({"user": {"first-name": "a"}, "items": [{"x": 1}], "tags": ["t"], "any": [1, "x"], "empty": []})"},
+                               {"Doc", "gen"});
+    CHECK(contains(code, "namespace gen {"));
+    CHECK(contains(code, "struct User {\n    std::string first_name{};\n};"));
+    CHECK(contains(code, "struct ItemsItem {\n    int x{};\n};"));
+    CHECK(contains(code, "    std::vector<ItemsItem> items{};\n"));
+    CHECK(contains(code, "    std::vector<std::string> tags{};\n"));
+    CHECK(contains(code, "    std::vector<json5pp::value> any{};\n"));
+    CHECK(contains(code, "    std::vector<json5pp::value> empty{};\n"));
+    CHECK(contains(code, "    User user{};\n"));
+    CHECK(contains(code, "json5pp::codegen_support::read(v[\"first-name\"], out.first_name);"));
+    // nested structs are declared before their users
+    CHECK(code.find("struct User {") < code.find("struct Doc {"));
+}
+
+TEST_CASE("codegen identifiers", tag)
+{
+    const auto code = generate({R"({"class": 1, "1st": 2, "a b": 3, "a-b": 4, "q\"": 5})"});
+    CHECK(contains(code, "    int class_{};\n"));
+    CHECK(contains(code, "    int _1st{};\n"));
+    CHECK(contains(code, "    int a_b{};\n"));
+    CHECK(contains(code, "    int a_b_2{};\n"));
+    CHECK(contains(code, "v[\"q\\\"\"]"));
+}
+
+TEST_CASE("codegen non-object root", tag)
+{
+    const auto code = generate({R"([{"a": 1}])"});
+    CHECK(contains(code, "struct RootItem {"));
+    CHECK(contains(code, "using Root = std::vector<RootItem>;"));
+    CHECK(contains(code, "inline Root parse_Root(const std::string& json)"));
+}
+
+TEST_CASE("codegen fixture is up to date", tag)
+{
+    json5pp::shape shape;
+    shape.observe(json5pp::parse(catalog_sample));
+    const auto code = json5pp::codegen::generate(shape, {"Catalog", "fixture"});
+    std::ifstream file(JSON5PP_TESTS_DIR "/codegen_fixture.hpp", std::ios::binary);
+    REQUIRE(file);
+    const std::string fixture((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    CHECK(code == fixture);
+
+    json5pp::shape order;
+    order.observe(json5pp::parse(order_sample));
+    std::ifstream order_file(JSON5PP_TESTS_DIR "/codegen_fixture_order.hpp", std::ios::binary);
+    REQUIRE(order_file);
+    const std::string order_fixture((std::istreambuf_iterator<char>(order_file)), std::istreambuf_iterator<char>());
+    CHECK(json5pp::codegen::generate(order, {"Order", "fixture"}) == order_fixture);
+}
+
+TEST_CASE("codegen fixture round trip", tag)
+{
+    const auto catalog = fixture::parse_Catalog(catalog_sample);
+    REQUIRE(catalog.size() == 3);
+    CHECK(catalog[0].class_ == "a");
+    CHECK(catalog[0].owner.first_name == "Ann");
+    CHECK(catalog[0].owner.tags == std::vector<std::string>{"x", "y"});
+    CHECK(catalog[1].score == 2.5);
+    CHECK(catalog[1].note == "n");
+    CHECK(!catalog[0].note);
+    CHECK(!catalog[0].comment);
+    CHECK(catalog[2].comment == "only here");
+    CHECK(catalog[2].points[1].y == 6);
+    static_assert(std::is_same_v<decltype(catalog[0].big), long long>);
+    CHECK(catalog[0].big == 10000000000LL);
+    CHECK(catalog[2].big == -5);
+
+    // to_json() gives the same document (missing optional fields stay missing)
+    const auto written = json5pp::codegen_support::write(catalog);
+    CHECK(written == json5pp::parse(catalog_sample));
+    CHECK(!written[0].contains("comment"));
+    CHECK(written[0]["note"].is_null());
+
+    // from_json() of the written document gives the same structs
+    fixture::Catalog again;
+    json5pp::codegen_support::read(written, again);
+    CHECK(json5pp::codegen_support::write(again) == written);
+    CHECK(fixture::to_json(again[2].points[0]) == json5pp::parse(R"({"x": -1, "y": 0})"));
+}
+
+TEST_CASE("codegen headers in one namespace", tag)
+{
+    // codegen_fixture.hpp and codegen_fixture_order.hpp share namespace fixture and the helpers
+    const auto order = fixture::parse_Order(order_sample);
+    CHECK(order.order_id == 7);
+    CHECK(order.customer.name == "Ann");
+    CHECK(order.customer.vip);
+    REQUIRE(order.lines.size() == 2);
+    CHECK(order.lines[0].sku == "a-1");
+    CHECK(order.lines[1].price == 20.0);
+    CHECK(order.note.is_null());
+    CHECK(json5pp::codegen_support::write(order) == json5pp::parse(order_sample));
+    CHECK(fixture::parse_Catalog(catalog_sample).size() == 3);
+
+    const auto code = generate({R"({"a": 1})"});
+    CHECK(contains(code, "#include <json5pp/codegen_support.hpp>\n"));
+    CHECK(!contains(code, "struct json5pp_codegen"));
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+
+/**
+ * @brief unit tests for comparison operators
+ *
+ */
+
+namespace {
+const auto tag = "[compare]";
+} // namespace
+
+TEST_CASE("equality across number types", tag)
+{
+    CHECK(json5pp::value(1) == json5pp::value(1.0));
+    CHECK(json5pp::value(1L) == json5pp::value(1LL));
+    CHECK(json5pp::value(1) != json5pp::value(1.5));
+    CHECK(json5pp::parse("[1, 2.0]") == json5pp::parse("[1.0, 2]"));
+    CHECK(json5pp::parse(R"({"a": 0})") == json5pp::object({{"a", 0.0}}));
+    CHECK(json5pp::value(3) == 3.0);
+    CHECK(json5pp::value(3.0) == 3);
+    CHECK(json5pp::value(-1) != 4294967295u);
+    CHECK(json5pp::value(std::numeric_limits<double>::quiet_NaN()) != json5pp::value(std::numeric_limits<double>::quiet_NaN()));
+}
+
+TEST_CASE("integers against floating point numbers above 2^53", tag)
+{
+    using json5pp::value;
+    // 9007199254740993 is not representable as double
+    CHECK(value(9007199254740993LL) != value(9007199254740992.0));
+    CHECK(value(9007199254740992.0) != value(9007199254740993LL));
+    CHECK(value(9007199254740992LL) == value(9007199254740992.0));
+    CHECK(value(9007199254740993LL) > value(9007199254740992.0));
+    CHECK(value(9007199254740992.0) < value(9007199254740993LL));
+    CHECK(value(9007199254740993LL) != 9007199254740992.0);
+    CHECK(value(std::numeric_limits<long long>::max()) < value(9223372036854775808.0));
+    CHECK(value(std::numeric_limits<long long>::min()) == value(-9223372036854775808.0));
+    CHECK(value(-1) > value(-1.5));
+    CHECK((value(1LL) <=> value(std::numeric_limits<double>::quiet_NaN())) == std::partial_ordering::unordered);
+}
+
+TEST_CASE("equality with literals", tag)
+{
+    const json5pp::value s = "text";
+    CHECK(s == "text");
+    CHECK("text" == s);
+    CHECK(s != "other");
+    CHECK(s == std::string("text"));
+    CHECK(s == std::string_view("text"));
+    const char* p = "text";
+    CHECK(s == p);
+
+    // different types are not equal (no exceptions)
+    CHECK(s != 1);
+    CHECK(json5pp::value(1) != "1");
+    CHECK(json5pp::value(nullptr) == nullptr);
+    CHECK(json5pp::value(false) != nullptr);
+    CHECK(json5pp::value(true) == true);
+    CHECK(json5pp::value(1) != true);
+}
+
+TEST_CASE("three-way ordering", tag)
+{
+    using json5pp::value;
+    CHECK(value(1) > value(0.5));
+    CHECK(value(0.5) < value(1));
+    CHECK(value(2LL) >= 2.0);
+    CHECK(value(-1) < 0u);
+    CHECK((value(std::numeric_limits<double>::quiet_NaN()) <=> value(1)) == std::partial_ordering::unordered);
+
+    // null < boolean < number < string < array < object
+    std::vector<value> values = {json5pp::object(), json5pp::array(), "a", 1, true, nullptr};
+    std::sort(values.begin(), values.end(), [](const value& a, const value& b) { return a < b; });
+    CHECK(values[0].is_null());
+    CHECK(values[1].is_boolean());
+    CHECK(values[2].is_number());
+    CHECK(values[3].is_string());
+    CHECK(values[4].is_array());
+    CHECK(values[5].is_object());
+
+    CHECK(value("abc") < "abd");
+    CHECK("abc" < value("abd"));
+    CHECK(value("b") > std::string("a"));
+    CHECK(json5pp::parse("[1, 2]") < json5pp::parse("[1, 2.5]"));
+    CHECK(json5pp::parse("[1, 2]") < json5pp::parse("[1, 2, 0]"));
+    CHECK(json5pp::parse(R"({"a": 1})") < json5pp::parse(R"({"b": 0})"));
+    CHECK(json5pp::parse(R"({"a": 1})") < json5pp::parse(R"({"a": 2})"));
+    CHECK(1 < value(2));
+    CHECK(value(false) < true);
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <json5pp/compressed.hpp>
+
+/**
+ * @brief unit tests for compressed documents
+ *
+ */
+
+namespace {
+const auto tag = "[compressed]";
+
+std::string roundtrip(const std::string& s)
+{
+    const auto c = json5pp::impl::lz_codec::compress(s.data(), s.size());
+    return json5pp::impl::lz_codec::decompress(c, s.size());
+}
+
+json5pp::value sample(int n)
+{
+    json5pp::value items = json5pp::array();
+    for (int i = 0; i < n; ++i) {
+        items.as_array().push_back(json5pp::object({
+            {"id", i},
+            {"title", "short"},
+            {"body", "Lorem ipsum dolor sit amet, consectetur adipiscing elit, record #" + std::to_string(i) + " ends here."},
+        }));
+    }
+    return json5pp::object({{"items", items}, {"text", std::string(300, 'x')}});
+}
+} // namespace
+
+TEST_CASE("lz codec", tag)
+{
+    CHECK(roundtrip("") == "");
+    CHECK(roundtrip("abc") == "abc");
+    CHECK(roundtrip(std::string(1000, 'a')) == std::string(1000, 'a'));
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += "key" + std::to_string(i % 37) + ":" + std::string(i % 23, 'z') + ";";
+    }
+    CHECK(roundtrip(text) == text);
+    CHECK(json5pp::impl::lz_codec::compress(text.data(), text.size()).size() < text.size() / 3);
+
+    const auto c = json5pp::impl::lz_codec::compress(text.data(), text.size());
+    CHECK_THROWS_AS(json5pp::impl::lz_codec::decompress(c.substr(0, c.size() / 2), text.size()), std::runtime_error);
+    CHECK_THROWS_AS(json5pp::impl::lz_codec::decompress(c, text.size() - 1), std::runtime_error);
+}
+
+TEST_CASE("compressed document access", tag)
+{
+    const auto v = sample(200);
+    json5pp::compression_options options;
+    options.min_length = 64;
+    options.block_size = 4096;
+    options.cache_blocks = 2;
+    const json5pp::compressed_document doc(v, options);
+
+    CHECK(doc.to_value() == v);
+    CHECK(doc["items"].size() == 200);
+    CHECK(doc["items"][7]["body"].as_string() == v["items"][7]["body"].as_string());
+    CHECK(doc["items"][7]["title"].as_string() == "short");
+    CHECK(doc["items"][7]["id"].as_integer() == 7);
+    CHECK(doc["items"][7]["missing"].is_null());
+    CHECK(doc["items"][199]["body"].get<std::string>() == v["items"][199]["body"].as_string());
+    CHECK(doc["text"].get<std::string>() == std::string(300, 'x'));
+    CHECK(doc["items"][3].to_value() == v["items"][3]);
+    CHECK(doc["items"][0].keys() == std::vector<std::string>{"body", "id", "title"});
+    CHECK_THROWS_AS(doc["items"].as_string(), std::bad_cast);
+
+    const auto stats = doc.get_statistics();
+    CHECK(stats.strings == 201);
+    CHECK(stats.blocks > 1);
+    CHECK(stats.compressed_bytes * 3 < stats.original_bytes);
+    CHECK(stats.cache_hits > 0);
+    CHECK(stats.cache_misses > 0);
+}
+
+TEST_CASE("compressed document threads", tag)
+{
+    const auto v = sample(500);
+    json5pp::compression_options options;
+    options.min_length = 64;
+    options.block_size = 1024;
+    const json5pp::compressed_document doc(v, options);
+    std::vector<std::thread> threads;
+    std::vector<int> ok(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = t; i < 500; i += 3) {
+                ok[t] += (doc["items"][i]["body"].as_string() == v["items"][i]["body"].as_string()) ? 1 : 0;
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    CHECK(ok == std::vector<int>{167, 167, 166, 166});
+}
+
+TEST_CASE("compressed document defaults", tag)
+{
+    static_assert(!std::is_copy_constructible_v<json5pp::compressed_document>);
+    static_assert(!std::is_move_constructible_v<json5pp::compressed_document>);
+    static_assert(!std::is_move_assignable_v<json5pp::compressed_document>);
+
+    // bodies are shorter than the default min_length
+    const auto v = sample(10);
+    const json5pp::compressed_document doc(v);
+    CHECK(doc.get_statistics().strings == 1);
+    CHECK(doc["text"].as_string() == std::string(300, 'x'));
+    CHECK(doc["items"][9]["body"].as_string() == v["items"][9]["body"].as_string());
+    CHECK(doc.to_value() == v);
+}
@@ -0,0 +1,151 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <json5pp/diff.hpp>
+
+/**
+ * @brief unit tests for pull parser and diff
+ *
+ */
+
+namespace {
+const auto tag = "[diff]";
+
+json5pp::value stream_diff(const std::string& a, const std::string& b, const json5pp::diff_options& options = {})
+{
+    std::istringstream x(a), y(b);
+    return json5pp::diff(x, y, options).to_patch();
+}
+
+// stream diff must be the same as tree diff, and the patch must turn a into b
+void check_patch(const std::string& a, const std::string& b)
+{
+    const auto patch = stream_diff(a, b);
+    CHECK(patch == json5pp::diff(json5pp::parse(a), json5pp::parse(b)).to_patch());
+    auto v = json5pp::parse(a);
+    json5pp::apply_patch(v, patch);
+    CHECK(v == json5pp::parse(b));
+}
+} // namespace
+
+TEST_CASE("pull parser events", tag)
+{
+    std::istringstream is(R"({"a": [1, "x", {}], "b": null} [true])");
+    json5pp::pull_parser p(is);
+    using e = json5pp::parse_event;
+    CHECK(p.next() == e::begin_object);
+    CHECK(p.offset() == 0);
+    CHECK(p.next() == e::key);
+    CHECK(p.key() == "a");
+    CHECK(p.offset() == 1);
+    CHECK(p.next() == e::begin_array);
+    CHECK(p.depth() == 2);
+    CHECK(p.next() == e::scalar);
+    CHECK(p.scalar() == 1);
+    CHECK(p.next() == e::scalar);
+    CHECK(p.scalar() == "x");
+    CHECK(p.next() == e::begin_object);
+    CHECK(p.next() == e::end_object);
+    CHECK(p.next() == e::end_array);
+    CHECK(p.next() == e::key);
+    CHECK(p.key() == "b");
+    CHECK(p.next() == e::scalar);
+    CHECK(p.scalar().is_null());
+    CHECK(p.next() == e::end_object);
+    CHECK(p.depth() == 0);
+    // next document
+    CHECK(p.next() == e::begin_array);
+    CHECK(p.offset() == 31);
+    CHECK(p.read_value() == json5pp::parse("[true]"));
+    CHECK(p.event() == e::end_array);
+    CHECK(p.next() == e::end_of_input);
+}
+
+TEST_CASE("pull parser skip and syntax errors", tag)
+{
+    std::istringstream is(R"([{"a": [1, [2]]}, 3])");
+    json5pp::pull_parser p(is);
+    p.next();
+    p.next();
+    p.skip();
+    CHECK(p.event() == json5pp::parse_event::end_object);
+    CHECK(p.next() == json5pp::parse_event::scalar);
+    CHECK(p.scalar() == 3);
+
+    auto events = [](const std::string& text, bool json5) {
+        std::istringstream is(text);
+        json5pp::pull_parser p(is, json5);
+        while (p.next() != json5pp::parse_event::end_of_input) {
+        }
+    };
+    CHECK_THROWS_AS(events("[1 2]", false), json5pp::syntax_error);
+    CHECK_THROWS_AS(events("[1,]", false), json5pp::syntax_error);
+    CHECK_THROWS_AS(events("{\"a\" 1}", false), json5pp::syntax_error);
+    CHECK_THROWS_AS(events("[1", false), json5pp::syntax_error);
+    CHECK_NOTHROW(events("[1,]", true));
+    CHECK_NOTHROW(events("{a: 1, // comment\n}", true));
+}
+
+TEST_CASE("diff of same documents", tag)
+{
+    CHECK(stream_diff(R"({"a":[1,{"b":null}],"c":"x"})", R"({ "a" : [ 1, {"b": null} ], "c": "x" })").as_array().empty());
+}
+
+TEST_CASE("diff scalars and types", tag)
+{
+    CHECK(stream_diff("1", "2") == json5pp::parse(R"([{"op":"replace","path":"","value":2}])"));
+    CHECK(stream_diff(R"({"a":1,"b":[1]})", R"({"a":"1","b":{"x":[2]}})") == json5pp::parse(R"([
+        {"op":"replace","path":"/a","value":"1"},
+        {"op":"replace","path":"/b","value":{"x":[2]}}
+    ])"));
+}
+
+TEST_CASE("diff arrays", tag)
+{
+    CHECK(stream_diff("[1,2]", "[1,2,[3],4]") == json5pp::parse(R"([
+        {"op":"add","path":"/2","value":[3]},
+        {"op":"add","path":"/3","value":4}
+    ])"));
+    CHECK(stream_diff("[1,[2],{},4]", "[0]") == json5pp::parse(R"([
+        {"op":"replace","path":"/0","value":0},
+        {"op":"remove","path":"/3"},
+        {"op":"remove","path":"/2"},
+        {"op":"remove","path":"/1"}
+    ])"));
+    check_patch("[1,[2],{},4]", "[0]");
+    check_patch("[[1,2],[3]]", "[[1],[3,4,5]]");
+}
+
+TEST_CASE("diff objects", tag)
+{
+    // same order
+    CHECK(stream_diff(R"({"a":1,"b":{"c":2}})", R"({"a":1,"b":{"c":3}})") == json5pp::parse(R"([
+        {"op":"replace","path":"/b/c","value":3}
+    ])"));
+    // out of order, added and removed keys
+    CHECK(stream_diff(R"({"a":1,"b":2,"c":3})", R"({"c":3,"a":1,"d":4})") == json5pp::parse(R"([
+        {"op":"remove","path":"/b"},
+        {"op":"add","path":"/d","value":4}
+    ])"));
+    check_patch(R"({"x":{"a":1,"b":[1,2]},"y":[{"k":"~/"}]})", R"({"y":[{"k":"/~","n":null}],"x":{"b":[2],"a":1}})");
+}
+
+TEST_CASE("diff records", tag)
+{
+    json5pp::diff_options options;
+    options.records = true;
+    CHECK(stream_diff("{\"id\":1}\n{\"id\":2}\n{\"id\":3}\n", "{\"id\":1}\n{\"id\":20}\n", options) == json5pp::parse(R"([
+        {"op":"replace","path":"/1/id","value":20},
+        {"op":"remove","path":"/2"}
+    ])"));
+
+    std::vector<std::string> paths;
+    std::istringstream x("{a:1}"), y("{a:2,}");
+    options.json5 = true;
+    options.records = false;
+    json5pp::diff(x, y, [&](json5pp::change_op, const json5pp::pointer& path, const json5pp::value&) { paths.push_back(path.to_string()); }, options);
+    CHECK(paths == std::vector<std::string>{"/a"});
+}
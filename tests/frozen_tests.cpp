@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+
+#include <json5pp/frozen.hpp>
+
+/**
+ * @brief unit tests for frozen documents
+ *
+ */
+
+namespace {
+const auto tag = "[frozen]";
+
+const char* sample = R"({
+    "name": "reference", "version": 3, "ratio": 0.5, "big": 1e300, "ok": true, "none": null,
+    "list": [1, "two", [3], {"four": 4}, []],
+    "nested": {"b": {"c": "deep"}, "a": {}, "": "empty key"}
+})";
+} // namespace
+
+TEST_CASE("frozen round trip", tag)
+{
+    const auto v = json5pp::parse(sample);
+    const auto buffer = json5pp::frozen::freeze(v);
+    const json5pp::frozen::document doc(buffer);
+    CHECK(doc.root().to_value() == v);
+
+    // relocatable: copy to another (aligned) place
+    std::string moved(buffer.size() + 8, '\0');
+    auto* aligned = moved.data() + ((8 - reinterpret_cast<std::uintptr_t>(moved.data()) % 8) % 8);
+    std::copy(buffer.begin(), buffer.end(), aligned);
+    CHECK(json5pp::frozen::document(aligned, buffer.size()).root().to_value() == v);
+}
+
+TEST_CASE("frozen accessors", tag)
+{
+    const auto buffer = json5pp::frozen::freeze(json5pp::parse(sample));
+    const json5pp::frozen::document doc(buffer);
+
+    CHECK(doc.root().is_object());
+    CHECK(doc.root().size() == 8);
+    CHECK(doc["name"].as_string() == "reference");
+    CHECK(doc["version"].is_integer());
+    CHECK(doc["version"].as_integer() == 3);
+    CHECK(doc["version"].as_number() == 3.0);
+    CHECK(doc["ratio"].as_number() == 0.5);
+    CHECK(doc["big"].as_number() == 1e300);
+    CHECK(doc["ok"].as_boolean());
+    CHECK(doc["none"].is_null());
+    CHECK(doc["missing"].is_null());
+    CHECK(doc.root().contains("none"));
+    CHECK_FALSE(doc.root().contains("missing"));
+
+    const auto list = doc["list"];
+    CHECK(list.is_array());
+    CHECK(list.size() == 5);
+    CHECK(list[0].as_integer() == 1);
+    CHECK(list[1].as_string() == "two");
+    CHECK(list[2][0].as_integer() == 3);
+    CHECK(list[3]["four"].as_integer() == 4);
+    CHECK(list[4].empty());
+    CHECK(list[5].is_null());
+    CHECK(list[-1].is_null());
+
+    const auto nested = doc["nested"];
+    CHECK(nested[""].as_string() == "empty key");
+    CHECK(nested["b"]["c"].as_string() == "deep");
+    CHECK(nested.key(0) == "");
+    CHECK(nested.key(1) == "a");
+    CHECK(nested.member(2)["c"].as_string() == "deep");
+
+    CHECK_THROWS_AS(doc["name"].as_number(), std::bad_cast);
+    CHECK_THROWS_AS(doc["version"].as_string(), std::bad_cast);
+    CHECK_THROWS_AS(doc["name"].size(), std::runtime_error);
+}
+
+TEST_CASE("frozen key lookup on non-objects", tag)
+{
+    const auto buffer = json5pp::frozen::freeze(json5pp::parse(sample));
+    const json5pp::frozen::document doc(buffer);
+
+    // array, string and number nodes have no members
+    for (const char* name : {"list", "name", "version", "ok", "none"}) {
+        const auto n = doc[name];
+        CHECK(n["x"].is_null());
+        CHECK(n[""].is_null());
+        CHECK(n["reference"].is_null());
+    }
+    CHECK(doc["list"][1]["two"].is_null());
+    CHECK(doc["nested"]["a"]["x"].is_null());
+    CHECK_THROWS_AS(doc["list"].contains("x"), std::bad_cast);
+    CHECK_THROWS_AS(doc["name"].contains("x"), std::bad_cast);
+}
+
+TEST_CASE("frozen scalar root", tag)
+{
+    const auto buffer = json5pp::frozen::freeze(json5pp::value("text"));
+    CHECK(json5pp::frozen::document(buffer).root().as_string() == "text");
+}
+
+TEST_CASE("frozen invalid buffers", tag)
+{
+    auto buffer = json5pp::frozen::freeze(json5pp::parse(sample));
+    CHECK_THROWS_AS(json5pp::frozen::document(std::string_view(buffer.data(), 16)), std::runtime_error);
+    CHECK_THROWS_AS(json5pp::frozen::document(std::string_view(buffer.data(), buffer.size() - 8)), std::runtime_error);
+
+    auto broken = buffer;
+    broken[0] = 'X';
+    CHECK_THROWS_AS(json5pp::frozen::document(broken), std::runtime_error);
+
+    // root object pointing back to the header
+    broken = buffer;
+    const std::uint64_t offset = 0;
+    std::memcpy(broken.data() + 24, &offset, sizeof(offset));
+    CHECK_THROWS_AS(json5pp::frozen::document(broken), std::runtime_error);
+    CHECK_NOTHROW(json5pp::frozen::document(broken, false));
+}
+
+#ifdef _JSON5PP_FROZEN_MMAP_
+TEST_CASE("frozen mapped file", tag)
+{
+    const auto v = json5pp::parse(sample);
+    const std::string path = "json5pp_frozen_test.bin";
+    {
+        std::ofstream ofs(path, std::ios::binary);
+        json5pp::frozen::freeze(ofs, v);
+    }
+    {
+        const json5pp::frozen::mapped_document doc(path);
+        CHECK(doc["nested"]["b"]["c"].as_string() == "deep");
+        CHECK(doc.root().to_value() == v);
+    }
+    std::remove(path.c_str());
+    CHECK_THROWS_AS(json5pp::frozen::mapped_document(path), std::runtime_error);
+}
+#endif
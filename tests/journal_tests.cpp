@@ -0,0 +1,130 @@
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+
+#include <json5pp/journal.hpp>
+
+/**
+ * @brief unit tests for change journal
+ *
+ */
+
+namespace {
+const auto tag = "[journal]";
+}
+
+TEST_CASE("journal records mutations", tag)
+{
+    const auto original = json5pp::parse(R"({"server":{"host":"a","port":80},"users":["root"],"debug":true})");
+    json5pp::journaled doc(original);
+
+    doc["server"]["port"] = 8080;
+    doc["server"]["tls"] = true;
+    doc["users"].append("guest");
+    doc["users"][0] = "admin";
+    doc.ref().erase("debug");
+    doc.ref().erase("missing");
+
+    CHECK(doc.document() == json5pp::parse(R"({"server":{"host":"a","port":8080,"tls":true},"users":["admin","guest"]})"));
+    CHECK(doc.changes().size() == 5);
+    CHECK(doc.changes().to_patch() == json5pp::parse(R"([
+        {"op":"replace","path":"/server/port","value":8080},
+        {"op":"add","path":"/server/tls","value":true},
+        {"op":"add","path":"/users/1","value":"guest"},
+        {"op":"replace","path":"/users/0","value":"admin"},
+        {"op":"remove","path":"/debug"}
+    ])"));
+
+    // replicate
+    auto replica = original;
+    doc.changes().apply(replica);
+    CHECK(replica == doc.document());
+
+    replica = original;
+    json5pp::apply_patch(replica, json5pp::parse(doc.changes().to_patch().stringify()));
+    CHECK(replica == doc.document());
+}
+
+TEST_CASE("journal coalesces repeated assignments", tag)
+{
+    json5pp::journaled doc(json5pp::parse(R"({"a":1})"));
+    doc["a"] = 2;
+    doc["a"] = 3;
+    doc["b"] = 1;
+    doc["b"] = 2;
+    REQUIRE(doc.changes().size() == 2);
+    CHECK(doc.changes().entries()[0].op == json5pp::change_op::replace);
+    CHECK(doc.changes().entries()[0].data == 3);
+    CHECK(doc.changes().entries()[1].op == json5pp::change_op::add);
+    CHECK(doc.changes().entries()[1].data == 2);
+
+    doc.changes().clear();
+    CHECK(doc.changes().empty());
+}
+
+TEST_CASE("journal tracked references", tag)
+{
+    json5pp::journaled doc(json5pp::parse(R"({"list":[1,2,3],"a/b":{"~":0}})"));
+    auto list = doc["list"];
+    list.append(4);
+    list.erase(0);
+    CHECK(list.get() == json5pp::parse("[2,3,4]"));
+    CHECK(list.path().to_string() == "/list");
+    CHECK(doc["a/b"]["~"].path().to_string() == "/a~1b/~0");
+    CHECK(doc["a/b"]["~"].exists());
+    CHECK_FALSE(doc["x"]["y"].exists());
+
+    doc["copy"] = doc["list"];
+    CHECK(doc.document()["copy"] == json5pp::parse("[2,3,4]"));
+
+    // missing element, index out of range
+    CHECK_THROWS_AS(doc["list"][5]["y"] = 1, std::out_of_range);
+    CHECK_THROWS_AS(doc["list"][5] = 1, std::out_of_range);
+    CHECK_THROWS_AS(doc["x"].get(), std::out_of_range);
+
+    doc.ref() = json5pp::parse("[]");
+    CHECK(doc.changes().entries().back().path.empty());
+    CHECK(doc.document() == json5pp::parse("[]"));
+}
+
+TEST_CASE("journal adds missing members", tag)
+{
+    const auto original = json5pp::parse(R"({"a":{},"n":1})");
+    json5pp::journaled doc(original);
+    doc["x"]["y"]["z"] = 1;
+    doc["a"]["b"] = 2;
+    CHECK(doc.document() == json5pp::parse(R"({"a":{"b":2},"n":1,"x":{"y":{"z":1}}})"));
+    CHECK(doc.changes().to_patch() == json5pp::parse(R"([
+        {"op":"add","path":"/x","value":{}},
+        {"op":"add","path":"/x/y","value":{}},
+        {"op":"add","path":"/x/y/z","value":1},
+        {"op":"add","path":"/a/b","value":2}
+    ])"));
+
+    auto replica = original;
+    doc.changes().apply(replica);
+    CHECK(replica == doc.document());
+
+    // not an object
+    CHECK_THROWS_AS(doc["n"]["y"]["z"] = 1, std::out_of_range);
+    CHECK(doc.changes().size() == 4);
+}
+
+TEST_CASE("apply JSON patch", tag)
+{
+    auto v = json5pp::parse(R"({"a":[1,3]})");
+    json5pp::apply_patch(v, json5pp::parse(R"([
+        {"op":"add","path":"/a/1","value":2},
+        {"op":"add","path":"/a/-","value":4},
+        {"op":"add","path":"/b","value":{}},
+        {"op":"replace","path":"/b","value":"x"},
+        {"op":"remove","path":"/a/0"}
+    ])"));
+    CHECK(v == json5pp::parse(R"({"a":[2,3,4],"b":"x"})"));
+
+    CHECK_THROWS_AS(json5pp::apply_patch(v, json5pp::parse(R"({})")), std::invalid_argument);
+    CHECK_THROWS_AS(json5pp::apply_patch(v, json5pp::parse(R"([{"op":"move","path":"/a","from":"/b"}])")), std::invalid_argument);
+    CHECK_THROWS_AS(json5pp::apply_patch(v, json5pp::parse(R"([{"op":"add","path":"/c"}])")), std::invalid_argument);
+    CHECK_THROWS_AS(json5pp::apply_patch(v, json5pp::parse(R"([{"op":"replace","path":"/c","value":1}])")), std::out_of_range);
+    CHECK_THROWS_AS(json5pp::apply_patch(v, json5pp::parse(R"([{"op":"remove","path":"/a/3"}])")), std::out_of_range);
+}
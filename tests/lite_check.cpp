@@ -0,0 +1,21 @@
+/**
+ * @brief Build check of json5pp/lite.hpp without exceptions and RTTI
+ *
+ * Compiled with -fno-exceptions -fno-rtti (not linked to unit tests).
+ */
+
+#include <json5pp/lite.hpp>
+
+#if defined(_GLIBCXX_IOSTREAM) || defined(_GLIBCXX_ISTREAM) || defined(_GLIBCXX_OSTREAM) || defined(_GLIBCXX_SSTREAM)
+#error "json5pp/lite.hpp must not include iostreams"
+#endif
+
+std::size_t json5pp_lite_check(char* text, std::size_t size, char* buffer, std::size_t capacity)
+{
+    json5pp::lite::node nodes[32];
+    const auto result = json5pp::lite::parse5(text, size, nodes);
+    if (!result) {
+        return 0;
+    }
+    return json5pp::lite::stringify(*result.root, buffer, capacity, 2).size;
+}
@@ -0,0 +1,157 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <string>
+#include <string_view>
+
+#include <json5pp/json5pp.hpp>
+#include <json5pp/lite.hpp>
+
+/**
+ * @brief unit tests for low-footprint parse / stringify
+ *
+ */
+
+namespace {
+const auto tag = "[lite]";
+
+namespace lite = json5pp::lite;
+
+// Parse a copy of text, and stringify it back
+std::string roundtrip(std::string text, lite::rules_type rules = lite::rule::ecma404, int indent = 0)
+{
+    lite::node nodes[64];
+    const auto result = lite::parse(text.data(), text.size(), nodes, rules);
+    REQUIRE(result);
+    char buffer[512];
+    const auto written = (rules == lite::rule::ecma404) ? lite::stringify(*result.root, buffer, sizeof(buffer), indent)
+                                                        : lite::stringify5(*result.root, buffer, sizeof(buffer), indent);
+    REQUIRE(written);
+    return std::string(buffer, written.size);
+}
+
+lite::errc parse_error(std::string text, lite::rules_type rules = lite::rule::ecma404)
+{
+    lite::node nodes[16];
+    return lite::parse(text.data(), text.size(), nodes, rules).ec;
+}
+} // namespace
+
+TEST_CASE("lite parse and access", tag)
+{
+    std::string text = R"({"name": "gw\u00e9\n", "id": 42, "ratio": 0.5, "on": true, "tags": [1, null, "x"], "big": 12345678901234})";
+    lite::node nodes[16];
+    const auto result = lite::parse(text.data(), text.size(), nodes);
+    REQUIRE(result);
+    CHECK(result.nodes == 10);
+    const auto& root = *result.root;
+    CHECK(root.is_object());
+    CHECK(root.size() == 6);
+    CHECK(root.find("name")->as_string() == "gw\xc3\xa9\n");
+    CHECK(root.find("id")->is_integer());
+    CHECK(root.find("id")->as_integer() == 42);
+    CHECK(root.find("ratio")->as_number() == 0.5);
+    CHECK(root.find("on")->as_boolean());
+    CHECK(root.find("big")->as_integer() == 12345678901234LL);
+    CHECK(root.find("missing") == nullptr);
+
+    const auto* tags = root.find("tags");
+    REQUIRE(tags != nullptr);
+    CHECK(tags->size() == 3);
+    CHECK(tags->at(0)->as_integer() == 1);
+    CHECK(tags->at(1)->is_null());
+    CHECK(tags->at(2)->as_string() == "x");
+    CHECK(tags->at(3) == nullptr);
+
+    // members keep the order of the text
+    std::string keys;
+    for (const auto& member : root) {
+        keys.append(member.key()).append(",");
+    }
+    CHECK(keys == "name,id,ratio,on,tags,big,");
+
+    // other types give defaults
+    CHECK(root.find("id")->as_string().empty());
+    CHECK(root.find("name")->as_integer() == 0);
+    CHECK(root.at(0) == nullptr);
+}
+
+TEST_CASE("lite stringify matches json5pp", tag)
+{
+    for (const char* text : {R"({"a":[1,-2,3.25,1e+30,"q\"\\\t\u0001"],"b":{"c":null,"d":false},"e":[],"f":{}})",
+                             "[0.1,1.0,-0,1234567890,1.5e-07]", "\"\"", "true"}) {
+        CHECK(roundtrip(text) == json5pp::parse(text).stringify());
+        CHECK(roundtrip(text, lite::rule::ecma404, 2) == json5pp::stringify(json5pp::parse(text), json5pp::rule::space_indent<2>()));
+        CHECK(roundtrip(text, lite::rule::ecma404, -1) == json5pp::stringify(json5pp::parse(text), json5pp::rule::tab_indent<>()));
+    }
+}
+
+TEST_CASE("lite JSON5", tag)
+{
+    const char* text = R"(// comment
+        {unquoted: 'single', /* block */ hex: 0xff, plus: +1, lead: .5, trail: 5., inf: -infinity, nan: NaN,
+         str: 'a\
+b', list: [1, 2,],})";
+    CHECK(roundtrip(text, lite::rule::json5) == R"({"unquoted":"single","hex":255,"plus":1,"lead":0.5,"trail":5,"inf":-infinity,"nan":NaN,"str":"ab","list":[1,2]})");
+    CHECK(parse_error(text) == lite::errc::syntax_error);
+
+    // NaN and infinity are null in ECMA-404 output
+    std::string nan = "[NaN, infinity]";
+    lite::node nodes[4];
+    char buffer[32];
+    const auto result = lite::parse5(nan.data(), nan.size(), nodes);
+    REQUIRE(result);
+    const auto written = lite::stringify(*result.root, buffer, sizeof(buffer));
+    CHECK(std::string_view(buffer, written.size) == "[null,null]");
+}
+
+TEST_CASE("lite errors", tag)
+{
+    CHECK(parse_error("") == lite::errc::unexpected_end);
+    CHECK(parse_error("[1, 2") == lite::errc::unexpected_end);
+    CHECK(parse_error("\"abc") == lite::errc::unexpected_end);
+    CHECK(parse_error("[1 2]") == lite::errc::syntax_error);
+    CHECK(parse_error("[1,]") == lite::errc::syntax_error);
+    CHECK(parse_error("{a: 1}") == lite::errc::syntax_error);
+    CHECK(parse_error("01") == lite::errc::syntax_error);
+    CHECK(parse_error("tru") == lite::errc::unexpected_end);
+    CHECK(parse_error("nul!") == lite::errc::syntax_error);
+    CHECK(parse_error("\"\\x\"") == lite::errc::syntax_error);
+    CHECK(parse_error("[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16]") == lite::errc::out_of_nodes);
+    CHECK(parse_error("/* open", lite::rule::json5) == lite::errc::unexpected_end);
+
+    std::string deep = "[[[[1]]]]";
+    lite::node nodes[8];
+    CHECK(lite::parse(deep.data(), deep.size(), nodes, lite::rule::ecma404, 3).ec == lite::errc::too_deep);
+    const auto result = lite::parse(deep.data(), deep.size(), nodes, lite::rule::ecma404, 4);
+    CHECK(result);
+
+    // error offset points to the illegal character
+    std::string bad = "[1, x]";
+    const auto error = lite::parse(bad.data(), bad.size(), nodes);
+    CHECK(error.ec == lite::errc::syntax_error);
+    CHECK(error.offset == 4);
+    CHECK(error.root == nullptr);
+    CHECK(std::string(lite::message(error.ec)).find("syntax") != std::string::npos);
+}
+
+TEST_CASE("lite short buffer and sink", tag)
+{
+    std::string text = R"({"key": "value"})";
+    lite::node nodes[4];
+    const auto result = lite::parse(text.data(), text.size(), nodes);
+    REQUIRE(result);
+
+    char buffer[8];
+    const auto written = lite::stringify(*result.root, buffer, sizeof(buffer));
+    CHECK(written.ec == lite::errc::out_of_space);
+    CHECK(written.size == 15);
+    CHECK(std::string_view(buffer, sizeof(buffer)) == "{\"key\":\"");
+
+    struct string_sink {
+        std::string text;
+        void write(const char* data, std::size_t size) { text.append(data, size); }
+    } sink;
+    lite::stringify(sink, *result.root, 1);
+    CHECK(sink.text == "{\n \"key\": \"value\"\n}");
+}
@@ -66,4 +66,48 @@ TEST_CASE("Modifier", tag)
         // in javascript, it means v.age === null
         CHECK(v["age"].is_null());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("stringify keys", tag)
+{
+    auto records = json5pp::array({
+        json5pp::object({{"id", 1}, {"na\"me", "foo"}, {"tab\t", true}}),
+        json5pp::object({{"id", 2}, {"na\"me", "bar"}, {"tab\t", false}}),
+    });
+
+    SECTION("no indent")
+    {
+        CHECK(records.stringify() == R"([{"id":1,"na\"me":"foo","tab\t":true},{"id":2,"na\"me":"bar","tab\t":false}])");
+    }
+
+    SECTION("indent")
+    {
+        CHECK(records.stringify(json5pp::rule::space_indent<1>()) ==
+              "[\n {\n  \"id\": 1,\n  \"na\\\"me\": \"foo\",\n  \"tab\\t\": true\n },\n"
+              " {\n  \"id\": 2,\n  \"na\\\"me\": \"bar\",\n  \"tab\\t\": false\n }\n]");
+    }
+
+    SECTION("reused stringifier")
+    {
+        std::ostringstream out;
+        auto s = out << json5pp::rule::ecma404();
+        for (const auto& r : records.as_array()) {
+            s << r << "\n";
+        }
+        CHECK(out.str() == "{\"id\":1,\"na\\\"me\":\"foo\",\"tab\\t\":true}\n{\"id\":2,\"na\\\"me\":\"bar\",\"tab\\t\":false}\n");
+    }
+
+    SECTION("long and empty keys")
+    {
+        const std::string plain(64, 'k');
+        const std::string longer(65, 'k');
+        const auto v = json5pp::object({{plain, 1}, {longer + "\"", 2}, {"", 3}});
+        CHECK(v.stringify() == "{\"\":3,\"" + plain + "\":1,\"" + longer + "\\\"\":2}");
+        CHECK(v.stringify(json5pp::rule::tab_indent<>()) == "{\n\t\"\": 3,\n\t\"" + plain + "\": 1,\n\t\"" + longer + "\\\"\": 2\n}");
+    }
+
+    SECTION("control characters")
+    {
+        CHECK(json5pp::value(std::string("a\x01" "b\n")).stringify() == R"("a\u0001b\n")");
+    }
+}
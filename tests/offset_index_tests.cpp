@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <json5pp/offset_index.hpp>
+
+/**
+ * @brief unit tests for offset index
+ *
+ */
+
+namespace {
+const auto tag = "[offset_index]";
+
+const char* records =
+    "{\"id\":1,\"name\":\"a\"}\n"
+    "\n"
+    "  {\"id\":\"1\",\"name\":\"b\"}\r\n"
+    "{\"name\":\"c\"}\n"
+    "{\"id\":3,\"name\":\"d\"}";
+} // namespace
+
+TEST_CASE("offset index of NDJSON", tag)
+{
+    std::istringstream is(records);
+    const auto index = json5pp::offset_index::build(is, json5pp::record_format::ndjson, "/id");
+    REQUIRE(index.size() == 4);
+    CHECK(index.offset(0) == 0);
+    CHECK(index.offset(1) == 23);
+    CHECK(index.get_source_size() == std::string(records).size());
+    CHECK(index.read(is, 3) == json5pp::parse(R"({"id":3,"name":"d"})"));
+    CHECK(index.read(is, 1)["name"] == "b");
+    CHECK_THROWS_AS(index.read(is, 4), std::out_of_range);
+
+    CHECK(index.find(is, 1) == std::vector<std::size_t>{0});
+    CHECK(index.find(is, "1") == std::vector<std::size_t>{1});
+    CHECK(index.find(is, 2).empty());
+    CHECK(index.read_key(is, 3)["name"] == "d");
+    CHECK(index.read_key(is, nullptr).is_null());
+
+    std::istringstream dup("{\"id\":1,\"n\":0}\n{\"id\":2}\n{\"id\":1,\"n\":2}\n");
+    const auto dup_index = json5pp::offset_index::build(dup, json5pp::record_format::ndjson, "/id");
+    CHECK(dup_index.find(dup, 1) == std::vector<std::size_t>{0, 2});
+    CHECK(dup_index.read_key(dup, 1)["n"] == 0);
+    const auto all = dup_index.read_keys(dup, 1);
+    REQUIRE(all.size() == 2);
+    CHECK(all[1]["n"] == 2);
+    CHECK(dup_index.read_keys(dup, 3).empty());
+}
+
+TEST_CASE("offset index of array", tag)
+{
+    std::istringstream is("[ {id: 'x', v: [1, 2]}, 2, // comment\n {id: 'y'}, ]");
+    const auto index = json5pp::offset_index::build(is, json5pp::record_format::array, "/id", true);
+    REQUIRE(index.size() == 3);
+    CHECK(index.read(is, 1) == 2);
+    CHECK(index.read(is, 0) == json5pp::parse(R"({"id":"x","v":[1,2]})"));
+    CHECK(index.read_key(is, "y") == json5pp::parse(R"({"id":"y"})"));
+
+    std::istringstream bad("{}");
+    CHECK_THROWS_AS(json5pp::offset_index::build(bad, json5pp::record_format::array), json5pp::syntax_error);
+}
+
+TEST_CASE("offset index save and load", tag)
+{
+    std::istringstream is(records);
+    const auto index = json5pp::offset_index::build(is, json5pp::record_format::ndjson, "/name");
+    std::stringstream sidecar;
+    index.save(sidecar);
+    const auto loaded = json5pp::offset_index::load(sidecar);
+    CHECK(loaded.size() == index.size());
+    CHECK(loaded.get_key_path() == "/name");
+    CHECK(loaded.get_source_size() == index.get_source_size());
+    CHECK(loaded.find(is, "c") == std::vector<std::size_t>{2});
+
+    std::istringstream truncated(sidecar.str().substr(0, 40));
+    CHECK_THROWS_AS(json5pp::offset_index::load(truncated), std::runtime_error);
+    std::istringstream garbage("not an index at all, really");
+    CHECK_THROWS_AS(json5pp::offset_index::load(garbage), std::runtime_error);
+}
+
+TEST_CASE("offset index without key", tag)
+{
+    std::istringstream is("1\n[2]\n");
+    const auto index = json5pp::offset_index::build(is);
+    CHECK(index.size() == 2);
+    CHECK(index.read(is, 1) == json5pp::parse("[2]"));
+    CHECK(index.find(is, 1).empty());
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+#include <json5pp/pipelined.hpp>
+#include <json5pp/record_reader.hpp>
+
+/**
+ * @brief unit tests for pipelined streams
+ *
+ */
+
+namespace {
+const auto tag = "[pipelined]";
+
+json5pp::value sample(int n)
+{
+    json5pp::value v = json5pp::array();
+    for (int i = 0; i < n; ++i) {
+        v.as_array().push_back(json5pp::object({{"id", i}, {"name", "item " + std::to_string(i)}, {"tags", json5pp::array({"a", "b"})}}));
+    }
+    return v;
+}
+
+// A sink which fails after some bytes
+class failing_buf : public std::streambuf
+{
+protected:
+    int_type overflow(int_type ch) override
+    {
+        return (++count > 100) ? traits_type::eof() : ch;
+    }
+
+private:
+    int count = 0;
+};
+} // namespace
+
+TEST_CASE("pipelined stringify", tag)
+{
+    const auto v = sample(2000);
+    json5pp::pipelined_options options;
+    options.buffer_size = 1000;
+    options.buffer_count = 2;
+
+    std::ostringstream os;
+    json5pp::stringify_pipelined(os, v, options);
+    CHECK(os.str() == v.stringify());
+
+    std::ostringstream os5;
+    json5pp::stringify_pipelined(os5, v, options, json5pp::rule::json5(), json5pp::rule::space_indent<2>());
+    CHECK(os5.str() == json5pp::stringify5(v, json5pp::rule::space_indent<2>()));
+}
+
+TEST_CASE("pipelined ostream", tag)
+{
+    std::ostringstream os;
+    {
+        json5pp::pipelined_ostream out(os, {16, 3});
+        out << json5pp::value(1) << "\n";
+        out.flush();
+        CHECK(os.str() == "1\n");
+        out << json5pp::parse(R"({"a":[1,2,3],"b":"a long enough string to span buffers"})") << "\n";
+    }
+    CHECK(os.str() == "1\n{\"a\":[1,2,3],\"b\":\"a long enough string to span buffers\"}\n");
+
+    failing_buf fb;
+    std::ostream bad(&fb);
+    json5pp::pipelined_ostream out(bad, {8, 2});
+    out << sample(10);
+    CHECK_THROWS_AS(out.close(), std::runtime_error);
+    CHECK(out.bad());
+}
+
+TEST_CASE("pipelined read ahead", tag)
+{
+    const auto v = sample(2000);
+    const auto text = json5pp::stringify5(v, json5pp::rule::space_indent<2>());
+    // tiny buffers: tokens (numbers, keywords, comments) span buffer boundaries
+    for (const std::size_t size : {1u, 3u, 7u, 4096u}) {
+        std::istringstream source("// comment\n" + text + " /* end */");
+        json5pp::pipelined_istream in(source, {size, 3});
+        CHECK(json5pp::parse5(in) == v);
+    }
+
+    std::istringstream records("1\n{\"a\":[true,null]}\n\"x\"\n");
+    json5pp::pipelined_istream in(records, {2, 2});
+    json5pp::record_reader reader(in);
+    json5pp::value r;
+    int n = 0;
+    while (reader.read(r)) {
+        ++n;
+    }
+    CHECK(n == 3);
+    CHECK(r == "x");
+
+    std::istringstream truncated("[1, 2");
+    json5pp::pipelined_istream in2(truncated, {2, 2});
+    CHECK_THROWS_AS(json5pp::parse(in2), json5pp::syntax_error);
+}
+
+TEST_CASE("pipelined reader stops early", tag)
+{
+    std::istringstream source(sample(5000).stringify());
+    {
+        json5pp::pipelined_istream in(source, {64, 2});
+        CHECK(in.get() == '[');
+    }
+    CHECK(source.good());
+}
+
+#ifdef _JSON5PP_PIPELINED_FD_
+TEST_CASE("pipelined file descriptor", tag)
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file);
+    const auto v = sample(500);
+    {
+        json5pp::pipelined_ostream out(::fileno(file), {4096, 2});
+        out << v;
+        out.close();
+    }
+    std::rewind(file);
+    std::string text;
+    char buffer[4096];
+    for (std::size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+        text.append(buffer, n);
+    }
+    CHECK(text == v.stringify());
+
+    std::rewind(file);
+    json5pp::pipelined_istream in(::fileno(file), {100, 2});
+    CHECK(json5pp::parse(in) == v);
+    std::fclose(file);
+}
+#endif
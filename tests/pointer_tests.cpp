@@ -0,0 +1,46 @@
+#include <catch2/catch.hpp>
+
+#include <json5pp/pointer.hpp>
+
+/**
+ * @brief unit tests for JSON pointer
+ *
+ */
+
+namespace {
+const auto tag = "[pointer]";
+}
+
+TEST_CASE("pointer parse", tag)
+{
+    CHECK(json5pp::pointer("").empty());
+    CHECK(json5pp::pointer("/a~1b/~0c/0").tokens() == std::vector<std::string>{"a/b", "~c", "0"});
+    CHECK(json5pp::pointer("/").tokens() == std::vector<std::string>{""});
+    CHECK(json5pp::pointer("/a~1b/~0c/0").to_string() == "/a~1b/~0c/0");
+    CHECK_THROWS_AS(json5pp::pointer("a"), std::invalid_argument);
+    CHECK_THROWS_AS(json5pp::pointer("/a~2"), std::invalid_argument);
+    CHECK_THROWS_AS(json5pp::pointer("/a~"), std::invalid_argument);
+
+    json5pp::pointer p;
+    p.append("x").append(std::size_t(3));
+    CHECK(p.to_string() == "/x/3");
+    CHECK(p == json5pp::pointer("/x/3"));
+}
+
+TEST_CASE("pointer find", tag)
+{
+    auto v = json5pp::parse(R"({"foo":["bar","baz"],"":0,"a/b":1,"m~n":8,"k":{"01":2}})");
+    CHECK(json5pp::pointer("").find(v) == &v);
+    CHECK(*json5pp::pointer("/foo/1").find(v) == "baz");
+    CHECK(*json5pp::pointer("/").find(v) == 0);
+    CHECK(*json5pp::pointer("/a~1b").find(v) == 1);
+    CHECK(*json5pp::pointer("/m~0n").find(v) == 8);
+    CHECK(*json5pp::pointer("/k/01").find(v) == 2);
+    CHECK(json5pp::pointer("/foo/01").find(v) == nullptr);
+    CHECK(json5pp::pointer("/foo/2").find(v) == nullptr);
+    CHECK(json5pp::pointer("/foo/-").find(v) == nullptr);
+    CHECK(json5pp::pointer("/missing/x").find(v) == nullptr);
+
+    *json5pp::pointer("/foo/0").find(v) = 1;
+    CHECK(v["foo"][0] == 1);
+}
@@ -0,0 +1,148 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <json5pp/pool.hpp>
+
+/**
+ * @brief unit tests for node_pool
+ *
+ */
+
+namespace {
+const auto tag = "[pool]";
+} // namespace
+
+TEST_CASE("pool reuses freed blocks", tag)
+{
+    json5pp::node_pool pool;
+    void* a = pool.allocate(50, json5pp::node_pool::alignment);
+    void* b = pool.allocate(56, json5pp::node_pool::alignment);
+    CHECK(a != b);
+    pool.deallocate(a, 50, json5pp::node_pool::alignment);
+    // same size class
+    CHECK(pool.allocate(52, json5pp::node_pool::alignment) == a);
+
+    const auto& s = pool.get_statistics(5);
+    CHECK(json5pp::node_pool::class_sizes[5] == 56);
+    CHECK(s.allocations == 3);
+    CHECK(s.deallocations == 1);
+    CHECK(s.reuses == 1);
+    CHECK(s.carved == 2);
+    CHECK(s.in_use == 2);
+    CHECK(s.free == 0);
+    CHECK(s.reuse_rate() == Approx(1.0 / 3));
+
+    CHECK_FALSE(pool.release());
+    pool.deallocate(a, 52, json5pp::node_pool::alignment);
+    pool.deallocate(b, 56, json5pp::node_pool::alignment);
+    CHECK(pool.reserved() > 0);
+    CHECK(pool.release());
+    CHECK(pool.reserved() == 0);
+}
+
+TEST_CASE("pool large blocks", tag)
+{
+    json5pp::node_pool pool;
+    void* p = pool.allocate(1000, json5pp::node_pool::alignment);
+    const auto& large = pool.get_statistics(json5pp::node_pool::classes);
+    CHECK(large.allocations == 1);
+    CHECK(large.in_use == 1);
+    pool.deallocate(p, 1000, json5pp::node_pool::alignment);
+    CHECK(large.in_use == 0);
+    CHECK(pool.reserved() == 0);
+
+    // over-aligned blocks are not pooled
+    void* q = pool.allocate(32, 64);
+    CHECK(reinterpret_cast<std::uintptr_t>(q) % 64 == 0);
+    pool.deallocate(q, 32, 64);
+    CHECK(large.allocations == 2);
+}
+
+TEST_CASE("pool allocator with containers", tag)
+{
+    json5pp::node_pool pool(4096);
+    using pair_type = std::pair<const std::string, json5pp::value>;
+    using map_type = std::map<std::string, json5pp::value, std::less<>, json5pp::pool_allocator<pair_type>>;
+    {
+        map_type m(pool);
+        std::vector<json5pp::value, json5pp::pool_allocator<json5pp::value>> v(pool);
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 100; ++i) {
+                m["key" + std::to_string(i)] = i;
+            }
+            for (int i = 0; i < 100; ++i) {
+                m.erase("key" + std::to_string(i));
+            }
+            v.push_back(round);
+        }
+        CHECK(m.empty());
+        CHECK(v.size() == 10);
+        CHECK(v[9] == 9);
+        CHECK(json5pp::pool_allocator<int>(pool) == m.get_allocator());
+    }
+    const auto total = pool.get_statistics();
+    CHECK(total.in_use == 0);
+    CHECK(total.allocations == total.deallocations);
+    // map nodes of later rounds reuse nodes of the first round
+    CHECK(total.reuse_rate() > 0.8);
+}
+
+TEST_CASE("pool as resource of a document", tag)
+{
+    json5pp::node_pool pool_a(4096);
+    json5pp::node_pool pool_b(4096);
+    const auto key = [](int i) { return std::pmr::string("entry with a long key ") + std::to_string(i).c_str(); };
+    {
+        // two documents on two pools at the same time
+        auto doc_a = json5pp::parse<json5pp::pmr_value>(R"({"name":"doc a","items":[],"nested":{"list":["a long string value"]}})", &pool_a);
+        auto doc_b = json5pp::parse<json5pp::pmr_value>(R"({"name":"doc b","items":[]})", &pool_b);
+        const auto built_a = pool_a.get_statistics();
+        const auto built_b = pool_b.get_statistics();
+        CHECK(built_a.allocations > 0);
+        CHECK(built_b.allocations > 0);
+        CHECK(doc_a.as_object().get_allocator().resource() == &pool_a);
+        CHECK(doc_a["nested"].as_object().get_allocator().resource() == &pool_a);
+        CHECK(doc_a["nested"]["list"].as_array().get_allocator().resource() == &pool_a);
+        CHECK(doc_a["nested"]["list"][0].as_string().get_allocator().resource() == &pool_a);
+        CHECK(doc_a.as_object().begin()->first.get_allocator().resource() == &pool_a);
+        CHECK(doc_b.as_object().get_allocator().resource() == &pool_b);
+        CHECK(doc_b["items"].as_array().get_allocator().resource() == &pool_b);
+
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 100; ++i) {
+                doc_a[key(i)] = json5pp::object<json5pp::pmr_value>({{"n", i}}, &pool_a);
+                doc_b[key(i)] = json5pp::array<json5pp::pmr_value>({i}, &pool_b);
+            }
+            for (int i = 0; i < 100; ++i) {
+                doc_a.erase(key(i));
+                doc_b.erase(key(i));
+            }
+            doc_a["items"].as_array().push_back(round);
+            doc_b["items"].as_array().push_back(round);
+        }
+        CHECK(doc_a["items"].size() == 10);
+        CHECK(doc_b["items"].size() == 10);
+        CHECK(doc_a["name"] == "doc a");
+        CHECK(doc_b["name"] == "doc b");
+        CHECK(json5pp::object<json5pp::pmr_value>(&pool_b).as_object().get_allocator().resource() == &pool_b);
+
+        // map nodes and keys of later rounds reuse blocks of the first round
+        for (const auto* pool : {&pool_a, &pool_b}) {
+            const auto churned = pool->get_statistics();
+            CHECK(churned.allocations - (pool == &pool_a ? built_a : built_b).allocations > 2000);
+            CHECK(churned.reuse_rate() > 0.8);
+            CHECK(churned.in_use > 0);
+        }
+    }
+    CHECK(std::pmr::get_default_resource() == std::pmr::new_delete_resource());
+    CHECK(pool_a.get_statistics().in_use == 0);
+    CHECK(pool_b.get_statistics().in_use == 0);
+    CHECK(pool_a.release());
+    CHECK(pool_b.release());
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <string>
+
+#include <json5pp/json5pp.hpp>
+
+/**
+ * @brief unit tests for resumable (pull) stringifier
+ *
+ */
+
+namespace {
+const auto tag = "[pull]";
+
+template <class S>
+std::string drain(S&& s, std::size_t chunk)
+{
+    std::string out;
+    std::string buffer(chunk, '\0');
+    for (;;) {
+        auto r = s.read(buffer.data(), buffer.size());
+        CHECK(r.size <= chunk);
+        out.append(buffer.data(), r.size);
+        if (r.done) break;
+        CHECK(r.size == chunk);
+    }
+    return out;
+}
+
+json5pp::value sample()
+{
+    return json5pp::object({
+        {"empty_array", json5pp::array()},
+        {"empty_object", json5pp::object()},
+        {"list", json5pp::array({1, 2.5, -3, true, false, nullptr, "a\"b\\c\n"})},
+        {"long", std::string(10000, 'x') + "\t" + std::string(5000, 'y')},
+        {"nested", json5pp::object({{"k\x01", json5pp::array({json5pp::object({{"z", 0.125}})})}})},
+        {"nan", std::numeric_limits<double>::quiet_NaN()},
+        {"inf", -std::numeric_limits<double>::infinity()},
+    });
+}
+} // namespace
+
+TEST_CASE("pull stringify", tag)
+{
+    const auto v = sample();
+
+    for (std::size_t chunk : {1, 3, 64, 5000, 100000}) {
+        CHECK(drain(json5pp::pull_stringify(v), chunk) == json5pp::stringify(v));
+        CHECK(drain(json5pp::pull_stringify5(v), chunk) == json5pp::stringify5(v));
+        CHECK(drain(json5pp::pull_stringify(v, json5pp::rule::space_indent<2>()), chunk) ==
+              json5pp::stringify(v, json5pp::rule::space_indent<2>()));
+        CHECK(drain(json5pp::pull_stringify5(v, json5pp::rule::tab_indent<>(), json5pp::rule::crlf_newline()), chunk) ==
+              json5pp::stringify5(v, json5pp::rule::tab_indent<>(), json5pp::rule::crlf_newline()));
+    }
+}
+
+TEST_CASE("pull stringify scalar", tag)
+{
+    for (const auto& v : {json5pp::value(), json5pp::value(12), json5pp::value(12.345), json5pp::value("foo"), json5pp::array()}) {
+        CHECK(drain(json5pp::pull_stringify(v), 2) == json5pp::stringify(v));
+    }
+}
+
+TEST_CASE("pull stringify done", tag)
+{
+    json5pp::value v = 123;
+    auto s = json5pp::pull_stringify(v);
+    CHECK(!s.done());
+
+    char buffer[8];
+    auto r = s.read(buffer, sizeof(buffer));
+    CHECK(r.size == 3);
+    CHECK(r.done);
+    CHECK(s.done());
+
+    r = s.read(buffer, sizeof(buffer));
+    CHECK(r.size == 0);
+    CHECK(r.done);
+}
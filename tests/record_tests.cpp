@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <json5pp/record_reader.hpp>
+
+/**
+ * @brief unit tests for record reader with checkpoints
+ *
+ */
+
+namespace {
+const auto tag = "[record]";
+
+std::vector<json5pp::value> read_all(json5pp::record_reader& reader)
+{
+    std::vector<json5pp::value> records;
+    json5pp::value v;
+    while (reader.read(v)) {
+        records.push_back(v);
+    }
+    return records;
+}
+} // namespace
+
+TEST_CASE("ndjson records", tag)
+{
+    const std::string input = "{\"id\":1}\n{\"id\":2}\n\n  3 \"four\"\n[5]\n";
+    std::istringstream in(input);
+    json5pp::record_reader reader(in);
+
+    json5pp::value v;
+    REQUIRE(reader.read(v));
+    CHECK(v["id"] == 1);
+    REQUIRE(reader.read(v));
+    CHECK(v["id"] == 2);
+
+    const auto cp = reader.get_checkpoint();
+    CHECK(cp.records == 2);
+    CHECK(cp.offset == 17);
+
+    auto rest = read_all(reader);
+    REQUIRE(rest.size() == 3);
+    CHECK(rest[0] == 3);
+    CHECK(rest[2][0] == 5);
+    CHECK(reader.get_checkpoint().records == 5);
+
+    // resume with a new stream
+    std::istringstream again(input);
+    json5pp::record_reader resumed(again, json5pp::checkpoint::from_value(cp.to_value()));
+    auto resumed_rest = read_all(resumed);
+    CHECK(resumed_rest == rest);
+    CHECK(resumed.get_checkpoint().records == 5);
+}
+
+TEST_CASE("array records", tag)
+{
+    const std::string input = " [ {id: 1}, // first\n {id: 2}, {id: 3}, ]";
+    std::istringstream in(input);
+    json5pp::record_reader reader(in, json5pp::record_format::array, true);
+
+    json5pp::value v;
+    REQUIRE(reader.read(v));
+    CHECK(v["id"] == 1);
+    const auto cp = reader.get_checkpoint();
+    CHECK(cp.format == json5pp::record_format::array);
+
+    auto rest = read_all(reader);
+    REQUIRE(rest.size() == 2);
+    CHECK(rest[1]["id"] == 3);
+
+    std::istringstream again(input);
+    json5pp::record_reader resumed(again, cp, true);
+    CHECK(read_all(resumed) == rest);
+}
+
+TEST_CASE("array records errors", tag)
+{
+    {
+        std::istringstream in("[1,2,]");
+        json5pp::record_reader reader(in, json5pp::record_format::array);
+        json5pp::value v;
+        CHECK(reader.read(v));
+        CHECK(reader.read(v));
+        CHECK_THROWS_AS(reader.read(v), json5pp::syntax_error);
+    }
+    {
+        std::istringstream in("[1 2]");
+        json5pp::record_reader reader(in, json5pp::record_format::array);
+        json5pp::value v;
+        CHECK(reader.read(v));
+        CHECK_THROWS_AS(reader.read(v), json5pp::syntax_error);
+    }
+    {
+        std::istringstream in("[]");
+        json5pp::record_reader reader(in, json5pp::record_format::array);
+        json5pp::value v;
+        CHECK(!reader.read(v));
+    }
+}
+
+TEST_CASE("large input checkpoints", tag)
+{
+    std::string input = "[";
+    for (int i = 0; i < 20000; ++i) {
+        input += (i ? ",\n" : "") + json5pp::object({{"n", i}, {"s", "xxxxxxxx"}}).stringify();
+    }
+    input += "]";
+
+    std::istringstream in(input);
+    json5pp::record_reader reader(in, json5pp::record_format::array);
+    json5pp::value v;
+    std::vector<json5pp::checkpoint> checkpoints;
+    for (int i = 0; reader.read(v); ++i) {
+        CHECK(v["n"] == i);
+        if (i % 997 == 0) checkpoints.push_back(reader.get_checkpoint());
+    }
+    CHECK(reader.get_checkpoint().records == 20000);
+    CHECK(reader.get_checkpoint().offset == input.size());
+
+    for (const auto& cp : checkpoints) {
+        std::istringstream again(input);
+        json5pp::record_reader resumed(again, cp, false);
+        REQUIRE(resumed.read(v));
+        CHECK(v["n"] == static_cast<int>(cp.records));
+    }
+}
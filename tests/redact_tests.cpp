@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <json5pp/redact.hpp>
+
+/**
+ * @brief unit tests for redacting stringify
+ *
+ */
+
+namespace {
+const auto tag = "[redact]";
+
+json5pp::value sample()
+{
+    return json5pp::parse(R"({
+        "user": {"name": "alice", "password": "secret", "token": "abc"},
+        "items": [{"id": 1, "card": "4111111111111111"}, {"id": 2, "card": "5500000000000004"}],
+        "body": "a very long request body",
+        "password": "top"
+    })");
+}
+} // namespace
+
+TEST_CASE("redact paths", tag)
+{
+    const auto v = sample();
+    json5pp::redaction rules;
+    rules.omit("/user/token").mask("/items/*/card").truncate("/body", 6);
+    CHECK(json5pp::stringify_redacted(v, rules) ==
+          R"({"body":"a very...","items":[{"card":"***","id":1},{"card":"***","id":2}],"password":"top","user":{"name":"alice","password":"secret"}})");
+
+    // the value is not changed
+    CHECK(v["user"]["token"] == "abc");
+    CHECK(v.stringify() == json5pp::stringify_redacted(v, json5pp::redaction()));
+}
+
+TEST_CASE("redact keys at any depth", tag)
+{
+    const auto v = sample();
+    json5pp::redaction rules;
+    rules.mask("password").mask_text("<hidden>");
+    const auto text = json5pp::stringify_redacted(v, rules);
+    CHECK(text.find("secret") == std::string::npos);
+    CHECK(text.find("top") == std::string::npos);
+    CHECK(json5pp::parse(text)["user"]["password"] == "<hidden>");
+    CHECK(json5pp::parse(text)["password"] == "<hidden>");
+
+    json5pp::redaction deep;
+    deep.omit("/items/**/id");
+    CHECK(json5pp::parse(json5pp::stringify_redacted(v, deep))["items"] == json5pp::parse(R"([{"card":"4111111111111111"},{"card":"5500000000000004"}])"));
+    CHECK(json5pp::stringify_redacted(v["items"], deep) == v["items"].stringify());
+}
+
+TEST_CASE("redact trailing double star", tag)
+{
+    const auto v = json5pp::parse(R"({"a":{"b":{"c":1},"d":[2]},"e":{},"x":3})");
+    // descendants only: "/a" and "/e" themselves are kept
+    CHECK(json5pp::stringify_redacted(v, json5pp::redaction().omit("/a/**").omit("/e/**").omit("/x/**")) == R"({"a":{},"e":{},"x":3})");
+    CHECK(json5pp::stringify_redacted(v, json5pp::redaction().mask("/a/**")) == R"({"a":{"b":"***","d":"***"},"e":{},"x":3})");
+    CHECK(json5pp::stringify_redacted(v, json5pp::redaction().omit("/a/*/**")) == R"({"a":{"b":{},"d":[]},"e":{},"x":3})");
+    // "**" in the middle also matches no level
+    CHECK(json5pp::stringify_redacted(v, json5pp::redaction().omit("/a/**/c")) == R"({"a":{"b":{},"d":[2]},"e":{},"x":3})");
+    CHECK(json5pp::stringify_redacted(v, json5pp::redaction().omit("/**/b")) == R"({"a":{"d":[2]},"e":{},"x":3})");
+}
+
+TEST_CASE("redact arrays and indent", tag)
+{
+    const auto v = json5pp::parse(R"({"a": [1, 2, 3], "b": {"c": 1}, "s": "abあ"})");
+    json5pp::redaction rules;
+    rules.omit("/a/1").omit("/b/c").truncate("s", 3);
+    CHECK(json5pp::stringify_redacted(v, rules) == "{\"a\":[1,3],\"b\":{},\"s\":\"ab...\"}");
+    CHECK(json5pp::stringify5_redacted(v, rules, json5pp::rule::space_indent<2>()) == "{\n  \"a\": [\n    1,\n    3\n  ],\n  \"b\": {},\n  \"s\": \"ab...\"\n}");
+
+    std::ostringstream os;
+    json5pp::stringify_redacted(os, v, json5pp::redaction().omit("a").omit("b").omit("s"));
+    CHECK(os.str() == "{}");
+    os.str("");
+    json5pp::stringify5_redacted(os, json5pp::parse5("{a: 1, n: NaN}"), json5pp::redaction().omit("a"));
+    CHECK(os.str() == "{\"n\":NaN}");
+
+    // strongest action wins: omit > mask > truncate
+    json5pp::redaction mixed;
+    mixed.truncate("s", 1).mask("/s").truncate("/a", 1);
+    CHECK(json5pp::stringify_redacted(v, mixed) == "{\"a\":[1,2,3],\"b\":{\"c\":1},\"s\":\"***\"}");
+
+    CHECK_THROWS_AS(json5pp::redaction().omit(""), std::invalid_argument);
+    CHECK_THROWS_AS(json5pp::redaction().omit("/a~2"), std::invalid_argument);
+}
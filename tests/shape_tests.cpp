@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include <json5pp/shape.hpp>
+
+/**
+ * @brief unit tests for shape inference
+ *
+ */
+
+namespace {
+const auto tag = "[shape]";
+}
+
+TEST_CASE("shape of records", tag)
+{
+    std::vector<json5pp::value> records{
+        json5pp::parse(R"({"id":1,"name":"foo","score":1.5,"tags":["a","b"]})"),
+        json5pp::parse(R"({"id":2,"name":"barbaz","score":3,"tags":[]})"),
+        json5pp::parse(R"({"id":30,"name":null,"tags":["c"]})"),
+    };
+    auto s = json5pp::infer_shape(records.begin(), records.end());
+
+    CHECK(s.count() == 3);
+    CHECK(s.uniform_kind() == json5pp::shape::object);
+    CHECK(s.fields().size() == 4);
+
+    const auto& id = s.fields().at("id");
+    CHECK(id.uniform_kind() == json5pp::shape::integer);
+    CHECK(id.integer_range() == std::make_pair(1LL, 30LL));
+    CHECK(s.presence("id") == 1.0);
+
+    const auto& name = s.fields().at("name");
+    CHECK(!name.uniform_kind());
+    CHECK(name.is_nullable());
+    CHECK(name.string_length_range() == std::make_pair(std::size_t(3), std::size_t(6)));
+    CHECK(name.string_length_histogram()[2] == 1); // 3
+    CHECK(name.string_length_histogram()[3] == 1); // 6
+
+    const auto& score = s.fields().at("score");
+    CHECK(score.is_numeric());
+    CHECK(score.number_range() == std::make_pair(1.5, 3.0));
+    CHECK(!score.is_integral());
+    CHECK(id.is_integral());
+    json5pp::shape big;
+    big.observe(json5pp::parse("10000000000")); // parsed as double
+    CHECK(big.is_integral());
+    big.observe(json5pp::parse("1e300"));
+    CHECK(!big.is_integral());
+    CHECK(s.presence("score") == Approx(2.0 / 3.0));
+    CHECK(s.presence("missing") == 0.0);
+
+    const auto& tags = s.fields().at("tags");
+    CHECK(tags.array_length_range() == std::make_pair(std::size_t(0), std::size_t(2)));
+    CHECK(tags.array_length_mean() == 1.0);
+    REQUIRE(tags.elements());
+    CHECK(tags.elements()->uniform_kind() == json5pp::shape::string);
+    CHECK(tags.elements()->count() == 3);
+}
+
+TEST_CASE("shape merge", tag)
+{
+    json5pp::shape a, b;
+    a.observe(json5pp::parse(R"({"x":[1,2]})"));
+    b.observe(json5pp::parse(R"({"x":[3],"y":true})"));
+    a.merge(b);
+
+    CHECK(a.count() == 2);
+    CHECK(a.presence("y") == 0.5);
+    CHECK(a.fields().at("x").elements()->integer_range() == std::make_pair(1LL, 3LL));
+
+    auto copy = a;
+    CHECK(copy.to_value() == a.to_value());
+}
+
+TEST_CASE("shape summary", tag)
+{
+    json5pp::shape s;
+    s.observe(json5pp::parse(R"({"a":"xy","b":[1]})"));
+
+    auto v = s.to_value();
+    CHECK(v["count"] == 1LL);
+    CHECK(v["types"]["object"] == 1LL);
+    CHECK(v["fields"]["a"]["types"]["string"] == 1LL);
+    CHECK(v["fields"]["a"]["presence"] == 1.0);
+    CHECK(v["fields"]["a"]["string_length"]["histogram"].size() == 3);
+    CHECK(v["fields"]["b"]["array_length"]["max"] == 1LL);
+    CHECK(v["fields"]["b"]["elements"]["min"] == 1.0);
+}
+
+TEST_CASE("shape field limit", tag)
+{
+    json5pp::shape s(1);
+    s.observe(json5pp::parse(R"({"a":1,"b":2,"c":3})"));
+    CHECK(s.fields().size() == 1);
+    CHECK(s.dropped() == 2);
+}
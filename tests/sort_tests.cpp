@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <string>
+
+#include <json5pp/sort.hpp>
+
+/**
+ * @brief unit tests for sort_by
+ *
+ */
+
+namespace {
+const auto tag = "[sort]";
+}
+
+TEST_CASE("sort by field", tag)
+{
+    auto v = json5pp::parse(R"([
+        {"id":3,"name":"c"},{"id":1.5,"name":"a"},{"name":"none"},
+        {"id":"x","name":"s"},{"id":2,"name":"b"},{"id":null,"name":"null"},{"id":true,"name":"t"}
+    ])");
+
+    json5pp::sort_by(v, "/id");
+    std::string names;
+    for (const auto& e : v.as_array()) names += e["name"].as_string() + ",";
+    CHECK(names == "none,null,t,a,b,c,s,");
+
+    json5pp::sort_by(v, "/id", json5pp::sort_order::descending);
+    names.clear();
+    for (const auto& e : v.as_array()) names += e["name"].as_string() + ",";
+    CHECK(names == "s,c,b,a,t,none,null,");
+}
+
+TEST_CASE("sort scalars", tag)
+{
+    auto v = json5pp::array({3, "b", 1, std::numeric_limits<double>::quiet_NaN(), "a", 2.5});
+    json5pp::sort_by(v, "");
+    CHECK(v[1] == 1);
+    CHECK(v[2] == 2.5);
+    CHECK(v[3] == 3);
+    CHECK(v[4] == "a");
+    CHECK(v[5] == "b");
+
+    json5pp::value not_array = 1;
+    CHECK_THROWS_AS(json5pp::sort_by(not_array, ""), std::bad_cast);
+}
+
+TEST_CASE("sort big integers", tag)
+{
+    // above 2^53, integers are not exact as double
+    auto v = json5pp::array({9007199254740993LL, 9007199254740996.0, 9007199254740992LL, 9007199254740995LL, 9007199254740994LL});
+    json5pp::sort_by(v, "");
+    CHECK(v[0] == 9007199254740992LL);
+    CHECK(v[1] == 9007199254740993LL);
+    CHECK(v[2] == 9007199254740994LL);
+    CHECK(v[3] == 9007199254740995LL);
+    CHECK(!v[4].is_integer());
+    CHECK(json5pp::value(9007199254740993LL) > json5pp::value(9007199254740992.0));
+}
+
+TEST_CASE("sort parallel", tag)
+{
+    json5pp::value v = json5pp::array();
+    const int n = 10007;
+    for (int i = 0; i < n; ++i) {
+        v.append(json5pp::object({{"k", json5pp::object({{"n", (i * 7919) % 1000}})}, {"i", i}}));
+    }
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+        auto w = v;
+        if (threads % 2) {
+            json5pp::sort_by(w, json5pp::pointer("/k/n"), json5pp::sort_order::ascending, threads, 1000);
+        } else {
+            json5pp::sort_by(w, "/k/n", json5pp::sort_order::ascending, threads, 1000);
+        }
+        REQUIRE(w.size() == static_cast<std::size_t>(n));
+        for (int i = 1; i < n; ++i) {
+            const auto& a = w[i - 1];
+            const auto& b = w[i];
+            REQUIRE(a["k"]["n"].get<int>() <= b["k"]["n"].get<int>());
+            if (a["k"]["n"].get<int>() == b["k"]["n"].get<int>()) {
+                REQUIRE(a["i"].get<int>() < b["i"].get<int>()); // stable
+            }
+        }
+    }
+}
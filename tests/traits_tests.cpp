@@ -0,0 +1,106 @@
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+
+/**
+ * @brief unit tests for basic_value with custom storage types
+ *
+ */
+
+namespace {
+const auto tag = "[traits]";
+
+// Single precision numbers and unordered objects
+struct compact_traits : json5pp::default_traits {
+    using number_type = float;
+    template <class K, class V>
+    using object_type = std::unordered_map<K, V>;
+};
+using compact_value = json5pp::basic_value<compact_traits>;
+
+// Counts allocations passed to the upstream resource
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    std::size_t count = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++count;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+TEST_CASE("default traits", tag)
+{
+    static_assert(std::is_same_v<json5pp::value, json5pp::basic_value<json5pp::default_traits>>);
+    static_assert(std::is_same_v<json5pp::value::string_type, std::string>);
+    static_assert(std::is_same_v<json5pp::value::array_type, std::vector<json5pp::value>>);
+    static_assert(std::is_same_v<json5pp::value::object_type, std::map<std::string, json5pp::value>>);
+    static_assert(std::is_same_v<json5pp::pmr_value::integer_type, long long>);
+    static_assert(std::is_same_v<json5pp::pmr_value::number_type, double>);
+}
+
+TEST_CASE("pmr traits", tag)
+{
+    const std::string text = R"({"big":9007199254740993,"list":[1,-2.5,"three",null,true],"name":"pmr"})";
+    counting_resource resource;
+    auto* const previous = std::pmr::set_default_resource(&resource);
+    {
+        const auto v = json5pp::parse<json5pp::pmr_value>(text);
+        CHECK(resource.count > 0);
+        CHECK(v["big"].is_integer());
+        CHECK(v["big"].get<long long>() == 9007199254740993LL);
+        CHECK(v["list"].size() == 5);
+        CHECK(v["list"][2] == "three");
+        CHECK(v["name"].as_string() == std::pmr::string("pmr"));
+        CHECK(v["name"].get<std::string>() == "pmr");
+        CHECK(v["list"][0].to<std::string>() == "1");
+        CHECK(v.stringify() == text);
+        CHECK(json5pp::stringify5(v["list"], json5pp::rule::space_indent<>()) == json5pp::stringify5(json5pp::parse(text)["list"], json5pp::rule::space_indent<>()));
+
+        json5pp::pmr_value built = json5pp::object<json5pp::pmr_value>({{"a", json5pp::array<json5pp::pmr_value>({1, "x"})}});
+        built["b"] = std::string("text");
+        CHECK(built.stringify() == R"({"a":[1,"x"],"b":"text"})");
+
+        std::istringstream is("[2147483648]");
+        json5pp::pmr_value streamed;
+        is >> streamed;
+        CHECK(streamed[0].as_integer() == 2147483648LL);
+        std::ostringstream os;
+        static_cast<std::ostream&>(os) << streamed;
+        CHECK(os.str() == "[2147483648]");
+    }
+    std::pmr::set_default_resource(previous);
+}
+
+TEST_CASE("compact traits", tag)
+{
+    const auto v = json5pp::parse5<compact_value>("{a: 0.5, b: [1, 2], c: {d: NaN}}");
+    CHECK(v["a"].get_strict<float>() == 0.5f);
+    CHECK(v["b"][1] == 2);
+    CHECK(std::isnan(v["c"]["d"].as_number()));
+    CHECK(json5pp::parse<compact_value>(v["b"].stringify()) == v["b"]);
+    CHECK(v.contains("c"));
+    CHECK(json5pp::parse(v["a"].stringify()) == 0.5);
+}
@@ -0,0 +1,184 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <json5pp/transform.hpp>
+
+/**
+ * @brief unit tests for transform pipeline
+ *
+ */
+
+namespace {
+const auto tag = "[transform]";
+
+const char* logs =
+    "{\"service\":\"api\",\"status\":200,\"bytes\":100,\"user\":{\"id\":\"1\"}}\n"
+    "{\"service\":\"web\",\"status\":500,\"bytes\":50}\n"
+    "\n"
+    "{\"service\":\"api\",\"status\":503,\"bytes\":\"25\",\"user\":{\"id\":\"x\"}}\n"
+    "{\"service\":\"api\",\"status\":404,\"bytes\":10}\n";
+
+std::string run(const json5pp::pipeline& p, const std::string& input, json5pp::pipeline_options options = {})
+{
+    std::istringstream is(input);
+    std::ostringstream os;
+    p.run(is, os, options);
+    return os.str();
+}
+} // namespace
+
+TEST_CASE("transform stages", tag)
+{
+    json5pp::value v = json5pp::parse(R"({"a":{"b":"12","c":true},"d":[1,2],"e":1.5})");
+    json5pp::pipeline p;
+    p.coerce("/a/b", json5pp::coerce_type::integer)
+        .coerce("/a/c", json5pp::coerce_type::string)
+        .coerce("/e", json5pp::coerce_type::integer)
+        .rename("/a/b", "/x/y")
+        .project({"/x", "/a/c", "/e", "/missing"});
+    CHECK(p.apply(v));
+    CHECK(v == json5pp::parse(R"({"x":{"y":12},"a":{"c":"true"},"e":1})"));
+
+    json5pp::value n = json5pp::parse(R"({"s":"1.5e1","t":"yes","u":[1]})");
+    json5pp::pipeline q;
+    q.coerce("/s", json5pp::coerce_type::number).coerce("/t", json5pp::coerce_type::boolean).coerce("/u", json5pp::coerce_type::string);
+    CHECK(q.apply(n));
+    CHECK(n["s"].is_number());
+    CHECK_FALSE(n["s"].is_integer());
+    CHECK(n["s"].as_number() == 15.0);
+    CHECK(n["t"].is_null());
+    CHECK(n["u"].is_null());
+}
+
+TEST_CASE("transform coerce out of range", tag)
+{
+    json5pp::value v = json5pp::object({{"a", 1e20}, {"b", -1e20}, {"c", -0x1p63}, {"d", 0x1p63}, {"e", -3.5}, {"f", 4294967296.5}});
+    json5pp::pipeline p;
+    for (const auto* path : {"/a", "/b", "/c", "/d", "/e", "/f"}) {
+        p.coerce(path, json5pp::coerce_type::integer);
+    }
+    CHECK(p.apply(v));
+    CHECK(v["a"].is_null());
+    CHECK(v["b"].is_null());
+    REQUIRE(v["c"].is_integer());
+    CHECK(v["c"].get<long long>() == std::numeric_limits<long long>::min());
+    CHECK(v["d"].is_null());
+    CHECK(v["e"] == -3);
+    CHECK(v["f"].get<long long>() == 4294967296LL);
+}
+
+TEST_CASE("transform filters", tag)
+{
+    using op = json5pp::compare_op;
+    auto match = [](const char* text, const char* path, op o, json5pp::value operand = {}) {
+        json5pp::pipeline p;
+        p.filter(path, o, std::move(operand));
+        auto v = json5pp::parse(text);
+        return p.apply(v);
+    };
+    CHECK(match(R"({"a":2})", "/a", op::eq, 2.0));
+    CHECK(match(R"({"a":2})", "/a", op::gt, 1));
+    CHECK_FALSE(match(R"({"a":2})", "/a", op::lt, 1));
+    CHECK(match(R"({"a":"b"})", "/a", op::le, "b"));
+    CHECK(match(R"({"a":"b"})", "/a", op::ne, 1));
+    CHECK_FALSE(match(R"({"a":"b"})", "/a", op::gt, 1));
+    CHECK(match(R"({"a":null})", "/a", op::exists));
+    CHECK(match(R"({"a":null})", "/b", op::missing));
+    CHECK_FALSE(match(R"({"a":null})", "/b", op::ne, 1));
+
+    json5pp::pipeline p;
+    p.filter([](const json5pp::value& v) { return v.size() > 1; });
+    auto v = json5pp::parse(R"({"a":1})");
+    CHECK_FALSE(p.apply(v));
+
+    CHECK_THROWS_AS(json5pp::pipeline().group_by("/a", {}).filter("/a", op::exists), std::logic_error);
+}
+
+TEST_CASE("transform run", tag)
+{
+    json5pp::pipeline p;
+    p.filter("/status", json5pp::compare_op::ge, 500).rename("/user/id", "/uid").project({"/service", "/uid"});
+    for (const unsigned threads : {1u, 4u}) {
+        json5pp::pipeline_options options;
+        options.threads = threads;
+        options.chunk_size = 1;
+        CHECK(run(p, logs, options) == "{\"service\":\"web\"}\n{\"service\":\"api\",\"uid\":\"x\"}\n");
+    }
+
+    std::istringstream is(logs);
+    std::ostringstream os;
+    const auto stats = json5pp::pipeline().run(is, os);
+    CHECK(stats.records_in == 4);
+    CHECK(stats.records_out == 4);
+}
+
+TEST_CASE("transform group by", tag)
+{
+    using json5pp::aggregate;
+    json5pp::pipeline p;
+    p.coerce("/bytes", json5pp::coerce_type::number)
+        .group_by("/service", {aggregate::count_of("n"), aggregate::sum_of("/bytes", "sum"), aggregate::min_of("/bytes", "min"),
+                               aggregate::max_of("/bytes", "max"), aggregate::mean_of("/missing", "mean")});
+    const std::string expected =
+        "{\"max\":100,\"mean\":null,\"min\":10,\"n\":3,\"service\":\"api\",\"sum\":135}\n"
+        "{\"max\":50,\"mean\":null,\"min\":50,\"n\":1,\"service\":\"web\",\"sum\":50}\n";
+    for (const unsigned threads : {1u, 3u}) {
+        json5pp::pipeline_options options;
+        options.threads = threads;
+        options.chunk_size = 1;
+        CHECK(run(p, logs, options) == expected);
+    }
+
+    json5pp::pipeline_options options;
+    options.format = json5pp::record_format::array;
+    options.json5 = true;
+    json5pp::pipeline q;
+    q.group_by("/k", {aggregate::count_of("n"), aggregate::mean_of("/v", "mean")});
+    CHECK(run(q, "[{k:1,v:1},{k:1,v:2},{v:3},]", options) == "{\"k\":1,\"mean\":1.5,\"n\":2}\n{\"k\":null,\"mean\":3,\"n\":1}\n");
+}
+
+TEST_CASE("transform exact integers", tag)
+{
+    using json5pp::aggregate;
+    // above 2^53, integers are not exact as double (the parser makes double, coerce makes long long)
+    const std::string ids =
+        "{\"id\":\"9007199254740992\",\"g\":1}\n"
+        "{\"id\":\"9007199254740993\",\"g\":1}\n";
+    json5pp::pipeline p;
+    p.coerce("/id", json5pp::coerce_type::integer).filter("/id", json5pp::compare_op::eq, 9007199254740993LL).project({"/id"});
+    CHECK(run(p, ids) == "{\"id\":9007199254740993}\n");
+    json5pp::pipeline q;
+    q.coerce("/id", json5pp::coerce_type::integer).filter("/id", json5pp::compare_op::gt, 9007199254740992.0).project({"/id"});
+    CHECK(run(q, ids) == "{\"id\":9007199254740993}\n");
+    json5pp::value v = json5pp::object({{"id", 9007199254740992.0}});
+    CHECK_FALSE(p.apply(v));
+
+    json5pp::pipeline g;
+    g.coerce("/id", json5pp::coerce_type::integer)
+        .group_by("/g", {aggregate::sum_of("/id", "sum"), aggregate::min_of("/id", "min"), aggregate::max_of("/id", "max")});
+    for (const unsigned threads : {1u, 2u}) {
+        json5pp::pipeline_options options;
+        options.threads = threads;
+        options.chunk_size = 1;
+        CHECK(run(g, ids, options) == "{\"g\":1,\"max\":9007199254740993,\"min\":9007199254740992,\"sum\":18014398509481985}\n");
+    }
+
+    // integer overflow continues in floating point
+    json5pp::pipeline h;
+    h.coerce("/n", json5pp::coerce_type::integer).group_by("/g", {aggregate::sum_of("/n", "sum")});
+    const auto out = json5pp::parse(run(h, "{\"g\":1,\"n\":\"9223372036854775807\"}\n{\"g\":1,\"n\":\"9223372036854775807\"}\n"));
+    CHECK_FALSE(out["sum"].is_integer());
+    CHECK(out["sum"].as_number() > 1.8e19);
+}
+
+TEST_CASE("transform syntax error", tag)
+{
+    json5pp::pipeline_options options;
+    options.threads = 2;
+    options.chunk_size = 1;
+    CHECK_THROWS_AS(run(json5pp::pipeline(), "{}\n{\n", options), json5pp::syntax_error);
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <json5pp/ubjson.hpp>
+
+/**
+ * @brief unit tests for UBJSON encoder/decoder
+ *
+ */
+
+namespace {
+const auto tag = "[ubjson]";
+
+std::string bytes(std::initializer_list<int> list)
+{
+    std::string s;
+    for (auto c : list) s.push_back(static_cast<char>(c));
+    return s;
+}
+} // namespace
+
+TEST_CASE("ubjson scalars", tag)
+{
+    using json5pp::ubjson::encode;
+    CHECK(encode(json5pp::value()) == "Z");
+    CHECK(encode(json5pp::value(true)) == "T");
+    CHECK(encode(json5pp::value(false)) == "F");
+    CHECK(encode(json5pp::value(200)) == bytes({'U', 200}));
+    CHECK(encode(json5pp::value(-1)) == bytes({'i', 0xff}));
+    CHECK(encode(json5pp::value(1000)) == bytes({'I', 0x03, 0xe8}));
+    CHECK(encode(json5pp::value(100000)) == bytes({'l', 0x00, 0x01, 0x86, 0xa0}));
+    CHECK(encode(json5pp::value(1LL << 40)) == bytes({'L', 0, 0, 1, 0, 0, 0, 0, 0}));
+    CHECK(encode(json5pp::value(1.5)) == bytes({'D', 0x3f, 0xf8, 0, 0, 0, 0, 0, 0}));
+    CHECK(encode(json5pp::value("ab")) == bytes({'S', 'U', 2, 'a', 'b'}));
+    CHECK(encode(json5pp::value(std::numeric_limits<double>::quiet_NaN())) == "Z");
+}
+
+TEST_CASE("ubjson containers", tag)
+{
+    using json5pp::ubjson::encode;
+    auto ints = json5pp::array({1, 2, 300});
+    CHECK(encode(ints) == bytes({'[', '$', 'I', '#', 'U', 3, 0, 1, 0, 2, 0x01, 0x2c}));
+    CHECK(encode(ints, false) == bytes({'[', 'U', 1, 'U', 2, 'I', 0x01, 0x2c, ']'}));
+
+    auto mixed = json5pp::array({1, "a"});
+    CHECK(encode(mixed) == bytes({'[', '#', 'U', 2, 'U', 1, 'S', 'U', 1, 'a'}));
+
+    auto obj = json5pp::object({{"k", true}});
+    CHECK(encode(obj) == bytes({'{', '#', 'U', 1, 'U', 1, 'k', 'T'}));
+    CHECK(encode(obj, false) == bytes({'{', 'U', 1, 'k', 'T', '}'}));
+}
+
+TEST_CASE("ubjson round trip", tag)
+{
+    auto v = json5pp::parse(R"({
+        "null": null, "bool": [true, false], "ints": [0, -128, 255, 70000, 5000000000],
+        "reals": [0.5, -2.25, 1e100], "strs": ["", "foo", "bar"],
+        "nested": {"a": [[], {}, [1, "x", null]], "b": 12.5}
+    })");
+    for (bool optimize : {true, false}) {
+        const auto encoded = json5pp::ubjson::encode(v, optimize);
+        CHECK(json5pp::ubjson::decode(encoded) == v);
+
+        std::stringstream stream;
+        json5pp::ubjson::encode(stream, v, optimize);
+        CHECK(json5pp::ubjson::decode(stream) == v);
+    }
+}
+
+TEST_CASE("ubjson decode", tag)
+{
+    using json5pp::ubjson::decode;
+    // no-op, char, float32, high-precision
+    CHECK(decode(bytes({'N', 'C', 'x'})) == "x");
+    CHECK(decode(bytes({'d', 0x3f, 0xc0, 0, 0})) == 1.5);
+    CHECK(decode(bytes({'H', 'U', 3, '1', '2', '3'})) == 123);
+    // typed booleans without payload
+    auto v = decode(bytes({'[', '$', 'T', '#', 'U', 3}));
+    CHECK(v == json5pp::array({true, true, true}));
+    // typed object
+    v = decode(bytes({'{', '$', 'U', '#', 'U', 2, 'U', 1, 'a', 1, 'U', 1, 'b', 2}));
+    CHECK(v == json5pp::object({{"a", 1}, {"b", 2}}));
+
+    CHECK_THROWS_AS(decode(""), json5pp::syntax_error);
+    CHECK_THROWS_AS(decode("ZZ"), json5pp::syntax_error);
+    CHECK_THROWS_AS(decode(bytes({'S', 'U', 5, 'a'})), json5pp::syntax_error);
+    CHECK_THROWS_AS(decode(bytes({'[', '$', 'U', 'U', 1})), json5pp::syntax_error);
+    CHECK_THROWS_AS(decode(bytes({'[', '$', 'D', '#', 'U', 200})), json5pp::syntax_error);
+    CHECK_THROWS_AS(decode(bytes({'S', 'i', 0xff})), json5pp::syntax_error);
+    CHECK_THROWS_AS(decode("?"), json5pp::syntax_error);
+}
+
+TEST_CASE("ubjson zero-width typed arrays", tag)
+{
+    using json5pp::ubjson::decode;
+    // elements typed as null/boolean take no bytes: counts are limited
+    CHECK_THROWS_AS(decode(bytes({'[', '$', 'Z', '#', 'L', 0x40, 0, 0, 0, 0, 0, 0, 0})), json5pp::syntax_error);
+    CHECK_THROWS_AS(decode(bytes({'[', '$', 'F', '#', 'U', 3}), 2), json5pp::syntax_error);
+    CHECK(decode(bytes({'[', '$', 'F', '#', 'U', 3}), 3) == json5pp::array({false, false, false}));
+
+    // the limit is for the whole document
+    const auto nested = bytes({'[', '[', '$', 'T', '#', 'U', 2, '[', '$', 'Z', '#', 'U', 2, ']'});
+    CHECK(decode(nested, 4) == json5pp::parse("[[true, true], [null, null]]"));
+    CHECK_THROWS_AS(decode(nested, 3), json5pp::syntax_error);
+}
+
+TEST_CASE("ubjson nesting depth", tag)
+{
+    using json5pp::ubjson::decode;
+    const auto nested = [](std::size_t depth, char open, char close) {
+        std::string s;
+        for (std::size_t i = 0; i < depth; ++i) {
+            s.push_back(open);
+            if ((open == '{') && (i + 1 < depth)) {
+                // key "" of the next object
+                s.append(bytes({'U', 0}));
+            }
+        }
+        return s + std::string(depth, close);
+    };
+    json5pp::ubjson::decode_options options;
+    options.max_depth = 4;
+    CHECK(decode(nested(4, '[', ']'), options) == json5pp::parse("[[[[]]]]"));
+    CHECK_THROWS_AS(decode(nested(5, '[', ']'), options), json5pp::syntax_error);
+    CHECK(decode(nested(4, '{', '}'), options) == json5pp::parse(R"({"": {"": {"": {}}}})"));
+    CHECK_THROWS_AS(decode(nested(5, '{', '}'), options), json5pp::syntax_error);
+    // typed arrays of arrays count as well
+    CHECK_THROWS_AS(decode(bytes({'[', '$', '[', '#', 'U', 1, '[', '[', '[', '[', ']', ']', ']', ']'}), options), json5pp::syntax_error);
+
+    // hostile input: would overflow the stack without a limit
+    CHECK_THROWS_AS(decode(std::string(400000, '[')), json5pp::syntax_error);
+    CHECK(decode(nested(json5pp::ubjson::default_max_depth, '[', ']')).is_array());
+    CHECK_THROWS_AS(decode(nested(json5pp::ubjson::default_max_depth + 1, '[', ']')), json5pp::syntax_error);
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <json5pp/walker.hpp>
+
+/**
+ * @brief unit tests for tree walker
+ *
+ */
+
+namespace {
+const auto tag = "[walker]";
+}
+
+TEST_CASE("walk order", tag)
+{
+    const auto v = json5pp::parse(R"({"a":[1,{"b":2}],"c/d~":3})");
+    std::vector<std::string> pre, post;
+    CHECK(json5pp::walk(
+        v,
+        [&](const json5pp::value&, const json5pp::walk_context& ctx) { pre.push_back(ctx.pointer()); },
+        [&](const json5pp::value&, const json5pp::walk_context& ctx) { post.push_back(ctx.pointer()); }));
+
+    CHECK(pre == std::vector<std::string>{"", "/a", "/a/0", "/a/1", "/a/1/b", "/c~1d~0"});
+    CHECK(post == std::vector<std::string>{"/a/0", "/a/1/b", "/a/1", "/a", "/c~1d~0", ""});
+}
+
+TEST_CASE("walk skip and stop", tag)
+{
+    const auto v = json5pp::parse(R"([[1,2],[3,4],[5]])");
+    int leaves = 0;
+    CHECK(json5pp::walk(v, [&](const json5pp::value& node, const json5pp::walk_context& ctx) {
+        if (ctx.depth() == 1 && ctx.segments().back().index == 1) return json5pp::walk_action::skip;
+        if (node.is_number()) ++leaves;
+        return json5pp::walk_action::next;
+    }));
+    CHECK(leaves == 3);
+
+    leaves = 0;
+    CHECK(!json5pp::walk(v, [&](const json5pp::value& node, const json5pp::walk_context&) {
+        if (node.is_integer() && node == 3) return json5pp::walk_action::stop;
+        if (node.is_number()) ++leaves;
+        return json5pp::walk_action::next;
+    }));
+    CHECK(leaves == 2);
+}
+
+TEST_CASE("walk modify", tag)
+{
+    auto v = json5pp::parse(R"({"user":{"password":"secret","name":"foo"},"list":[{"password":"x"}]})");
+    json5pp::walk(v, [](json5pp::value& node, const json5pp::walk_context& ctx) {
+        const auto& path = ctx.segments();
+        if (!path.empty() && path.back().key && *path.back().key == "password") {
+            node = "***";
+        }
+    });
+    CHECK(v["user"]["password"] == "***");
+    CHECK(v["user"]["name"] == "foo");
+    CHECK(v["list"][0]["password"] == "***");
+}
+
+TEST_CASE("walk deep tree", tag)
+{
+    json5pp::value v = 0;
+    for (int i = 0; i < 5000; ++i) {
+        json5pp::value outer = json5pp::array();
+        outer.as_array().push_back(std::move(v));
+        v = std::move(outer);
+    }
+    std::size_t max_depth = 0;
+    CHECK(json5pp::walk(v, [&](const json5pp::value&, const json5pp::walk_context& ctx) {
+        max_depth = std::max(max_depth, ctx.depth());
+    }));
+    CHECK(max_depth == 5000);
+}
+
+TEST_CASE("walk parallel", tag)
+{
+    json5pp::value v = json5pp::object({{"items", json5pp::array()}});
+    for (int i = 0; i < 5000; ++i) {
+        v["items"].append(json5pp::object({{"n", i}, {"tags", json5pp::array({"a", "b"})}}));
+    }
+
+    json5pp::parallel_options options;
+    options.threads = 4;
+    options.min_children = 100;
+
+    std::atomic<long long> sum{0};
+    std::atomic<int> nodes{0};
+    std::atomic<int> posts{0};
+    CHECK(json5pp::walk_parallel(
+        v, options,
+        [&](const json5pp::value& node, const json5pp::walk_context& ctx) {
+            ++nodes;
+            if (node.is_integer()) {
+                CHECK(ctx.pointer() == "/items/" + std::to_string(node.get<int>()) + "/n");
+                sum += node.get<int>();
+            }
+        },
+        [&](const json5pp::value&, const json5pp::walk_context&) { ++posts; }));
+    CHECK(sum == 5000LL * 4999 / 2);
+    CHECK(nodes == 2 + 5000 * 5);
+    CHECK(posts == nodes);
+
+    std::atomic<int> visited{0};
+    CHECK(!json5pp::walk_parallel(v, options, [&](const json5pp::value& node, const json5pp::walk_context&) {
+        ++visited;
+        return (node.is_integer() && node == 10) ? json5pp::walk_action::stop : json5pp::walk_action::next;
+    }));
+    CHECK(visited < nodes);
+
+    CHECK_THROWS_AS(json5pp::walk_parallel(v, options, [](const json5pp::value& node, const json5pp::walk_context&) {
+        if (node.is_integer() && node == 42) throw std::runtime_error("42");
+    }), std::runtime_error);
+}
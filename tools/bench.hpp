@@ -0,0 +1,367 @@
+#ifndef _JSON5PP_TOOLS_BENCH_HPP_
+#define _JSON5PP_TOOLS_BENCH_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+
+namespace json5pp {
+namespace bench {
+
+/**
+ * @brief Measured samples of one benchmark
+ */
+struct result {
+    std::string workload;        ///< Input (ex: "records")
+    std::string operation;       ///< Operation (ex: "parse")
+    std::uint64_t bytes = 0;     ///< Bytes processed per sample
+    std::vector<double> samples; ///< Seconds per sample
+
+    /// Benchmark name ("operation/workload")
+    std::string name() const { return operation + "/" + workload; }
+};
+
+/**
+ * @brief Robust statistics of samples
+ */
+struct statistics {
+    std::size_t count = 0; ///< Number of samples
+    double median = 0;     ///< Median
+    double mad = 0;        ///< Median absolute deviation (scaled by 1.4826 to estimate a standard deviation)
+    double min = 0;        ///< Minimum
+    double max = 0;        ///< Maximum
+};
+
+/**
+ * @brief Options for comparison
+ */
+struct compare_options {
+    double threshold = 0.05;      ///< Changes smaller than this ratio are not reported
+    double confidence = 0.95;     ///< Confidence level of intervals
+    std::size_t resamples = 2000; ///< Bootstrap resamples
+    std::uint64_t seed = 1;       ///< Seed of bootstrap (results are reproducible)
+};
+
+/**
+ * @brief Verdict of a comparison
+ */
+enum class verdict {
+    same,      ///< No significant change beyond threshold
+    improved,  ///< Significantly faster
+    regressed, ///< Significantly slower
+};
+
+/**
+ * @brief Comparison of one benchmark
+ */
+struct comparison {
+    std::string name;                ///< Benchmark name
+    std::string workload;            ///< Workload
+    std::uint64_t bytes = 0;         ///< Bytes per sample (of new result)
+    statistics base;                 ///< Baseline statistics
+    statistics test;                 ///< New statistics
+    double speedup = 1;              ///< Baseline median / new median (> 1 is faster)
+    double ci_low = 1;               ///< Lower bound of speedup interval
+    double ci_high = 1;              ///< Upper bound of speedup interval
+    verdict outcome = verdict::same; ///< Verdict
+};
+
+inline constexpr const char* format_name = "json5pp-bench"; ///< "format" of result files
+inline constexpr int format_version = 1;                     ///< "version" of result files
+
+/**
+ * @brief Median of values (sorted in place)
+ */
+inline double median_of(std::vector<double>& values)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    const std::size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    const double upper = values[mid];
+    if (values.size() % 2 != 0) {
+        return upper;
+    }
+    return (*std::max_element(values.begin(), values.begin() + mid) + upper) / 2;
+}
+
+/**
+ * @brief Compute robust statistics of samples
+ */
+inline statistics summarize(const std::vector<double>& samples)
+{
+    statistics s;
+    s.count = samples.size();
+    if (samples.empty()) {
+        return s;
+    }
+    std::vector<double> values(samples);
+    s.median = median_of(values);
+    s.min = *std::min_element(samples.begin(), samples.end());
+    s.max = *std::max_element(samples.begin(), samples.end());
+    for (auto& v : values) {
+        v = std::fabs(v - s.median);
+    }
+    s.mad = 1.4826 * median_of(values);
+    return s;
+}
+
+/**
+ * @brief Bootstrap interval of the ratio of medians (base / test)
+ *
+ * @return (low, high) bounds
+ */
+inline std::pair<double, double> speedup_interval(const std::vector<double>& base, const std::vector<double>& test, const compare_options& options)
+{
+    std::mt19937_64 rng(options.seed);
+    std::vector<double> ratios;
+    ratios.reserve(options.resamples);
+    std::vector<double> a(base.size()), b(test.size());
+    std::uniform_int_distribution<std::size_t> pick_a(0, base.size() - 1), pick_b(0, test.size() - 1);
+    for (std::size_t r = 0; r < options.resamples; ++r) {
+        for (auto& x : a) {
+            x = base[pick_a(rng)];
+        }
+        for (auto& x : b) {
+            x = test[pick_b(rng)];
+        }
+        const double mb = median_of(b);
+        if (mb > 0) {
+            ratios.push_back(median_of(a) / mb);
+        }
+    }
+    if (ratios.empty()) {
+        return {1, 1};
+    }
+    std::sort(ratios.begin(), ratios.end());
+    const double tail = (1 - options.confidence) / 2;
+    const auto at = [&](double q) { return ratios[std::min(ratios.size() - 1, static_cast<std::size_t>(q * static_cast<double>(ratios.size())))]; };
+    return {at(tail), at(1 - tail)};
+}
+
+/**
+ * @brief Compare one benchmark
+ */
+inline comparison compare(const result& base, const result& test, const compare_options& options = {})
+{
+    comparison c;
+    c.name = test.name();
+    c.workload = test.workload;
+    c.bytes = test.bytes;
+    c.base = summarize(base.samples);
+    c.test = summarize(test.samples);
+    if ((c.base.count == 0) || (c.test.count == 0) || (c.test.median <= 0)) {
+        return c;
+    }
+    c.speedup = c.base.median / c.test.median;
+    std::tie(c.ci_low, c.ci_high) = speedup_interval(base.samples, test.samples, options);
+    // significant: the interval excludes 1, and the change exceeds the threshold
+    if ((c.ci_high < 1) && (c.speedup < 1 / (1 + options.threshold))) {
+        c.outcome = verdict::regressed;
+    } else if ((c.ci_low > 1) && (c.speedup > 1 + options.threshold)) {
+        c.outcome = verdict::improved;
+    }
+    return c;
+}
+
+/**
+ * @brief Compare benchmarks found in both result sets (by name)
+ */
+inline std::vector<comparison> compare(const std::vector<result>& base, const std::vector<result>& test, const compare_options& options = {})
+{
+    std::map<std::string, const result*> names;
+    for (const auto& r : base) {
+        names[r.name()] = &r;
+    }
+    std::vector<comparison> comparisons;
+    for (const auto& r : test) {
+        auto iter = names.find(r.name());
+        if (iter != names.end()) {
+            comparisons.push_back(compare(*iter->second, r, options));
+        }
+    }
+    return comparisons;
+}
+
+/**
+ * @brief Measure an operation
+ *
+ * @param fn Operation (called once per sample, after one warm-up call)
+ * @param samples Number of samples
+ * @return Seconds per sample
+ */
+template <class F>
+std::vector<double> measure(F&& fn, std::size_t samples)
+{
+    fn();
+    std::vector<double> seconds;
+    seconds.reserve(samples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return seconds;
+}
+
+/**
+ * @brief Make a result file
+ *
+ * @param results Results (samples of repeated runs of a benchmark may be merged beforehand)
+ * @param context Free-form description of the environment (object)
+ */
+inline value to_json(const std::vector<result>& results, const value& context = object())
+{
+    value benchmarks = array();
+    for (const auto& r : results) {
+        value samples = array();
+        for (const auto s : r.samples) {
+            samples.as_array().push_back(s);
+        }
+        benchmarks.as_array().push_back(object({
+            {"workload", r.workload},
+            {"operation", r.operation},
+            {"bytes", static_cast<long long>(r.bytes)},
+            {"samples", samples},
+        }));
+    }
+    return object({{"format", format_name}, {"version", format_version}, {"context", context}, {"benchmarks", benchmarks}});
+}
+
+/**
+ * @brief Read a result file
+ *
+ * Benchmarks with the same name (ex: from concatenated runs) are merged.
+ *
+ * @throws std::invalid_argument if the document is not a result file
+ */
+inline std::vector<result> from_json(const value& doc)
+{
+    if (!doc.is_object() || (doc["format"] != format_name) || (doc["version"] != format_version) || !doc["benchmarks"].is_array()) {
+        throw std::invalid_argument("not a json5pp-bench result");
+    }
+    std::vector<result> results;
+    std::map<std::string, std::size_t> names;
+    for (const auto& b : doc["benchmarks"].as_array()) {
+        if (!b["workload"].is_string() || !b["operation"].is_string() || !b["bytes"].is_number() || !b["samples"].is_array()) {
+            throw std::invalid_argument("not a json5pp-bench result");
+        }
+        result r;
+        r.workload = b["workload"].as_string();
+        r.operation = b["operation"].as_string();
+        r.bytes = static_cast<std::uint64_t>(b["bytes"].as_number());
+        for (const auto& s : b["samples"].as_array()) {
+            if (!s.is_number()) {
+                throw std::invalid_argument("not a json5pp-bench result");
+            }
+            r.samples.push_back(s.as_number());
+        }
+        auto iter = names.find(r.name());
+        if (iter == names.end()) {
+            names.emplace(r.name(), results.size());
+            results.push_back(std::move(r));
+        } else {
+            auto& samples = results[iter->second].samples;
+            samples.insert(samples.end(), r.samples.begin(), r.samples.end());
+        }
+    }
+    return results;
+}
+
+namespace impl {
+
+inline std::string format(const char* fmt, double a, double b = 0, double c = 0)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), fmt, a, b, c);
+    return buffer;
+}
+
+inline const char* to_string(verdict v)
+{
+    switch (v) {
+    case verdict::improved:
+        return "improved";
+    case verdict::regressed:
+        return "regressed";
+    default:
+        return "same";
+    }
+}
+
+} /* namespace impl */
+
+/**
+ * @brief Write a text report: one line per benchmark, then throughput per workload
+ */
+inline void report(std::ostream& ostream, const std::vector<comparison>& comparisons, const compare_options& options = {})
+{
+    ostream << "benchmark                        base(ms)  +-mad     new(ms)  +-mad     speedup  " << impl::format("%.0f%% CI", options.confidence * 100) << "         verdict\n";
+    for (const auto& c : comparisons) {
+        std::string name = c.name;
+        name.resize(std::max<std::size_t>(name.size(), 32), ' ');
+        ostream << name << impl::format(" %8.3f %7.3f", c.base.median * 1e3, c.base.mad * 1e3)
+                << impl::format("  %8.3f %7.3f", c.test.median * 1e3, c.test.mad * 1e3)
+                << impl::format("  %6.3fx  [%.3f, %.3f]", c.speedup, c.ci_low, c.ci_high) << "  " << impl::to_string(c.outcome) << ((c.outcome == verdict::regressed) ? " <<<" : "") << "\n";
+    }
+
+    // throughput per workload: total bytes / total median time of its operations
+    struct totals {
+        double bytes = 0, base = 0, test = 0;
+    };
+    std::map<std::string, totals> workloads;
+    for (const auto& c : comparisons) {
+        auto& t = workloads[c.workload];
+        t.bytes += static_cast<double>(c.bytes);
+        t.base += c.base.median;
+        t.test += c.test.median;
+    }
+    ostream << "\nworkload                         base(MB/s)  new(MB/s)  speedup\n";
+    for (const auto& [name, t] : workloads) {
+        std::string label = name;
+        label.resize(std::max<std::size_t>(label.size(), 32), ' ');
+        const double base = (t.base > 0) ? t.bytes / t.base / 1e6 : 0;
+        const double test = (t.test > 0) ? t.bytes / t.test / 1e6 : 0;
+        ostream << label << impl::format(" %10.1f %10.1f  %6.3fx", base, test, (base > 0) ? test / base : 0) << "\n";
+    }
+}
+
+/**
+ * @brief Make a JSON report
+ */
+inline value report_json(const std::vector<comparison>& comparisons)
+{
+    value list = array();
+    for (const auto& c : comparisons) {
+        list.as_array().push_back(object({
+            {"name", c.name},
+            {"base_median", c.base.median},
+            {"base_mad", c.base.mad},
+            {"new_median", c.test.median},
+            {"new_mad", c.test.mad},
+            {"speedup", c.speedup},
+            {"ci", array({c.ci_low, c.ci_high})},
+            {"verdict", impl::to_string(c.outcome)},
+        }));
+    }
+    return list;
+}
+
+} /* namespace bench */
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_TOOLS_BENCH_HPP_ */
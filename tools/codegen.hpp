@@ -0,0 +1,256 @@
+#ifndef _JSON5PP_TOOLS_CODEGEN_HPP_
+#define _JSON5PP_TOOLS_CODEGEN_HPP_
+
+#include <cctype>
+#include <cstddef>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+#include <json5pp/shape.hpp>
+
+namespace json5pp {
+namespace codegen {
+
+/**
+ * @brief Options of C++ binding generator
+ */
+struct options {
+    std::string root_name = "Root"; ///< Name of the struct for documents
+    std::string name_space;         ///< Namespace of generated code (empty for global)
+};
+
+namespace impl {
+
+/**
+ * @brief Generator of structs and bindings from an inferred shape
+ */
+class generator
+{
+public:
+    explicit generator(const options& opts) : opts(opts) {}
+
+    /**
+     * @brief Generate header source
+     *
+     * @param root Shape of documents
+     * @return C++ header source
+     */
+    std::string generate(const shape& root)
+    {
+        std::string root_type = type_of(root, opts.root_name, false);
+        std::string out;
+        out += "// Generated by json5pp-codegen. Do not edit.\n";
+        out += "#pragma once\n\n";
+        out += "#include <optional>\n#include <string>\n#include <vector>\n\n";
+        out += "#include <json5pp/codegen_support.hpp>\n#include <json5pp/json5pp.hpp>\n\n";
+        if (!opts.name_space.empty()) {
+            out += "namespace " + opts.name_space + " {\n\n";
+        }
+        out += declarations;
+        out += definitions;
+        if (root_type != opts.root_name) {
+            // Non-object root: alias and its parse function
+            out += "using " + opts.root_name + " = " + root_type + ";\n\n";
+            out += "inline " + opts.root_name + " parse_" + identifier(opts.root_name) + "(const std::string& json)\n{\n";
+            out += "    " + opts.root_name + " out;\n";
+            out += "    json5pp::codegen_support::read(json5pp::parse5(json), out);\n";
+            out += "    return out;\n}\n\n";
+        }
+        if (!opts.name_space.empty()) {
+            out += "} // namespace " + opts.name_space + "\n";
+        }
+        return out;
+    }
+
+private:
+    /**
+     * @brief Make a valid C++ identifier from a key
+     */
+    static std::string identifier(const std::string& key)
+    {
+        static const std::set<std::string> keywords = {
+            "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class",
+            "const", "constexpr", "continue", "default", "delete", "do", "double", "else", "enum", "explicit",
+            "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long",
+            "mutable", "namespace", "new", "noexcept", "not", "nullptr", "operator", "or", "private",
+            "protected", "public", "register", "return", "short", "signed", "sizeof", "static", "struct",
+            "switch", "template", "this", "throw", "true", "try", "typedef", "typename", "union", "unsigned",
+            "using", "virtual", "void", "volatile", "while", "xor"};
+        std::string id;
+        for (const char ch : key) {
+            id.push_back(std::isalnum(static_cast<unsigned char>(ch)) ? ch : '_');
+        }
+        if (id.empty() || std::isdigit(static_cast<unsigned char>(id.front()))) {
+            id.insert(id.begin(), '_');
+        }
+        if (keywords.count(id)) {
+            id.push_back('_');
+        }
+        return id;
+    }
+
+    /**
+     * @brief Make a unique struct name from a key
+     */
+    std::string struct_name(const std::string& key)
+    {
+        std::string name;
+        bool upper = true;
+        for (const char ch : key) {
+            if (std::isalnum(static_cast<unsigned char>(ch))) {
+                name.push_back(upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(ch))) : ch);
+                upper = false;
+            } else {
+                upper = true;
+            }
+        }
+        if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front()))) {
+            name.insert(0, "T");
+        }
+        std::string unique = name;
+        for (int n = 2; !names.insert(unique).second; ++n) {
+            unique = name + std::to_string(n);
+        }
+        return unique;
+    }
+
+    /**
+     * @brief Escape a key as C++ string literal
+     */
+    static std::string literal(const std::string& key)
+    {
+        std::string result = "\"";
+        for (const char ch : key) {
+            if ((ch == '"') || (ch == '\\')) {
+                result.push_back('\\');
+                result.push_back(ch);
+            } else if (static_cast<unsigned char>(ch) < ' ') {
+                static const char hex[] = "0123456789abcdef";
+                result += "\\x";
+                result.push_back(hex[(ch >> 4) & 0xf]);
+                result.push_back(hex[ch & 0xf]);
+                result += "\"\"";
+            } else {
+                result.push_back(ch);
+            }
+        }
+        return result + "\"";
+    }
+
+    /**
+     * @brief Get C++ type for a shape (emits struct definitions if needed)
+     *
+     * @param s A shape
+     * @param name Name hint for a struct
+     * @param optional Wrap with std::optional if null is allowed
+     */
+    std::string type_of(const shape& s, const std::string& name, bool optional)
+    {
+        std::string type;
+        const auto non_null = s.count() - s.count(shape::null);
+        auto only = [&](shape::kind k) { return (non_null > 0) && (s.count(k) == non_null); };
+        if (only(shape::boolean)) {
+            type = "bool";
+        } else if (only(shape::integer)) {
+            const auto range = *s.integer_range();
+            const bool fits_int = (range.first >= std::numeric_limits<int>::min()) && (range.second <= std::numeric_limits<int>::max());
+            type = fits_int ? "int" : "long long";
+        } else if ((non_null > 0) && (s.count(shape::integer) + s.count(shape::number) == non_null)) {
+            // Integers beyond integer_type are parsed as double: keep them exact
+            type = s.is_integral() ? "long long" : "double";
+        } else if (only(shape::string)) {
+            type = "std::string";
+        } else if (only(shape::array)) {
+            type = s.elements() ? "std::vector<" + type_of(*s.elements(), name + "Item", false) + ">" : "std::vector<json5pp::value>";
+        } else if (only(shape::object) && (s.dropped() == 0)) {
+            type = struct_of(s, struct_name(name));
+        } else {
+            // Mixed types (or only nulls)
+            return "json5pp::value";
+        }
+        return (optional || (s.count(shape::null) > 0)) ? "std::optional<" + type + ">" : type;
+    }
+
+    /**
+     * @brief Emit struct and its bindings
+     *
+     * @return Name of the struct
+     */
+    std::string struct_of(const shape& s, const std::string& name)
+    {
+        struct field {
+            std::string key;
+            std::string id;
+            std::string type;
+            bool omit_empty; ///< Field may be missing
+        };
+        std::vector<field> fields;
+        std::set<std::string> ids;
+        for (const auto& pair : s.fields()) {
+            const bool missing = pair.second.count() < s.count(shape::object);
+            field f{pair.first, identifier(pair.first), type_of(pair.second, pair.first, missing), false};
+            f.omit_empty = missing && (f.type.rfind("std::optional<", 0) == 0);
+            for (int n = 2; !ids.insert(f.id).second; ++n) {
+                f.id = identifier(pair.first) + "_" + std::to_string(n);
+            }
+            fields.push_back(std::move(f));
+        }
+
+        std::string decl = "struct " + name + " {\n";
+        for (const auto& f : fields) {
+            decl += "    " + f.type + " " + f.id + "{};\n";
+        }
+        decl += "};\n\n";
+        declarations += decl;
+
+        std::string def;
+        def += "inline void from_json(const json5pp::value& v, " + name + "& out)\n{\n";
+        for (const auto& f : fields) {
+            def += "    json5pp::codegen_support::read(v[" + literal(f.key) + "], out." + f.id + ");\n";
+        }
+        def += "}\n\n";
+        def += "inline json5pp::value to_json(const " + name + "& in)\n{\n";
+        def += "    json5pp::value v = json5pp::object();\n";
+        for (const auto& f : fields) {
+            if (f.omit_empty) {
+                def += "    if (in." + f.id + ") v[" + literal(f.key) + "] = json5pp::codegen_support::write(in." + f.id + ");\n";
+            } else {
+                def += "    v[" + literal(f.key) + "] = json5pp::codegen_support::write(in." + f.id + ");\n";
+            }
+        }
+        def += "    return v;\n}\n\n";
+        def += "inline " + name + " parse_" + identifier(name) + "(const std::string& json)\n{\n";
+        def += "    " + name + " out;\n";
+        def += "    from_json(json5pp::parse5(json), out);\n";
+        def += "    return out;\n}\n\n";
+        definitions += def;
+        return name;
+    }
+
+    const options& opts;        ///< Generator options
+    std::set<std::string> names; ///< Used struct names
+    std::string declarations;   ///< Struct declarations
+    std::string definitions;    ///< Binding functions
+};
+
+} /* namespace impl */
+
+/**
+ * @brief Generate C++ structs and bindings from the shape of sample documents
+ *
+ * @param root Shape of documents
+ * @param opts Generator options
+ * @return C++ header source
+ */
+inline std::string generate(const shape& root, const options& opts = options())
+{
+    return impl::generator(opts).generate(root);
+}
+
+} /* namespace codegen */
+} /* namespace json5pp */
+
+#endif /* _JSON5PP_TOOLS_CODEGEN_HPP_ */
@@ -0,0 +1,182 @@
+/**
+ * @brief json5pp-bench: measure parse and stringify throughput
+ *
+ * Usage: json5pp-bench [--samples N] [--scale N] [--filter TEXT] [--label TEXT] [--input NAME=FILE]... [--out FILE]
+ *
+ * Built-in workloads are generated in memory; --input adds files as
+ * workloads. Results are written as JSON (see bench.hpp) to standard
+ * output or FILE, to be compared by json5pp-benchcmp.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+
+#include "bench.hpp"
+
+namespace {
+
+int usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--samples N] [--scale N] [--filter TEXT] [--label TEXT] [--input NAME=FILE]... [--out FILE]\n";
+    return 2;
+}
+
+/// Workload: JSON text (and the same document as JSON5 text)
+struct workload {
+    std::string name;
+    std::string json;
+    std::string json5;
+};
+
+workload make_workload(const std::string& name, const json5pp::value& v)
+{
+    return workload{name, v.stringify(), json5pp::stringify5(v, json5pp::rule::space_indent<2>())};
+}
+
+std::vector<workload> builtin_workloads(int scale)
+{
+    std::vector<workload> workloads;
+
+    json5pp::value numbers = json5pp::array();
+    for (int i = 0; i < 100000 * scale; ++i) {
+        numbers.as_array().push_back((i % 3 == 0) ? json5pp::value(i * 7) : json5pp::value(i * 0.125 - 1e3));
+    }
+    workloads.push_back(make_workload("numbers", numbers));
+
+    json5pp::value strings = json5pp::array();
+    for (int i = 0; i < 20000 * scale; ++i) {
+        strings.as_array().push_back("text \"" + std::to_string(i) + "\" with escapes\t\\ and some longer payload to copy");
+    }
+    workloads.push_back(make_workload("strings", strings));
+
+    json5pp::value records = json5pp::array();
+    for (int i = 0; i < 10000 * scale; ++i) {
+        records.as_array().push_back(json5pp::object({
+            {"id", i},
+            {"name", "user" + std::to_string(i)},
+            {"active", (i % 2) == 0},
+            {"score", i * 0.5},
+            {"tags", json5pp::array({"a", "b", "c"})},
+            {"address", json5pp::object({{"city", "Tokyo"}, {"zip", "100-0001"}})},
+            {"note", nullptr},
+        }));
+    }
+    workloads.push_back(make_workload("records", records));
+
+    json5pp::value nested = json5pp::array();
+    for (int i = 0; i < 2000 * scale; ++i) {
+        json5pp::value v = i;
+        for (int depth = 0; depth < 16; ++depth) {
+            v = (depth % 2) ? json5pp::object({{"k", v}}) : json5pp::array({v, depth});
+        }
+        nested.as_array().push_back(v);
+    }
+    workloads.push_back(make_workload("nested", nested));
+    return workloads;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t samples = 15;
+    int scale = 1;
+    std::string filter;
+    std::string label;
+    std::string out;
+    std::vector<std::pair<std::string, std::string>> inputs;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_arg = (i + 1 < argc);
+        if ((std::strcmp(argv[i], "--samples") == 0) && has_arg) {
+            samples = std::strtoul(argv[++i], nullptr, 10);
+        } else if ((std::strcmp(argv[i], "--scale") == 0) && has_arg) {
+            scale = std::atoi(argv[++i]);
+        } else if ((std::strcmp(argv[i], "--filter") == 0) && has_arg) {
+            filter = argv[++i];
+        } else if ((std::strcmp(argv[i], "--label") == 0) && has_arg) {
+            label = argv[++i];
+        } else if ((std::strcmp(argv[i], "--out") == 0) && has_arg) {
+            out = argv[++i];
+        } else if ((std::strcmp(argv[i], "--input") == 0) && has_arg) {
+            const std::string spec = argv[++i];
+            const auto eq = spec.find('=');
+            if (eq == std::string::npos) {
+                return usage(argv[0]);
+            }
+            inputs.emplace_back(spec.substr(0, eq), spec.substr(eq + 1));
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if ((samples == 0) || (scale <= 0)) {
+        return usage(argv[0]);
+    }
+
+    std::vector<workload> workloads;
+    try {
+        workloads = builtin_workloads(scale);
+        for (const auto& [name, file] : inputs) {
+            std::ifstream ifs(file, std::ios::binary);
+            if (!ifs) {
+                std::cerr << "Cannot open " << file << "\n";
+                return 1;
+            }
+            const std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+            workloads.push_back(make_workload(name, json5pp::parse5(text)));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::vector<json5pp::bench::result> results;
+    for (const auto& w : workloads) {
+        const json5pp::value doc = json5pp::parse(w.json);
+        const std::vector<std::pair<std::string, std::function<void()>>> operations = {
+            {"parse", [&] { json5pp::parse(w.json.data(), w.json.size()); }},
+            {"parse5", [&] { json5pp::parse5(w.json5.data(), w.json5.size()); }},
+            {"stringify", [&] { doc.stringify(); }},
+            {"stringify5", [&] { json5pp::stringify5(doc, json5pp::rule::space_indent<2>()); }},
+        };
+        for (const auto& [operation, fn] : operations) {
+            json5pp::bench::result r;
+            r.workload = w.name;
+            r.operation = operation;
+            if (!filter.empty() && (r.name().find(filter) == std::string::npos)) {
+                continue;
+            }
+            r.bytes = (operation.back() == '5') ? w.json5.size() : w.json.size();
+            r.samples = json5pp::bench::measure(fn, samples);
+            std::cerr << r.name() << ": " << json5pp::bench::summarize(r.samples).median * 1e3 << " ms\n";
+            results.push_back(std::move(r));
+        }
+    }
+
+    json5pp::value context = json5pp::object({
+        {"json5pp", std::to_string(json5pp::version::major) + "." + std::to_string(json5pp::version::minor) + "." + std::to_string(json5pp::version::patch)},
+#ifdef __VERSION__
+        {"compiler", __VERSION__},
+#endif
+        {"scale", scale},
+        {"label", label},
+    });
+    const auto text = json5pp::bench::to_json(results, context).stringify(json5pp::rule::space_indent<2>()) + "\n";
+    if (out.empty()) {
+        std::cout << text;
+    } else {
+        std::ofstream ofs(out, std::ios::binary);
+        if (!(ofs << text)) {
+            std::cerr << "Cannot write " << out << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @brief json5pp-benchcmp: compare two json5pp-bench result files
+ *
+ * Usage: json5pp-benchcmp [--threshold RATIO] [--confidence LEVEL] [--json] BASE NEW
+ *
+ * Reports per-benchmark medians, MAD, speedups with bootstrap confidence
+ * intervals and throughput per workload. Exits with 1 if any benchmark
+ * regressed beyond the threshold (default 0.05 = 5%).
+ */
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+
+#include "bench.hpp"
+
+namespace {
+
+int usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--threshold RATIO] [--confidence LEVEL] [--json] BASE NEW\n";
+    return 2;
+}
+
+std::vector<json5pp::bench::result> load(const std::string& file)
+{
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs) {
+        throw std::runtime_error("cannot open " + file);
+    }
+    const std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    return json5pp::bench::from_json(json5pp::parse(text));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    json5pp::bench::compare_options options;
+    bool json = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if ((std::strcmp(argv[i], "--threshold") == 0) && (i + 1 < argc)) {
+            options.threshold = std::strtod(argv[++i], nullptr);
+        } else if ((std::strcmp(argv[i], "--confidence") == 0) && (i + 1 < argc)) {
+            options.confidence = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if ((argv[i][0] == '-') && (argv[i][1] != '\0')) {
+            return usage(argv[0]);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if ((files.size() != 2) || (options.threshold < 0) || (options.confidence <= 0) || (options.confidence >= 1)) {
+        return usage(argv[0]);
+    }
+
+    std::vector<json5pp::bench::comparison> comparisons;
+    try {
+        comparisons = json5pp::bench::compare(load(files[0]), load(files[1]), options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+    if (json) {
+        std::cout << json5pp::bench::report_json(comparisons).stringify(json5pp::rule::space_indent<2>()) << "\n";
+    } else {
+        json5pp::bench::report(std::cout, comparisons, options);
+    }
+    for (const auto& c : comparisons) {
+        if (c.outcome == json5pp::bench::verdict::regressed) {
+            return 1;
+        }
+    }
+    return 0;
+}
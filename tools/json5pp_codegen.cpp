@@ -0,0 +1,83 @@
+/**
+ * @brief json5pp-codegen: generate C++ structs and bindings from sample documents
+ *
+ * Usage: json5pp-codegen [--json5] [--root NAME] [--namespace NAME] [FILE...]
+ *
+ * Each input is read as a stream of documents (one document, or NDJSON).
+ * Standard input is read if no file is given. The generated header is
+ * written to standard output.
+ */
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+#include <json5pp/record_reader.hpp>
+#include <json5pp/shape.hpp>
+
+#include "codegen.hpp"
+
+namespace {
+
+int usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--json5] [--root NAME] [--namespace NAME] [FILE...]\n";
+    return 2;
+}
+
+void observe(std::istream& istream, bool json5, json5pp::shape& shape)
+{
+    json5pp::record_reader reader(istream, json5pp::record_format::ndjson, json5);
+    json5pp::value v;
+    while (reader.read(v)) {
+        shape.observe(v);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    json5pp::codegen::options opts;
+    bool json5 = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json5") == 0) {
+            json5 = true;
+        } else if ((std::strcmp(argv[i], "--root") == 0) && (i + 1 < argc)) {
+            opts.root_name = argv[++i];
+        } else if ((std::strcmp(argv[i], "--namespace") == 0) && (i + 1 < argc)) {
+            opts.name_space = argv[++i];
+        } else if ((argv[i][0] == '-') && (argv[i][1] != '\0')) {
+            return usage(argv[0]);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    json5pp::shape shape;
+    try {
+        if (files.empty()) {
+            observe(std::cin, json5, shape);
+        }
+        for (const auto& file : files) {
+            std::ifstream ifs(file, std::ios::binary);
+            if (!ifs) {
+                std::cerr << "Cannot open " << file << "\n";
+                return 1;
+            }
+            observe(ifs, json5, shape);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    if (shape.count() == 0) {
+        std::cerr << "No sample documents\n";
+        return 1;
+    }
+    std::cout << json5pp::codegen::generate(shape, opts);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * @brief json5pp-index: build sidecar offset indexes and fetch records by them
+ *
+ * Usage: json5pp-index build [--array] [--json5] [--key POINTER] FILE [INDEX]
+ *        json5pp-index get FILE [INDEX] (--at N | --key VALUE)
+ *
+ * The index is written to (and read from) FILE.idx unless INDEX is given.
+ * For `get --key`, VALUE is parsed as JSON (ex: `42`, `'"abc"'`), or taken as
+ * a string if it is not valid JSON. The record is written to standard output.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <json5pp/json5pp.hpp>
+#include <json5pp/offset_index.hpp>
+
+namespace {
+
+int usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " build [--array] [--json5] [--key POINTER] FILE [INDEX]\n"
+              << "       " << program << " get FILE [INDEX] (--at N | --key VALUE)\n";
+    return 2;
+}
+
+int build(const std::string& file, const std::string& index_file, json5pp::record_format format, const std::string& key, bool json5)
+{
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifs) {
+        std::cerr << "Cannot open " << file << "\n";
+        return 1;
+    }
+    const auto index = json5pp::offset_index::build(ifs, format, key, json5);
+    std::ofstream ofs(index_file, std::ios::binary);
+    if (!ofs) {
+        std::cerr << "Cannot create " << index_file << "\n";
+        return 1;
+    }
+    index.save(ofs);
+    std::cerr << index.size() << " records\n";
+    return 0;
+}
+
+int get(const std::string& file, const std::string& index_file, std::optional<std::size_t> at, const std::optional<std::string>& key)
+{
+    std::ifstream ifi(index_file, std::ios::binary);
+    std::ifstream ifs(file, std::ios::binary);
+    if (!ifi || !ifs) {
+        std::cerr << "Cannot open " << (ifi ? file : index_file) << "\n";
+        return 1;
+    }
+    const auto index = json5pp::offset_index::load(ifi);
+    ifs.seekg(0, std::ios::end);
+    if (static_cast<std::uint64_t>(ifs.tellg()) != index.get_source_size()) {
+        std::cerr << "Warning: " << file << " changed since the index was built\n";
+    }
+    if (at) {
+        if (*at >= index.size()) {
+            std::cerr << "No record #" << *at << " (" << index.size() << " records)\n";
+            return 1;
+        }
+        std::cout << index.read(ifs, *at).stringify() << "\n";
+        return 0;
+    }
+    if (index.get_key_path().empty()) {
+        std::cerr << index_file << " has no key\n";
+        return 1;
+    }
+    json5pp::value k;
+    try {
+        k = json5pp::parse(*key);
+    } catch (const json5pp::syntax_error&) {
+        k = *key;
+    }
+    const auto found = index.read_keys(ifs, k);
+    if (found.empty()) {
+        std::cerr << "No record with " << index.get_key_path() << " = " << k.stringify() << "\n";
+        return 1;
+    }
+    for (const auto& record : found) {
+        std::cout << record.stringify() << "\n";
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+    const std::string command = argv[1];
+    auto format = json5pp::record_format::ndjson;
+    bool json5 = false;
+    std::string key_path;
+    std::optional<std::size_t> at;
+    std::optional<std::string> key;
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--array") == 0) {
+            format = json5pp::record_format::array;
+        } else if (std::strcmp(argv[i], "--json5") == 0) {
+            json5 = true;
+        } else if ((std::strcmp(argv[i], "--key") == 0) && (i + 1 < argc)) {
+            (command == "build" ? key_path : key.emplace()) = argv[++i];
+        } else if ((std::strcmp(argv[i], "--at") == 0) && (i + 1 < argc)) {
+            at = std::strtoull(argv[++i], nullptr, 10);
+        } else if ((argv[i][0] == '-') && (argv[i][1] != '\0')) {
+            return usage(argv[0]);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty() || (files.size() > 2)) {
+        return usage(argv[0]);
+    }
+    const std::string index_file = (files.size() > 1) ? files[1] : files[0] + ".idx";
+
+    try {
+        if (command == "build") {
+            return build(files[0], index_file, format, key_path, json5);
+        }
+        if ((command == "get") && (at.has_value() != key.has_value())) {
+            return get(files[0], index_file, at, key);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return usage(argv[0]);
+}